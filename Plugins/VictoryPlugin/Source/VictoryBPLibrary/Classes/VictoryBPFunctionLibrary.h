@@ -644,13 +644,23 @@ class VICTORYBPLIBRARY_API UVictoryBPFunctionLibrary : public UBlueprintFunction
 	static void String__ExplodeString(TArray<FString>& OutputStrings, FString InputString, FString Separator = ",", int32 limit = 0, bool bTrimElements = false);
 	
 
-	/** Load a texture 2D from a file path! Contributed by UE4 forum member n00854180t! */
+	/** Load a texture 2D from a file path! Contributed by UE4 forum member n00854180t! 
+	* The texture is cached by path, loading it again returns the same texture until the file changes. Blocks until loaded, see Load Texture 2D From File Async.
+	*/
 	UFUNCTION(BlueprintCallable, Category = "VictoryBPLibrary")
 	static UTexture2D* GetTexture2DFromFile(const FString& FilePath);
 	
+	/** Load a texture 2D from a file path without blocking the game. The file is read on a worker thread and the texture cached by path.
+	* @param Texture		loaded texture, None if the file isn't a valid 2D DDS
+	* @param bSuccess		was the texture loaded
+	*/
+	UFUNCTION(BlueprintCallable, Category = "VictoryBPLibrary", meta = (Latent, LatentInfo = "LatentInfo", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"))
+	static void LoadTexture2DFromFileAsync(UObject* WorldContextObject, const FString& FilePath, UTexture2D*& Texture, bool& bSuccess, struct FLatentActionInfo LatentInfo);
+	
 	
 	
 	/** Contributed by UE4 forum member n00854180t! Plays a sound from file, attached to and following the specified component. This is a fire and forget sound. Replication is also not handled at this point.
+	* Sounds are cached by path. If the file isn't cached yet it is loaded in the background and the sound plays once loaded, NULL is returned then.
 	* @param FilePath - Path to sound file to play
 	* @param AttachComponent - Component to attach to.
 	* @param AttachPointName - Optional named point within the AttachComponent to play the sound at
@@ -665,6 +675,7 @@ class VICTORYBPLIBRARY_API UVictoryBPFunctionLibrary : public UBlueprintFunction
 	static class UAudioComponent* PlaySoundAttachedFromFile(const FString& FilePath, class USceneComponent* AttachToComponent, FName AttachPointName = NAME_None, FVector Location = FVector(ForceInit), EAttachLocation::Type LocationType = EAttachLocation::SnapToTarget, bool bStopWhenAttachedToDestroyed = false, float VolumeMultiplier = 1.f, float PitchMultiplier = 1.f, float StartTime = 0.f, class USoundAttenuation* AttenuationSettings = NULL);
 	
 	/** Contributed by UE4 forum member n00854180t! Plays a sound at the given location. This is a fire and forget sound and does not travel with any actor. Replication is also not handled at this point.
+	* Sounds are cached by path. If the file isn't cached yet it is loaded in the background and the sound plays once loaded.
 	* @param FilePath - Path to sound file to play
 	* @param Location - World position to play sound at
 	* @param World - The World in which the sound is to be played
@@ -677,26 +688,23 @@ class VICTORYBPLIBRARY_API UVictoryBPFunctionLibrary : public UBlueprintFunction
 	
 	/** Contributed by UE4 forum member n00854180t! Creates a USoundWave* from file path.
 	* Read .ogg header file and refresh USoundWave metadata.
+	* The sound wave is cached by path, loading it again returns the same wave until the file changes. Blocks until loaded, see Load Sound Wave From File Async.
 	* @param FilePath		path to file to create sound wave from
 	*/
 	UFUNCTION(BlueprintCallable, Category = "VictoryBPLibrary")
 	static class USoundWave* GetSoundWaveFromFile(const FString& FilePath);
+	
+	/** Creates a USoundWave* from an .ogg file without blocking the game. The file is read on a worker thread and the sound wave cached by path.
+	* @param SoundWave		loaded sound wave, None if the file isn't a valid .ogg
+	* @param bSuccess		was the sound wave loaded
+	*/
+	UFUNCTION(BlueprintCallable, Category = "VictoryBPLibrary", meta = (Latent, LatentInfo = "LatentInfo", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"))
+	static void LoadSoundWaveFromFileAsync(UObject* WorldContextObject, const FString& FilePath, class USoundWave*& SoundWave, bool& bSuccess, struct FLatentActionInfo LatentInfo);
 
 private:
 	// Thanks to @keru for the base code for loading an Ogg into a USoundWave: 
 	// https://forums.unrealengine.com/showthread.php?7936-Custom-Music-Player&p=97659&viewfull=1#post97659
 
-	     /**
-        * Read .ogg header file and refresh USoundWave metadata.
-        * @param sw             wave to put metadata
-        * @param rawFile        pointer to src file in memory
-        * @return 0     if everything is ok
-        *                 1 if couldn't read metadata.
-        */
-        static int32 fillSoundWaveInfo(USoundWave* sw, TArray<uint8>* rawFile);
-
-
-
         /**
         * Tries to find out FSoundSource object associated to the USoundWave.
         * @param sw     wave, search key
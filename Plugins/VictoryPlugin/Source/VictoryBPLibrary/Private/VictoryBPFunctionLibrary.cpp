@@ -4,6 +4,7 @@
 #include "VictoryBPLibraryPrivatePCH.h"
 
 #include "StaticMeshResources.h"
+#include "VictoryFileAssetCache.h"
 
 //////////////////////////////////////////////////////////////////////////
 // UVictoryBPFunctionLibrary
@@ -2067,178 +2068,115 @@ void UVictoryBPFunctionLibrary::String__ExplodeString(TArray<FString>& OutputStr
 	}
 }
 
-UTexture2D* UVictoryBPFunctionLibrary::GetTexture2DFromFile(const FString& FilePath)
-{
-	UTexture2D* Texture = NULL;
-
-	FString TexturePath = FilePath;//FPaths::GameContentDir( ) + TEXT( "../Data/" ) + TextureFilename;
-	TArray<uint8> FileData;
+/** Waits for a file asset to be loaded by FVictoryFileAssetCache */
+template<typename AssetType>
+class FVictoryLoadFileAction : public FPendingLatentAction
+{
+public:
+	FString FilePath;
+	EVictoryFileAsset::Type Type;
+	AssetType*& Result;
+	bool& bSuccess;
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+
+	FVictoryLoadFileAction(const FString& InFilePath, EVictoryFileAsset::Type InType, AssetType*& InResult, bool& InSuccess, const FLatentActionInfo& LatentInfo)
+		: FilePath(InFilePath)
+		, Type(InType)
+		, Result(InResult)
+		, bSuccess(InSuccess)
+		, ExecutionFunction(LatentInfo.ExecutionFunction)
+		, OutputLink(LatentInfo.Linkage)
+		, CallbackTarget(LatentInfo.CallbackTarget)
+	{
+	}
 
-	/* Load DDS texture */
-	if( FFileHelper::LoadFileToArray( FileData, *TexturePath, 0 ) )
+	virtual void UpdateOperation(FLatentResponse& Response) override
 	{
-		FDDSLoadHelper DDSLoadHelper( &FileData[ 0 ], FileData.Num( ) );
-		if( DDSLoadHelper.IsValid2DTexture( ) )
+		FVictoryFileAssetCache& Cache = FVictoryFileAssetCache::Get();
+		if (Cache.IsLoading(FilePath, Type))
 		{
-			int32 NumMips = DDSLoadHelper.ComputeMipMapCount( );
-			EPixelFormat Format = DDSLoadHelper.ComputePixelFormat( );
-			int32 BlockSize = 16;
-
-			if( NumMips == 0 )
-			{
-				NumMips = 1;
-			}
-
-			if( Format == PF_DXT1 )
-			{
-				BlockSize = 8;
-			}
-
-			/* Create transient texture */
-			Texture = UTexture2D::CreateTransient( DDSLoadHelper.DDSHeader->dwWidth, DDSLoadHelper.DDSHeader->dwHeight, Format );
-			
-			#if WITH_EDITOR
-			Texture->MipGenSettings = TMGS_LeaveExistingMips;
-			#endif  //WITH_EDITOR
-			
-			Texture->PlatformData->NumSlices = 1;
-			Texture->NeverStream = true;
-			//Texture->Rename(  );
-
-			/* Get pointer to actual data */
-			uint8* DataPtr = (uint8*) DDSLoadHelper.GetDDSDataPointer( );
-
-			uint32 CurrentWidth = DDSLoadHelper.DDSHeader->dwWidth;
-			uint32 CurrentHeight = DDSLoadHelper.DDSHeader->dwHeight;
-
-			/* Iterate through mips */
-			for( int32 i = 0; i < NumMips; i++ )
-			{
-				/* Lock to 1x1 as smallest size */
-				CurrentWidth = ( CurrentWidth < 1 ) ? 1 : CurrentWidth;
-				CurrentHeight = ( CurrentHeight < 1 ) ? 1 : CurrentHeight;
-
-				/* Get number of bytes to read */
-				int32 NumBytes = CurrentWidth * CurrentHeight * 4;
-				if( Format == PF_DXT1 || Format == PF_DXT3 || Format == PF_DXT5 )
-				{
-					/* Compressed formats */
-					NumBytes = ( ( CurrentWidth + 3 ) / 4 ) * ( ( CurrentHeight + 3 ) / 4 ) * BlockSize;
-				}
-
-				/* Write to existing mip */
-				if( i < Texture->PlatformData->Mips.Num( ) )
-				{
-					FTexture2DMipMap& Mip = Texture->PlatformData->Mips[ i ];
-
-					void* Data = Mip.BulkData.Lock( LOCK_READ_WRITE );
-					FMemory::Memcpy( Data, DataPtr, NumBytes );
-					Mip.BulkData.Unlock( );
-				}
-
-				/* Add new mip */
-				else
-				{
-					FTexture2DMipMap* Mip = new( Texture->PlatformData->Mips ) FTexture2DMipMap( );
-					Mip->SizeX = CurrentWidth;
-					Mip->SizeY = CurrentHeight;
-
-					Mip->BulkData.Lock( LOCK_READ_WRITE );
-					Mip->BulkData.Realloc( NumBytes );
-					Mip->BulkData.Unlock( );
-
-					void* Data = Mip->BulkData.Lock( LOCK_READ_WRITE );
-					FMemory::Memcpy( Data, DataPtr, NumBytes );
-					Mip->BulkData.Unlock( );
-				}
+			return;
+		}
 
-				/* Set next mip level */
-				CurrentWidth /= 2;
-				CurrentHeight /= 2;
+		Result = Cast<AssetType>(Cache.Find(FilePath, Type));
+		bSuccess = (Result != NULL);
+		Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+	}
+};
 
-				DataPtr += NumBytes;
-			}
+template<typename AssetType>
+static void StartLoadFileAction(UObject* WorldContextObject, const FString& FilePath, EVictoryFileAsset::Type Type, AssetType*& Result, bool& bSuccess, const FLatentActionInfo& LatentInfo)
+{
+	UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject);
+	if (!World) return;
+	//~~~~~~~~~~~
 
-			Texture->UpdateResource( );
-		}
+	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+	if (LatentActionManager.FindExistingAction<FVictoryLoadFileAction<AssetType> >(LatentInfo.CallbackTarget, LatentInfo.UUID) == NULL)
+	{
+		FVictoryFileAssetCache::Get().FindOrRequest(FilePath, Type);
+		LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FVictoryLoadFileAction<AssetType>(FilePath, Type, Result, bSuccess, LatentInfo));
 	}
+}
+
+UTexture2D* UVictoryBPFunctionLibrary::GetTexture2DFromFile(const FString& FilePath)
+{
+	return Cast<UTexture2D>(FVictoryFileAssetCache::Get().FindOrLoad(FilePath, EVictoryFileAsset::Texture));
+}
 
-	return Texture;
+void UVictoryBPFunctionLibrary::LoadTexture2DFromFileAsync(UObject* WorldContextObject, const FString& FilePath, UTexture2D*& Texture, bool& bSuccess, FLatentActionInfo LatentInfo)
+{
+	StartLoadFileAction(WorldContextObject, FilePath, EVictoryFileAsset::Texture, Texture, bSuccess, LatentInfo);
 }
 
 class UAudioComponent* UVictoryBPFunctionLibrary::PlaySoundAttachedFromFile(const FString& FilePath, class USceneComponent* AttachToComponent, FName AttachPointName, FVector Location, EAttachLocation::Type LocationType, bool bStopWhenAttachedToDestroyed, float VolumeMultiplier, float PitchMultiplier, float StartTime, class USoundAttenuation* AttenuationSettings)
 {	
-	USoundWave* sw = GetSoundWaveFromFile(FilePath);
+	USoundWave* sw = Cast<USoundWave>(FVictoryFileAssetCache::Get().Find(FilePath, EVictoryFileAsset::Sound));
 
 	if (!sw)
+	{
+		// play once loaded
+		FVictoryPendingFileSound Sound;
+		Sound.AttachToComponent = AttachToComponent;
+		Sound.AttachPointName = AttachPointName;
+		Sound.Location = Location;
+		Sound.LocationType = LocationType;
+		Sound.bStopWhenAttachedToDestroyed = bStopWhenAttachedToDestroyed;
+		Sound.VolumeMultiplier = VolumeMultiplier;
+		Sound.PitchMultiplier = PitchMultiplier;
+		Sound.StartTime = StartTime;
+		Sound.AttenuationSettings = AttenuationSettings;
+		FVictoryFileAssetCache::Get().PlayWhenLoaded(FilePath, Sound);
 		return NULL;
+	}
 
 	return UGameplayStatics::PlaySoundAttached(sw, AttachToComponent, AttachPointName, Location, LocationType, bStopWhenAttachedToDestroyed, VolumeMultiplier, PitchMultiplier, StartTime, AttenuationSettings);
 }
 
 void UVictoryBPFunctionLibrary::PlaySoundAtLocationFromFile(UObject* WorldContextObject, const FString& FilePath, FVector Location, float VolumeMultiplier, float PitchMultiplier, float StartTime, class USoundAttenuation* AttenuationSettings)
 {
-	USoundWave* sw = GetSoundWaveFromFile(FilePath);
-
-	if (!sw)
-		return;
-
-	UGameplayStatics::PlaySoundAtLocation(WorldContextObject, sw, Location, VolumeMultiplier, PitchMultiplier, StartTime, AttenuationSettings);
+	FVictoryPendingFileSound Sound;
+	Sound.WorldContextObject = WorldContextObject;
+	Sound.Location = Location;
+	Sound.VolumeMultiplier = VolumeMultiplier;
+	Sound.PitchMultiplier = PitchMultiplier;
+	Sound.StartTime = StartTime;
+	Sound.AttenuationSettings = AttenuationSettings;
+	FVictoryFileAssetCache::Get().PlayWhenLoaded(FilePath, Sound);
 }
 
 class USoundWave* UVictoryBPFunctionLibrary::GetSoundWaveFromFile(const FString& FilePath)
 {
-	USoundWave* sw = (USoundWave*)StaticConstructObject(USoundWave::StaticClass());
-
-	if (!sw)
-		return NULL;
-
-	//* If true the song was successfully loaded
-	bool loaded = false;
-
-	//* loaded song file (binary, encoded)
-	TArray < uint8 > rawFile;
-
-	loaded = FFileHelper::LoadFileToArray(rawFile, FilePath.GetCharArray().GetTypedData());
-
-	if (loaded)
-	{
-		FByteBulkData* bulkData = &sw->CompressedFormatData.GetFormat(TEXT("OGG"));
-
-		bulkData->Lock(LOCK_READ_WRITE);
-		FMemory::Memcpy(bulkData->Realloc(rawFile.Num()), rawFile.GetTypedData(), rawFile.Num());
-		bulkData->Unlock();
-
-		loaded = fillSoundWaveInfo(sw, &rawFile) == 0 ? true : false;
-	}
-
-	if (!loaded)
-		return NULL;
-
-	return sw;
+	return Cast<USoundWave>(FVictoryFileAssetCache::Get().FindOrLoad(FilePath, EVictoryFileAsset::Sound));
 }
 
-int32 UVictoryBPFunctionLibrary::fillSoundWaveInfo(class USoundWave* sw, TArray<uint8>* rawFile)
+void UVictoryBPFunctionLibrary::LoadSoundWaveFromFileAsync(UObject* WorldContextObject, const FString& FilePath, class USoundWave*& SoundWave, bool& bSuccess, FLatentActionInfo LatentInfo)
 {
-    FSoundQualityInfo info;
-    FVorbisAudioInfo vorbis_obj = FVorbisAudioInfo();
-    if (!vorbis_obj.ReadCompressedInfo(rawFile->GetTypedData(), rawFile->Num(), &info))
-    {
-        //Debug("Can't load header");
-        return 1;
-    }
-
-	if(!sw) return 1;
-	sw->SoundGroup = ESoundGroup::SOUNDGROUP_Default;
-    sw->NumChannels = info.NumChannels;
-    sw->Duration = info.Duration;
-    sw->RawPCMDataSize = info.SampleDataSize;
-    sw->SampleRate = info.SampleRate;
-
-    return 0;
+	StartLoadFileAction(WorldContextObject, FilePath, EVictoryFileAsset::Sound, SoundWave, bSuccess, LatentInfo);
 }
 
-      
 int32 UVictoryBPFunctionLibrary::findSource(class USoundWave* sw, class FSoundSource* out_audioSource)
 {
 	FAudioDevice* device = GEngine ? GEngine->GetAudioDevice() : NULL; //gently ask for the audio device
@@ -0,0 +1,557 @@
+/*
+	By Rama
+*/
+#include "VictoryBPLibraryPrivatePCH.h"
+#include "VictoryFileAssetCache.h"
+
+static TAutoConsoleVariable<int32> CVarFileCacheBudgetMB(
+	TEXT("Victory.FileCacheBudgetMB"),
+	64,
+	TEXT("Memory the cache of sounds and textures loaded from files may hold, in MB.\n")
+	TEXT("Least recently used files are dropped past it."));
+
+static TAutoConsoleVariable<int32> CVarFileCacheCheckTimeStamps(
+	TEXT("Victory.FileCacheCheckTimeStamps"),
+	1,
+	TEXT("Drop cached sounds and textures whose file changed on disk.\n")
+	TEXT("The time stamps are read on a worker thread."));
+
+/** Seconds between background reads of the cached files' time stamps */
+static const double FileValidateInterval = 1.0;
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//				Background load
+
+/** Reads a file and parses its header, off the game thread */
+class FVictoryFileLoadTask : public FNonAbandonableTask
+{
+public:
+	FVictoryFileLoadTask(const FString& InFilePath, EVictoryFileAsset::Type InType)
+		: FilePath(InFilePath)
+		, Type(InType)
+		, bValid(false)
+		, Width(0)
+		, Height(0)
+		, Format(PF_Unknown)
+	{}
+
+	void DoWork()
+	{
+		TimeStamp = IFileManager::Get().GetTimeStamp(*FilePath);
+		if (!FFileHelper::LoadFileToArray(Data, *FilePath, 0) || Data.Num() == 0)
+		{
+			return;
+		}
+
+		if (Type == EVictoryFileAsset::Sound)
+		{
+			FVorbisAudioInfo Vorbis;
+			bValid = Vorbis.ReadCompressedInfo(Data.GetData(), Data.Num(), &SoundInfo);
+		}
+		else
+		{
+			FDDSLoadHelper DDSLoadHelper(Data.GetData(), Data.Num());
+			if (!DDSLoadHelper.IsValid2DTexture())
+			{
+				return;
+			}
+
+			Format = DDSLoadHelper.ComputePixelFormat();
+			Width = DDSLoadHelper.DDSHeader->dwWidth;
+			Height = DDSLoadHelper.DDSHeader->dwHeight;
+
+			const bool bCompressed = (Format == PF_DXT1 || Format == PF_DXT3 || Format == PF_DXT5);
+			const int32 BlockSize = (Format == PF_DXT1) ? 8 : 16;
+			const int32 NumMips = FMath::Max(DDSLoadHelper.ComputeMipMapCount(), 1);
+
+			int32 Offset = (const uint8*)DDSLoadHelper.GetDDSDataPointer() - Data.GetData();
+			int32 MipWidth = Width;
+			int32 MipHeight = Height;
+			for (int32 i = 0; i < NumMips; i++)
+			{
+				MipWidth = FMath::Max(MipWidth, 1);
+				MipHeight = FMath::Max(MipHeight, 1);
+
+				const int32 NumBytes = bCompressed ? ((MipWidth + 3) / 4) * ((MipHeight + 3) / 4) * BlockSize : MipWidth * MipHeight * 4;
+				if (Offset + NumBytes > Data.Num())
+				{
+					// truncated file
+					return;
+				}
+
+				MipOffsets.Add(Offset);
+				MipSizes.Add(NumBytes);
+
+				Offset += NumBytes;
+				MipWidth /= 2;
+				MipHeight /= 2;
+			}
+
+			bValid = true;
+		}
+	}
+
+	static const TCHAR* Name()
+	{
+		return TEXT("FVictoryFileLoadTask");
+	}
+
+	FString FilePath;
+	EVictoryFileAsset::Type Type;
+
+	FDateTime TimeStamp;
+	TArray<uint8> Data;
+	bool bValid;
+
+	/** sound header */
+	FSoundQualityInfo SoundInfo;
+
+	/** texture header and where each mip is in Data */
+	int32 Width;
+	int32 Height;
+	EPixelFormat Format;
+	TArray<int32> MipOffsets;
+	TArray<int32> MipSizes;
+};
+
+/** Reads the time stamps of cached files, off the game thread */
+class FVictoryFileStampTask : public FNonAbandonableTask
+{
+public:
+	FVictoryFileStampTask(const TArray<FString>& InKeys, const TArray<FString>& InFilePaths, const TArray<FDateTime>& InLoadedTimeStamps)
+		: Keys(InKeys)
+		, FilePaths(InFilePaths)
+		, LoadedTimeStamps(InLoadedTimeStamps)
+	{}
+
+	void DoWork()
+	{
+		for (int32 i = 0; i < FilePaths.Num(); i++)
+		{
+			TimeStamps.Add(IFileManager::Get().GetTimeStamp(*FilePaths[i]));
+		}
+	}
+
+	static const TCHAR* Name()
+	{
+		return TEXT("FVictoryFileStampTask");
+	}
+
+	/** entry keys and files, with the time stamp each entry was loaded with */
+	TArray<FString> Keys;
+	TArray<FString> FilePaths;
+	TArray<FDateTime> LoadedTimeStamps;
+
+	/** time stamps on disk now */
+	TArray<FDateTime> TimeStamps;
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//				Cache
+
+static void PlayFileSound(USoundWave* Wave, const FVictoryPendingFileSound& Sound)
+{
+	if (Sound.WorldContextObject.IsValid())
+	{
+		UGameplayStatics::PlaySoundAtLocation(Sound.WorldContextObject.Get(), Wave, Sound.Location, Sound.VolumeMultiplier, Sound.PitchMultiplier, Sound.StartTime, Sound.AttenuationSettings.Get());
+	}
+	else if (Sound.AttachToComponent.IsValid())
+	{
+		UGameplayStatics::PlaySoundAttached(Wave, Sound.AttachToComponent.Get(), Sound.AttachPointName, Sound.Location, Sound.LocationType, Sound.bStopWhenAttachedToDestroyed, Sound.VolumeMultiplier, Sound.PitchMultiplier, Sound.StartTime, Sound.AttenuationSettings.Get());
+	}
+}
+
+FVictoryFileAssetCache& FVictoryFileAssetCache::Get()
+{
+	// never destroyed, the GC and tickable object lists may already be gone at static destruction time
+	static FVictoryFileAssetCache* Cache = new FVictoryFileAssetCache();
+	return *Cache;
+}
+
+FVictoryFileAssetCache::FVictoryFileAssetCache()
+	: CachedBytes(0)
+	, NumLoading(0)
+	, StampTask(NULL)
+	, LastStampCheckTime(0.0)
+{
+}
+
+FVictoryFileAssetCache::~FVictoryFileAssetCache()
+{
+	if (StampTask)
+	{
+		StampTask->EnsureCompletion();
+		delete StampTask;
+	}
+
+	for (TMap<FString, FEntry*>::TIterator It(Entries); It; ++It)
+	{
+		FEntry* Entry = It.Value();
+		if (Entry->LoadTask)
+		{
+			Entry->LoadTask->EnsureCompletion();
+			delete Entry->LoadTask;
+		}
+		delete Entry;
+	}
+}
+
+FString FVictoryFileAssetCache::GetKey(const FString& FullPath, EVictoryFileAsset::Type Type)
+{
+	return FString::Printf(TEXT("%d:%s"), (int32)Type, *FullPath);
+}
+
+FVictoryFileAssetCache::FEntry* FVictoryFileAssetCache::FindEntry(const FString& FilePath, EVictoryFileAsset::Type Type) const
+{
+	FEntry* Entry = Lookup[Type].FindRef(FilePath);
+	if (Entry == NULL)
+	{
+		// first lookup with this path, it may name a file that was requested with another one
+		Entry = Entries.FindRef(GetKey(FPaths::ConvertRelativePathToFull(FilePath), Type));
+		if (Entry)
+		{
+			Entry->RequestedPaths.Add(FilePath);
+			Lookup[Type].Add(FilePath, Entry);
+		}
+	}
+
+	return Entry;
+}
+
+FVictoryFileAssetCache::FEntry* FVictoryFileAssetCache::FindValidEntry(const FString& FilePath, EVictoryFileAsset::Type Type)
+{
+	FEntry* Entry = FindEntry(FilePath, Type);
+	if (Entry == NULL || Entry->Asset == NULL)
+	{
+		return NULL;
+	}
+
+	Entry->LastUsedTime = FPlatformTime::Seconds();
+	return Entry;
+}
+
+UObject* FVictoryFileAssetCache::Find(const FString& FilePath, EVictoryFileAsset::Type Type)
+{
+	FEntry* Entry = FindValidEntry(FilePath, Type);
+	return Entry ? Entry->Asset : NULL;
+}
+
+UObject* FVictoryFileAssetCache::FindOrRequest(const FString& FilePath, EVictoryFileAsset::Type Type)
+{
+	UObject* Asset = Find(FilePath, Type);
+	if (Asset == NULL)
+	{
+		Request(FilePath, Type);
+	}
+
+	return Asset;
+}
+
+UObject* FVictoryFileAssetCache::FindOrLoad(const FString& FilePath, EVictoryFileAsset::Type Type)
+{
+	UObject* Asset = Find(FilePath, Type);
+	if (Asset)
+	{
+		return Asset;
+	}
+
+	FEntry* Entry = Request(FilePath, Type);
+	if (Entry->LoadTask)
+	{
+		Entry->LoadTask->EnsureCompletion();
+		if (!FinishLoad(Entry))
+		{
+			return NULL;
+		}
+	}
+
+	return Entry->Asset;
+}
+
+bool FVictoryFileAssetCache::IsLoading(const FString& FilePath, EVictoryFileAsset::Type Type) const
+{
+	const FEntry* Entry = FindEntry(FilePath, Type);
+	return Entry && Entry->LoadTask;
+}
+
+void FVictoryFileAssetCache::PlayWhenLoaded(const FString& FilePath, const FVictoryPendingFileSound& Sound)
+{
+	USoundWave* Wave = Cast<USoundWave>(Find(FilePath, EVictoryFileAsset::Sound));
+	if (Wave)
+	{
+		PlayFileSound(Wave, Sound);
+	}
+	else
+	{
+		Request(FilePath, EVictoryFileAsset::Sound)->PendingSounds.Add(Sound);
+	}
+}
+
+FVictoryFileAssetCache::FEntry* FVictoryFileAssetCache::Request(const FString& FilePath, EVictoryFileAsset::Type Type)
+{
+	FEntry* Entry = FindEntry(FilePath, Type);
+	if (Entry)
+	{
+		return Entry;
+	}
+
+	Entry = new FEntry();
+	Entry->FilePath = FPaths::ConvertRelativePathToFull(FilePath);
+	Entry->Type = Type;
+	Entry->Key = GetKey(Entry->FilePath, Type);
+	Entry->RequestedPaths.Add(FilePath);
+	Entry->Asset = NULL;
+	Entry->NumBytes = 0;
+	Entry->LastUsedTime = FPlatformTime::Seconds();
+	Entry->LoadTask = new FAsyncTask<FVictoryFileLoadTask>(Entry->FilePath, Type);
+	Entry->LoadTask->StartBackgroundTask();
+	Entries.Add(Entry->Key, Entry);
+	Lookup[Type].Add(FilePath, Entry);
+
+	NumLoading++;
+	return Entry;
+}
+
+bool FVictoryFileAssetCache::FinishLoad(FEntry* Entry)
+{
+	check(Entry->LoadTask && Entry->LoadTask->IsDone());
+
+	const FVictoryFileLoadTask& Task = Entry->LoadTask->GetTask();
+	if (!Task.bValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't load %s"), *Entry->FilePath);
+		RemoveEntry(Entry);
+		return false;
+	}
+
+	Entry->TimeStamp = Task.TimeStamp;
+
+	if (Entry->Type == EVictoryFileAsset::Sound)
+	{
+		USoundWave* sw = (USoundWave*)StaticConstructObject(USoundWave::StaticClass());
+
+		FByteBulkData& BulkData = sw->CompressedFormatData.GetFormat(TEXT("OGG"));
+		BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(BulkData.Realloc(Task.Data.Num()), Task.Data.GetData(), Task.Data.Num());
+		BulkData.Unlock();
+
+		sw->SoundGroup = ESoundGroup::SOUNDGROUP_Default;
+		sw->NumChannels = Task.SoundInfo.NumChannels;
+		sw->Duration = Task.SoundInfo.Duration;
+		sw->RawPCMDataSize = Task.SoundInfo.SampleDataSize;
+		sw->SampleRate = Task.SoundInfo.SampleRate;
+
+		Entry->Asset = sw;
+		Entry->NumBytes = Task.Data.Num();
+	}
+	else
+	{
+		UTexture2D* Texture = UTexture2D::CreateTransient(Task.Width, Task.Height, Task.Format);
+		if (Texture == NULL)
+		{
+			RemoveEntry(Entry);
+			return false;
+		}
+
+		#if WITH_EDITOR
+		Texture->MipGenSettings = TMGS_LeaveExistingMips;
+		#endif  //WITH_EDITOR
+
+		Texture->PlatformData->NumSlices = 1;
+		Texture->NeverStream = true;
+
+		int64 NumBytes = 0;
+		for (int32 i = 0; i < Task.MipOffsets.Num(); i++)
+		{
+			FTexture2DMipMap* Mip = NULL;
+			if (i < Texture->PlatformData->Mips.Num())
+			{
+				Mip = &Texture->PlatformData->Mips[i];
+			}
+			else
+			{
+				Mip = new(Texture->PlatformData->Mips) FTexture2DMipMap();
+				Mip->SizeX = FMath::Max(Task.Width >> i, 1);
+				Mip->SizeY = FMath::Max(Task.Height >> i, 1);
+			}
+
+			Mip->BulkData.Lock(LOCK_READ_WRITE);
+			void* MipData = Mip->BulkData.Realloc(Task.MipSizes[i]);
+			FMemory::Memcpy(MipData, Task.Data.GetData() + Task.MipOffsets[i], Task.MipSizes[i]);
+			Mip->BulkData.Unlock();
+
+			NumBytes += Task.MipSizes[i];
+		}
+
+		Texture->UpdateResource();
+
+		Entry->Asset = Texture;
+		Entry->NumBytes = NumBytes;
+	}
+
+	delete Entry->LoadTask;
+	Entry->LoadTask = NULL;
+	NumLoading--;
+
+	CachedBytes += Entry->NumBytes;
+	Entry->LastUsedTime = FPlatformTime::Seconds();
+
+	PlayPendingSounds(Entry);
+	TrimToBudget(Entry);
+	return true;
+}
+
+void FVictoryFileAssetCache::PlayPendingSounds(FEntry* Entry)
+{
+	USoundWave* Wave = Cast<USoundWave>(Entry->Asset);
+	if (Wave)
+	{
+		for (int32 i = 0; i < Entry->PendingSounds.Num(); i++)
+		{
+			PlayFileSound(Wave, Entry->PendingSounds[i]);
+		}
+	}
+
+	Entry->PendingSounds.Empty();
+}
+
+void FVictoryFileAssetCache::RemoveEntry(FEntry* Entry)
+{
+	if (Entry->LoadTask)
+	{
+		Entry->LoadTask->EnsureCompletion();
+		delete Entry->LoadTask;
+		NumLoading--;
+	}
+
+	CachedBytes -= Entry->NumBytes;
+	for (int32 i = 0; i < Entry->RequestedPaths.Num(); i++)
+	{
+		Lookup[Entry->Type].Remove(Entry->RequestedPaths[i]);
+	}
+	Entries.Remove(Entry->Key);
+	delete Entry;
+}
+
+void FVictoryFileAssetCache::TrimToBudget(const FEntry* Keep)
+{
+	const int64 Budget = (int64)FMath::Max(CVarFileCacheBudgetMB.GetValueOnGameThread(), 0) * 1024 * 1024;
+	while (CachedBytes > Budget)
+	{
+		FEntry* Oldest = NULL;
+		for (TMap<FString, FEntry*>::TIterator It(Entries); It; ++It)
+		{
+			FEntry* Entry = It.Value();
+			if (Entry != Keep && Entry->Asset && (Oldest == NULL || Entry->LastUsedTime < Oldest->LastUsedTime))
+			{
+				Oldest = Entry;
+			}
+		}
+
+		if (Oldest == NULL)
+		{
+			break;
+		}
+
+		RemoveEntry(Oldest);
+	}
+}
+
+void FVictoryFileAssetCache::StartStampCheck()
+{
+	TArray<FString> Keys;
+	TArray<FString> FilePaths;
+	TArray<FDateTime> LoadedTimeStamps;
+	for (TMap<FString, FEntry*>::TIterator It(Entries); It; ++It)
+	{
+		const FEntry* Entry = It.Value();
+		if (Entry->Asset)
+		{
+			Keys.Add(Entry->Key);
+			FilePaths.Add(Entry->FilePath);
+			LoadedTimeStamps.Add(Entry->TimeStamp);
+		}
+	}
+
+	LastStampCheckTime = FPlatformTime::Seconds();
+	if (Keys.Num() > 0)
+	{
+		StampTask = new FAsyncTask<FVictoryFileStampTask>(Keys, FilePaths, LoadedTimeStamps);
+		StampTask->StartBackgroundTask();
+	}
+}
+
+void FVictoryFileAssetCache::FinishStampCheck()
+{
+	check(StampTask && StampTask->IsDone());
+
+	const FVictoryFileStampTask& Task = StampTask->GetTask();
+	for (int32 i = 0; i < Task.Keys.Num(); i++)
+	{
+		// skip entries that were evicted or reloaded since the check started
+		FEntry* Entry = Entries.FindRef(Task.Keys[i]);
+		if (Entry && Entry->Asset && Entry->TimeStamp == Task.LoadedTimeStamps[i] && Task.TimeStamps[i] != Entry->TimeStamp)
+		{
+			// changed on disk
+			RemoveEntry(Entry);
+		}
+	}
+
+	delete StampTask;
+	StampTask = NULL;
+}
+
+void FVictoryFileAssetCache::Tick(float DeltaTime)
+{
+	if (StampTask && StampTask->IsDone())
+	{
+		FinishStampCheck();
+	}
+
+	if (StampTask == NULL && CVarFileCacheCheckTimeStamps.GetValueOnGameThread() != 0 && FPlatformTime::Seconds() - LastStampCheckTime > FileValidateInterval)
+	{
+		StartStampCheck();
+	}
+
+	TArray<FEntry*> Finished;
+	for (TMap<FString, FEntry*>::TIterator It(Entries); It; ++It)
+	{
+		FEntry* Entry = It.Value();
+		if (Entry->LoadTask && Entry->LoadTask->IsDone())
+		{
+			Finished.Add(Entry);
+		}
+	}
+
+	for (int32 i = 0; i < Finished.Num(); i++)
+	{
+		FinishLoad(Finished[i]);
+	}
+}
+
+bool FVictoryFileAssetCache::IsTickable() const
+{
+	// loading, or loaded entries whose files are watched
+	return NumLoading > 0 || StampTask != NULL || (Entries.Num() > NumLoading && CVarFileCacheCheckTimeStamps.GetValueOnGameThread() != 0);
+}
+
+bool FVictoryFileAssetCache::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+TStatId FVictoryFileAssetCache::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FVictoryFileAssetCache, STATGROUP_Tickables);
+}
+
+void FVictoryFileAssetCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TMap<FString, FEntry*>::TIterator It(Entries); It; ++It)
+	{
+		if (It.Value()->Asset)
+		{
+			Collector.AddReferencedObject(It.Value()->Asset);
+		}
+	}
+}
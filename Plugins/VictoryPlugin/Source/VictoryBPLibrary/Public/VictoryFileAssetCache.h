@@ -0,0 +1,162 @@
+/*
+	By Rama
+*/
+#pragma once
+
+namespace EVictoryFileAsset
+{
+	enum Type
+	{
+		Sound,
+		Texture,
+		MAX,
+	};
+}
+
+/** Sound queued to play once its file has been loaded */
+struct FVictoryPendingFileSound
+{
+	/** Played at Location in this object's world if set, attached to AttachToComponent otherwise */
+	TWeakObjectPtr<UObject> WorldContextObject;
+	TWeakObjectPtr<class USceneComponent> AttachToComponent;
+	FName AttachPointName;
+	FVector Location;
+	EAttachLocation::Type LocationType;
+	bool bStopWhenAttachedToDestroyed;
+	float VolumeMultiplier;
+	float PitchMultiplier;
+	float StartTime;
+	TWeakObjectPtr<class USoundAttenuation> AttenuationSettings;
+
+	FVictoryPendingFileSound()
+		: Location(ForceInit)
+		, LocationType(EAttachLocation::KeepRelativeOffset)
+		, bStopWhenAttachedToDestroyed(false)
+		, VolumeMultiplier(1.f)
+		, PitchMultiplier(1.f)
+		, StartTime(0.f)
+	{}
+};
+
+/**
+ * Sound waves and textures created from files on disk, kept by path.
+ *
+ * Files are read and their headers parsed on a worker thread, only the UObject is created on the game thread.
+ * Least recently used entries are evicted when the cache grows past Victory.FileCacheBudgetMB. Entries are
+ * also dropped when the file's time stamp changes, which a worker thread checks about once a second
+ * (Victory.FileCacheCheckTimeStamps, on by default).
+ */
+class FVictoryFileAssetCache : public FGCObject, public FTickableGameObject
+{
+public:
+	static FVictoryFileAssetCache& Get();
+
+	FVictoryFileAssetCache();
+	virtual ~FVictoryFileAssetCache();
+
+	/** Loaded asset, or NULL if it isn't loaded (yet) */
+	UObject* Find(const FString& FilePath, EVictoryFileAsset::Type Type);
+
+	/** Loaded asset, starts loading it in the background if it isn't */
+	UObject* FindOrRequest(const FString& FilePath, EVictoryFileAsset::Type Type);
+
+	/** Loaded asset, loads it right away if it isn't */
+	UObject* FindOrLoad(const FString& FilePath, EVictoryFileAsset::Type Type);
+
+	/** Is the file being loaded in the background? */
+	bool IsLoading(const FString& FilePath, EVictoryFileAsset::Type Type) const;
+
+	/** Play sound when the file is loaded, right away if it already is */
+	void PlayWhenLoaded(const FString& FilePath, const FVictoryPendingFileSound& Sound);
+
+	/** Bytes held by loaded assets */
+	int64 GetCachedBytes() const { return CachedBytes; }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual TStatId GetStatId() const override;
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+private:
+	struct FEntry
+	{
+		/** full path of the file */
+		FString FilePath;
+		EVictoryFileAsset::Type Type;
+
+		/** key in Entries */
+		FString Key;
+
+		/** paths the entry was asked for with, keys in Lookup */
+		TArray<FString> RequestedPaths;
+
+		/** time stamp of the loaded file */
+		FDateTime TimeStamp;
+
+		/** created asset, NULL while loading */
+		UObject* Asset;
+
+		/** bytes held by the asset */
+		int64 NumBytes;
+
+		/** for least recently used eviction */
+		double LastUsedTime;
+
+		/** background load in flight */
+		FAsyncTask<class FVictoryFileLoadTask>* LoadTask;
+
+		/** sounds to play once loaded */
+		TArray<FVictoryPendingFileSound> PendingSounds;
+	};
+
+	/** Entries by type and full path */
+	TMap<FString, FEntry*> Entries;
+
+	/** Entries by the path callers asked for, so only the first lookup with a path has to normalize it */
+	mutable TMap<FString, FEntry*> Lookup[EVictoryFileAsset::MAX];
+
+	/** Bytes held by all loaded assets */
+	int64 CachedBytes;
+
+	/** Background loads in flight */
+	int32 NumLoading;
+
+	/** Background read of the loaded files' time stamps, NULL between checks */
+	FAsyncTask<class FVictoryFileStampTask>* StampTask;
+
+	/** When StampTask was last started */
+	double LastStampCheckTime;
+
+	static FString GetKey(const FString& FullPath, EVictoryFileAsset::Type Type);
+
+	/** Entry for file, loaded or not, NULL if it was never requested */
+	FEntry* FindEntry(const FString& FilePath, EVictoryFileAsset::Type Type) const;
+
+	/** Loaded entry, marked as just used */
+	FEntry* FindValidEntry(const FString& FilePath, EVictoryFileAsset::Type Type);
+
+	/** Entry for file, starts a background load if there isn't one */
+	FEntry* Request(const FString& FilePath, EVictoryFileAsset::Type Type);
+
+	/** Create the asset once its background load is done, removes the entry and returns false if the file couldn't be used */
+	bool FinishLoad(FEntry* Entry);
+
+	/** Play queued sounds of loaded entry */
+	void PlayPendingSounds(FEntry* Entry);
+
+	/** Remove entry, waiting for its load if needed */
+	void RemoveEntry(FEntry* Entry);
+
+	/** Evict least recently used entries other than Keep until under budget */
+	void TrimToBudget(const FEntry* Keep);
+
+	/** Start reading the time stamps of loaded entries in the background */
+	void StartStampCheck();
+
+	/** Drop entries whose file changed, once StampTask is done */
+	void FinishStampCheck();
+};
@@ -5,6 +5,7 @@
 //#include "VictoryGame.h"
 #include "VictoryEdEnginePCH.h"
 #include "ScopedTransaction.h"
+#include "VictoryVertexGrid.h"
 
 #define LOCTEXT_NAMESPACE "VictoryVertexSnapEditor"
 
@@ -23,6 +24,7 @@
 //~~~ Defines ~~~
 
 //MAX
+#define MAX_VERTEX_COUNT_FOR_SNAPPING 262144
 #define MAX_VERTEX_COUNT_FOR_DRAWING 10000
 #define MAX_VERTEX_COUNT_FOR_DRAWING_SPHERES 5000
 
@@ -73,6 +75,11 @@ void FVictoryEdAlignMode::JoyInit(UVictoryEdEngine* EnginePtr)
 	//Always Initialize Your Pointers!
 	SelectedVertexBuffer = nullptr;
 	HighlightedVertexBuffer = nullptr;
+	ButtonsSelectedVertexBuffer = nullptr;
+	ButtonsHighlightedVertexBuffer = nullptr;
+	ButtonsHighlightedActor = nullptr;
+	ButtonsVerticiesScale = 0;
+	ButtonsViewProjectionMatrix = FMatrix::Identity;
 
 	  
 	//VictoryEngine
@@ -369,7 +376,7 @@ FPositionVertexBuffer* FVictoryEdAlignMode::GetVerticies(AStaticMeshActor* TheSM
 	
 	//~~~~~~~~~~~~~~~~~~~~
 	//			Count Too High?
-	if(VertexBuffer->GetNumVertices() > MAX_VERTEX_COUNT_FOR_DRAWING)
+	if(VertexBuffer->GetNumVertices() > MAX_VERTEX_COUNT_FOR_SNAPPING)
 	{
 		//UE_LOG(Victory, Error, TEXT("Vertex Count too high to draw! %d"), VertexBuffer->GetNumVertices() );
 		return NULL;
@@ -819,44 +826,50 @@ void FVictoryEdAlignMode::DoVertexSnap(const FVector& Dest)
 	
 }
 
-void FVictoryEdAlignMode::RefreshVertexButtons(const FSceneView* View)
+bool FVictoryEdAlignMode::VertexButtonsNeedRefresh(const FSceneView* View) const
 {
-	CHECK_VSELECTED
-	
-	if(!View) return;
+	if(!View) return false;
+	if(!VictoryEngine || !VictoryEngine->VSelectedActor) return false;
 	//~~~~~~~~~~~~~
 	
-	//No Longer Pending
-	PendingButtonRefresh = false;
+	//Camera
+	if(View->ViewRect != ButtonsViewRect) return true;
+	if(!View->ViewProjectionMatrix.Equals(ButtonsViewProjectionMatrix, KINDA_SMALL_NUMBER)) return true;
 	
-	//Refresh
-	SelectedActorButtons.Empty();
-	HighlightedActorButtons.Empty();
+	//Verticies
+	if(ButtonsSelectedVertexBuffer != SelectedVertexBuffer) return true;
+	if(ButtonsHighlightedVertexBuffer != HighlightedVertexBuffer) return true;
+	if(ButtonsHighlightedActor != HighlightedActor) return true;
+	if(ButtonsVerticiesScale != CurrentVerticiesScale) return true;
 	
-	//~~~ Vars ~~~
-	const float ButtonHalfSize = CurrentVerticiesScale/2;
+	//Actors moved
+	if(SelectedVertexBuffer && !VictoryEngine->VSelectedActor->GetTransform().Equals(ButtonsSelectedTransform)) return true;
+	if(HighlightedVertexBuffer && HighlightedActor && !HighlightedActor->GetTransform().Equals(ButtonsHighlightedTransform)) return true;
 	
-	//~~~~~~~~~~~~~~~~~~~~~
-	//			Selected Actor
-	//~~~~~~~~~~~~~~~~~~~~~
-	if(!VictoryEngine->VSelectedActor->IsValidLowLevel() ) return;
+	return false;
+}
+
+void FVictoryEdAlignMode::ProjectVertexButtons(const FSceneView* View, const FPositionVertexBuffer* VertexBuffer, const FTransform& SMATransform, TArray<FVButton>& Buttons, FVictoryVertexGrid& ButtonGrid, TArray<int32>& DrawList)
+{
+	const float ButtonHalfSize = CurrentVerticiesScale/2;
+	const FVector2D ViewSize(View->ViewRect.Width(), View->ViewRect.Height());
+	const FVector SMALocation = SMATransform.GetLocation();
 	
-	if(!SelectedVertexBuffer)  return;	
-	//~~~~~~~~~~~~~~~~~~
+	TArray<FVector2D> ButtonCenters;
 	
-	FTransform SMATransform = VictoryEngine->VSelectedActor->GetTransform();
-	FVector SMALocation 		= SMATransform.GetLocation();
-	const int32 VertexCount 			= SelectedVertexBuffer->GetNumVertices();
+	const int32 VertexCount = VertexBuffer->GetNumVertices();
 	for(int32 Itr = 0; Itr < VertexCount; Itr++)
 	{
 		//Get Rotated Scaled Translated Vertex Pos
-		VertexWorldSpace = SMALocation + SMATransform.TransformVector(SelectedVertexBuffer->VertexPosition(Itr));
+		VertexWorldSpace = SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr));
 		
-		//Get 2D Center
-		VictoryProject(View, 
-			VertexWorldSpace, 
-			Vertex2DCenter 
-		);
+		//Get 2D Center, skip if behind the camera
+		if(!View->WorldToPixel(VertexWorldSpace, Vertex2DCenter)) continue;
+		
+		//Off screen?
+		if(Vertex2DCenter.X < -ButtonHalfSize || Vertex2DCenter.X > ViewSize.X + ButtonHalfSize) continue;
+		if(Vertex2DCenter.Y < -ButtonHalfSize || Vertex2DCenter.Y > ViewSize.Y + ButtonHalfSize) continue;
+		//~~~~~~~~~~~~~
 		
 		FVButton NewButton;
 		NewButton.Vibe 			= 	Itr;
@@ -867,9 +880,66 @@ void FVictoryEdAlignMode::RefreshVertexButtons(const FSceneView* View)
 		NewButton.maxY			=	Vertex2DCenter.Y + ButtonHalfSize;
 
 		//Add Button
-		SelectedActorButtons.Add(NewButton);
+		Buttons.Add(NewButton);
+		ButtonCenters.Add(Vertex2DCenter);
 	}
 	
+	//Cells as big as a button, so the cursor can only be over buttons in the cells around it
+	ButtonGrid.Build(ButtonCenters, ViewSize, CurrentVerticiesScale);
+	
+	//Draw list
+	if(Buttons.Num() <= MAX_VERTEX_COUNT_FOR_DRAWING)
+	{
+		DrawList.AddUninitialized(Buttons.Num());
+		for(int32 Itr = 0; Itr < Buttons.Num(); Itr++)
+		{
+			DrawList[Itr] = Itr;
+		}
+	}
+	else
+	{
+		//Too many, draw one per patch of screen
+		ButtonGrid.GetThinned(MAX_VERTEX_COUNT_FOR_DRAWING, DrawList);
+	}
+}
+
+void FVictoryEdAlignMode::RefreshVertexButtons(const FSceneView* View)
+{
+	CHECK_VSELECTED
+	
+	if(!View) return;
+	//~~~~~~~~~~~~~
+	
+	//No Longer Pending
+	PendingButtonRefresh = false;
+	
+	//Refresh
+	SelectedActorButtons.Reset();
+	HighlightedActorButtons.Reset();
+	SelectedActorButtonGrid.Reset();
+	HighlightedActorButtonGrid.Reset();
+	SelectedActorDrawList.Reset();
+	HighlightedActorDrawList.Reset();
+	
+	//Remember what the buttons are for
+	ButtonsViewRect 				= View->ViewRect;
+	ButtonsViewProjectionMatrix 	= View->ViewProjectionMatrix;
+	ButtonsSelectedVertexBuffer 	= SelectedVertexBuffer;
+	ButtonsHighlightedVertexBuffer 	= HighlightedVertexBuffer;
+	ButtonsHighlightedActor 		= HighlightedActor;
+	ButtonsVerticiesScale 			= CurrentVerticiesScale;
+	
+	//~~~~~~~~~~~~~~~~~~~~~
+	//			Selected Actor
+	//~~~~~~~~~~~~~~~~~~~~~
+	if(!VictoryEngine->VSelectedActor->IsValidLowLevel() ) return;
+	
+	if(!SelectedVertexBuffer)  return;	
+	//~~~~~~~~~~~~~~~~~~
+	
+	ButtonsSelectedTransform = VictoryEngine->VSelectedActor->GetTransform();
+	ProjectVertexButtons(View, SelectedVertexBuffer, ButtonsSelectedTransform, SelectedActorButtons, SelectedActorButtonGrid, SelectedActorDrawList);
+	
 	//~~~~~~~~~~~~~~~~~~~~~
 	//			Highlighted Actor
 	//~~~~~~~~~~~~~~~~~~~~~
@@ -879,35 +949,90 @@ void FVictoryEdAlignMode::RefreshVertexButtons(const FSceneView* View)
 	if(!HighlightedVertexBuffer)  return;	
 	//~~~~~~~~~~~~~~~~~~
 	
-	SMATransform = HighlightedActor->GetTransform();
-	SMALocation 		= SMATransform.GetLocation();
-	const int32 VertexCount2 			= HighlightedVertexBuffer->GetNumVertices();
-	for(int32 Itr = 0; Itr < VertexCount2; Itr++)
+	ButtonsHighlightedTransform = HighlightedActor->GetTransform();
+	ProjectVertexButtons(View, HighlightedVertexBuffer, ButtonsHighlightedTransform, HighlightedActorButtons, HighlightedActorButtonGrid, HighlightedActorDrawList);
+}
+
+//```
+void FVictoryEdAlignMode::PDI_DrawVertex(FPrimitiveDrawInterface* PDI, const FVector& VertexPos, bool DrawingSelectedActor, int32 VertexCount)
+{
+	const FColor ShapeColor 		= DrawingSelectedActor ? RV_VRed : RV_VBlue;
+	const FLinearColor PointColor 	= DrawingSelectedActor ? RV_Red : RV_Blue;
+	
+	//Spheres
+	if(VertexDisplayChoice == VERTEX_DISPLAY_SPHERE)
 	{
-		//Get Rotated Scaled Translated Vertex Pos
-		VertexWorldSpace = SMALocation + SMATransform.TransformVector(HighlightedVertexBuffer->VertexPosition(Itr));
-		
-		//Get 2D Center
-		VictoryProject(View, 
-			VertexWorldSpace, 
-			Vertex2DCenter 
+		if(VertexCount > MAX_VERTEX_COUNT_FOR_DRAWING_SPHERES)
+		{
+		DrawWireBox(
+			PDI,
+			BoxFromPointWithSize(VertexPos,CurrentVerticiesScale*(DrawingSelectedActor ? 0.5 : VERTEX_SHAPE_MULT)),
+			ShapeColor,
+			0
 		);
-		
-		FVButton NewButton;
-		NewButton.Vibe 			= 	Itr;
-		NewButton.PointInWorld 	= 	VertexWorldSpace;
-		NewButton.minX			=	Vertex2DCenter.X - ButtonHalfSize;
-		NewButton.maxX			=	Vertex2DCenter.X + ButtonHalfSize;
-		NewButton.minY			=	Vertex2DCenter.Y - ButtonHalfSize;
-		NewButton.maxY			=	Vertex2DCenter.Y + ButtonHalfSize;
-
-		//Add Button
-		HighlightedActorButtons.Add(NewButton);
+		}
+		else
+		{
+		DrawWireSphere(
+			PDI, 
+			VertexPos,
+			ShapeColor, 
+			CurrentVerticiesScale*VERTEX_SHAPE_MULT, 
+			12, 
+			0
+		);
+		}
+	}
+	
+	//Diamond
+	else if(VertexDisplayChoice == VERTEX_DISPLAY_DIAMOND3D)
+	{
+	DrawWireSphere(
+		PDI, 
+		VertexPos,
+		ShapeColor, 
+		CurrentVerticiesScale*VERTEX_SHAPE_MULT, 
+		4, 
+		0
+	);
 	}
 	
+	//Box
+	else if(VertexDisplayChoice == VERTEX_DISPLAY_3DBOX)
+	{
+	DrawWireBox(
+		PDI,
+		BoxFromPointWithSize(VertexPos,CurrentVerticiesScale*(DrawingSelectedActor ? VERTEX_SHAPE_MULT : 1)),
+		ShapeColor,
+		0
+	);
+	}
+	
+	//Stars
+	else if(VertexDisplayChoice == VERTEX_DISPLAY_STARS)
+	{
+	DrawWireStar(
+		PDI,
+		VertexPos,
+		CurrentVerticiesScale, 
+		ShapeColor,
+		0
+	);
+	}
+	
+	//Rect
+	else if(VertexDisplayChoice == VERTEX_DISPLAY_RECT)
+	{
+	//Draw to the PDI
+	PDI->DrawPoint(
+		VertexPos,
+		PointColor,
+		CurrentVerticiesScale,
+		0 //depth
+	);
+	}
 }
 
-//```
 void FVictoryEdAlignMode::PDI_DrawVerticies(const FSceneView* View, FPrimitiveDrawInterface* PDI, const FPositionVertexBuffer* VertexBuffer, const FTransform& SMATransform, bool DrawingSelectedActor)
 {
 	CHECK_VSELECTED
@@ -926,229 +1051,49 @@ void FVictoryEdAlignMode::PDI_DrawVerticies(const FSceneView* View, FPrimitiveDr
 	//		how is it crashing here?
 	const int32 VertexCount = VertexBuffer->GetNumVertices();
 	
-	//~~~~~~~~~~~~~~~~~~~~~
-	//			Selected Actor
-	//~~~~~~~~~~~~~~~~~~~~~
-	if(DrawingSelectedActor)
-	{
-	for(int32 Itr = 0; Itr < VertexCount; Itr++)
-	{
-		//Selected Vertex?
-		if(SelectedVertexForSelectedActor == Itr )
-		{
-			//Draw to the PDI
-			PDI->DrawPoint(
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				RV_Yellow,
-				CurrentVerticiesScale*VERTEX_SELECTED_MULT,
-				0 //depth
-			);
-			continue;
-		}
-		else if(HighlightedVertexForSelectedActor == Itr)
-		{
-			//Draw to the PDI
-			PDI->DrawPoint(
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				FLinearColor(0,1,1,1),
-				CurrentVerticiesScale*VERTEX_SELECTED_MULT,
-				0 //depth
-			);
-			continue;
-		}
-		else
-		{
-			if(DrawVerticiesMode < 2) continue;
-			//~~~~~~~~~~~~~~~~~~~
-			
-			//Spheres
-			if(VertexDisplayChoice == VERTEX_DISPLAY_SPHERE)
-			{
-				if(VertexCount > MAX_VERTEX_COUNT_FOR_DRAWING_SPHERES)
-				{
-				DrawWireBox(
-					PDI,
-					BoxFromPointWithSize(SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),CurrentVerticiesScale*0.5),
-					RV_VRed,
-					0
-				);
-				continue;
-				}
-				else
-				{
-				DrawWireSphere(
-					PDI, 
-					SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-					RV_VRed, 
-					CurrentVerticiesScale*VERTEX_SHAPE_MULT, 
-					12, 
-					0
-				);
-				continue;
-				}
-			}
-			
-			//Diamond
-			else if(VertexDisplayChoice == VERTEX_DISPLAY_DIAMOND3D)
-			{
-			DrawWireSphere(
-				PDI, 
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				RV_VRed, 
-				CurrentVerticiesScale*VERTEX_SHAPE_MULT, 
-				4, 
-				0
-			);
-			continue;
-			}
-			
-			//Box
-			else if(VertexDisplayChoice == VERTEX_DISPLAY_3DBOX)
-			{
-			DrawWireBox(
-				PDI,
-				BoxFromPointWithSize(SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),CurrentVerticiesScale*VERTEX_SHAPE_MULT),
-				RV_VRed,
-				0
-			);
-			continue;
-			}
-			
-			//Stars
-			else if(VertexDisplayChoice == VERTEX_DISPLAY_STARS)
-			{
-			DrawWireStar(
-				PDI,
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				CurrentVerticiesScale, 
-				RV_VRed,
-				0
-			);
-			continue;
-			}
-			
-			//Rect
-			else if(VertexDisplayChoice == VERTEX_DISPLAY_RECT)
-			{
-			//Draw to the PDI
-			PDI->DrawPoint(
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				RV_Red,
-				CurrentVerticiesScale,
-				0 //depth
-			);
-			continue;
-			}
-			
-		}
-			
-	}
-	}
+	//Selected and hovered verticies, always drawn
+	const int32 SelectedVertex 		= DrawingSelectedActor ? SelectedVertexForSelectedActor : -1;
+	const int32 HighlightedVertex 	= DrawingSelectedActor ? HighlightedVertexForSelectedActor : HighlightedVertexForHighlightedActor;
 	
-	//~~~~~~~~~~~~~~~~~~~~~
-	//			Highlighted Actor
-	//~~~~~~~~~~~~~~~~~~~~~
-	else
-	{
-	for(int32 Itr = 0; Itr < VertexCount; Itr++)
+	if(SelectedVertex >= 0 && SelectedVertex < VertexCount)
 	{
-		if(HighlightedVertexForHighlightedActor == Itr)
-		{
-			//Draw to the PDI
-			PDI->DrawPoint(
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				FLinearColor(0,1,1,1),
-				CurrentVerticiesScale*VERTEX_SELECTED_MULT,
-				0 //depth
-			);
-			continue;
-		}
-		
-		//~~~~~~~~~~~~~~~~~~~
-		if(DrawVerticiesMode < 2) continue;
-		//~~~~~~~~~~~~~~~~~~~
-		
-		
-		//Spheres
-		if(VertexDisplayChoice == VERTEX_DISPLAY_SPHERE)
-		{
-			if(VertexCount > MAX_VERTEX_COUNT_FOR_DRAWING_SPHERES)
-			{
-			DrawWireBox(
-				PDI,
-				BoxFromPointWithSize(SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),CurrentVerticiesScale*VERTEX_SHAPE_MULT),
-				RV_VBlue,
-				0
-			);
-			continue;
-			}
-			else
-			{
-			DrawWireSphere(
-				PDI, 
-				SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-				RV_VBlue, 
-				CurrentVerticiesScale*VERTEX_SHAPE_MULT, 
-				12, 
-				0
-			);
-			continue;
-			}
-		}
-		
-		//Diamond
-		else if(VertexDisplayChoice == VERTEX_DISPLAY_DIAMOND3D)
-		{
-		DrawWireSphere(
-			PDI, 
-			SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-			RV_VBlue, 
-			CurrentVerticiesScale*VERTEX_SHAPE_MULT, 
-			4, 
-			0
-		);
-		continue;
-		}
-			
-		//Box
-		else if(VertexDisplayChoice == VERTEX_DISPLAY_3DBOX)
-		{
-		DrawWireBox(
-			PDI,
-			BoxFromPointWithSize(SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),CurrentVerticiesScale),
-			RV_VBlue,
-			0
-		);
-		continue;
-		}
-		
-		//Stars
-		else if(VertexDisplayChoice == VERTEX_DISPLAY_STARS)
-		{
-		
-		DrawWireStar(
-			PDI,
-			SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-			CurrentVerticiesScale, 
-			RV_VBlue,
-			0
+		//Draw to the PDI
+		PDI->DrawPoint(
+			SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(SelectedVertex)),
+			RV_Yellow,
+			CurrentVerticiesScale*VERTEX_SELECTED_MULT,
+			0 //depth
 		);
-		continue;
-		}
-		
-		//Rect
-		else if(VertexDisplayChoice == VERTEX_DISPLAY_RECT)
-		{
+	}
+	if(HighlightedVertex >= 0 && HighlightedVertex < VertexCount && HighlightedVertex != SelectedVertex)
+	{
 		//Draw to the PDI
 		PDI->DrawPoint(
-			SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(Itr)),
-			RV_Blue,
-			CurrentVerticiesScale,
+			SMALocation + SMATransform.TransformVector(VertexBuffer->VertexPosition(HighlightedVertex)),
+			FLinearColor(0,1,1,1),
+			CurrentVerticiesScale*VERTEX_SELECTED_MULT,
 			0 //depth
 		);
-		continue;
-		}
-	}	
+	}
+	
+	//~~~~~~~~~~~~~~~~~~~
+	if(DrawVerticiesMode < 2) return;
+	//~~~~~~~~~~~~~~~~~~~
+	
+	//The rest, only those on screen and thinned out if there are too many
+	//		buttons were made for this vertex buffer, if not they get remade before the next frame
+	const TArray<FVButton>& Buttons = DrawingSelectedActor ? SelectedActorButtons : HighlightedActorButtons;
+	const TArray<int32>& DrawList = DrawingSelectedActor ? SelectedActorDrawList : HighlightedActorDrawList;
+	if(VertexBuffer != (DrawingSelectedActor ? ButtonsSelectedVertexBuffer : ButtonsHighlightedVertexBuffer)) return;
+	//~~~~~~~~~~~~~~~~~~~
+	
+	for(int32 Itr = 0; Itr < DrawList.Num(); Itr++)
+	{
+		const FVButton& Button = Buttons[DrawList[Itr]];
+		if(Button.Vibe == SelectedVertex || Button.Vibe == HighlightedVertex) continue;
+		//~~~~~~~~~~~~~~~~~~~
+		
+		PDI_DrawVertex(PDI, Button.PointInWorld, DrawingSelectedActor, DrawList.Num());
 	}
 }
 
@@ -1343,6 +1288,27 @@ int32 FVictoryEdAlignMode::FindClosestOfButtons(TArray<FVButton*>& Inbuttons)
 	else return MinIndex;
 }
 
+void FVictoryEdAlignMode::GetButtonsUnderCursor(TArray<FVButton>& Buttons, const FVictoryVertexGrid& ButtonGrid, TArray<FVButton*>& OutButtons)
+{
+	//Grid was built for these buttons?
+	if(ButtonGrid.Num() != Buttons.Num()) return;
+	//~~~~~~~~~
+	
+	TArray<int32> ButtonIndices;
+	ButtonGrid.QueryBox(MouseLocation, CurrentVerticiesScale/2, ButtonIndices);
+	
+	for(int32 Itr = 0; Itr < ButtonIndices.Num(); Itr++)
+	{
+		CurCheckButton = &Buttons[ButtonIndices[Itr]];
+		//check cursor in bounds
+		if (CurCheckButton->minX <= MouseLocation.X && MouseLocation.X <= CurCheckButton->maxX &&
+			CurCheckButton->minY <= MouseLocation.Y && MouseLocation.Y <= CurCheckButton->maxY )
+		{
+			OutButtons.Add(CurCheckButton);
+		}
+	}
+}
+
 void FVictoryEdAlignMode::CheckCursorInButtons(FCanvas* Canvas)
 {	
 	if(!Canvas) return;
@@ -1384,21 +1350,8 @@ void FVictoryEdAlignMode::CheckCursorInButtons(FCanvas* Canvas)
 	//~~~~~~~~~~~~~~~~~~~
 	//Selected Actor Vertex Buttons
 	//~~~~~~~~~~~~~~~~~~~
-	RV_Int32=0;
-	ClosestSelectedActorButtons.Empty();
-	while(SelectedActorButtons.IsValidIndex(RV_Int32))
-	{
-		CurCheckButton = &SelectedActorButtons[RV_Int32];
-		//check cursor in bounds
-		if (CurCheckButton->minX <= MouseLocation.X && MouseLocation.X <= CurCheckButton->maxX &&
-			CurCheckButton->minY <= MouseLocation.Y && MouseLocation.Y <= CurCheckButton->maxY )
-		{
-			ClosestSelectedActorButtons.Add(&SelectedActorButtons[RV_Int32]);
-		}
-		
-		//~~~~~~~
-		RV_Int32++;
-	}
+	ClosestSelectedActorButtons.Reset();
+	GetButtonsUnderCursor(SelectedActorButtons, SelectedActorButtonGrid, ClosestSelectedActorButtons);
 	
 	//Find closest of potentially highlighted/selected
 	const int32 FoundIndex = FindClosestOfButtons(ClosestSelectedActorButtons);
@@ -1435,21 +1388,8 @@ void FVictoryEdAlignMode::CheckCursorInButtons(FCanvas* Canvas)
 	//Highlighted Actor Vertex Buttons
 	//~~~~~~~~~~~~~~~~~~~~~~
 	
-	RV_Int32=0;
-	ClosestHighlightedActorButtons.Empty();
-	while(HighlightedActorButtons.IsValidIndex(RV_Int32))
-	{
-		CurCheckButton = &HighlightedActorButtons[RV_Int32];
-		//check cursor in bounds
-		if (CurCheckButton->minX <= MouseLocation.X && MouseLocation.X <= CurCheckButton->maxX &&
-			CurCheckButton->minY <= MouseLocation.Y && MouseLocation.Y <= CurCheckButton->maxY )
-		{
-			ClosestHighlightedActorButtons.Add(&HighlightedActorButtons[RV_Int32]);
-		}
-		
-		//~~~~~~~
-		RV_Int32++;
-	}
+	ClosestHighlightedActorButtons.Reset();
+	GetButtonsUnderCursor(HighlightedActorButtons, HighlightedActorButtonGrid, ClosestHighlightedActorButtons);
 	
 	//Find closest of potentially highlighted
 	
@@ -1561,7 +1501,7 @@ void FVictoryEdAlignMode::DrawHUD(FEditorViewportClient* ViewportClient,FViewpor
 	if(!UsingMouseInstantMove) CheckCursorInButtons(Canvas);
 	
 	//~~~ Make Buttons? ~~~
-	if(PendingButtonRefresh) RefreshVertexButtons(View);
+	if(PendingButtonRefresh || (!UsingMouseInstantMove && VertexButtonsNeedRefresh(View))) RefreshVertexButtons(View);
 	
 	//~~~~~~~~~~~~~~~~~~~
 	//~~~~~~~~~~~~~~~~~~~
@@ -1582,9 +1522,7 @@ void FVictoryEdAlignMode::DrawHUD(FEditorViewportClient* ViewportClient,FViewpor
 	
 	//~~~~~~~~~~~~~~~
 	
-	//SUPER HYPER BUTTON REFRESHING
-	//		due to the slide physx camera thing when moving
-	if(!UsingMouseInstantMove) PendingButtonRefresh = true;
+	//Buttons are remade when the camera or actors move, see VertexButtonsNeedRefresh
 }
 
 void FVictoryEdAlignMode::Tick_VictoryTitle(FEditorViewportClient* ViewportClient)
@@ -0,0 +1,239 @@
+// Copyright 1998-2013 Epic Games, Inc. All Rights Reserved.
+
+#include "VictoryEdEnginePCH.h"
+#include "VictoryVertexGrid.h"
+
+FVictoryVertexGrid::FVictoryVertexGrid()
+	: CellSize(16)
+	, NumCellsX(0)
+	, NumCellsY(0)
+{
+}
+
+void FVictoryVertexGrid::Reset()
+{
+	NumCellsX = 0;
+	NumCellsY = 0;
+	SortedPoints.Reset();
+	SortedIndices.Reset();
+	CellStart.Reset();
+}
+
+void FVictoryVertexGrid::Build(const TArray<FVector2D>& InPoints, const FVector2D& Size, float InCellSize)
+{
+	Reset();
+	
+	CellSize = FMath::Max(InCellSize, 1.f);
+	NumCellsX = FMath::Max(FMath::CeilToInt(Size.X / CellSize), 1);
+	NumCellsY = FMath::Max(FMath::CeilToInt(Size.Y / CellSize), 1);
+	const int32 NumCells = NumCellsX * NumCellsY;
+	
+	//Count per cell
+	TArray<int32> PointCells;
+	PointCells.AddUninitialized(InPoints.Num());
+	CellStart.AddZeroed(NumCells + 1);
+	for(int32 Itr = 0; Itr < InPoints.Num(); Itr++)
+	{
+		PointCells[Itr] = GetCellY(InPoints[Itr].Y) * NumCellsX + GetCellX(InPoints[Itr].X);
+		CellStart[PointCells[Itr] + 1]++;
+	}
+	
+	//Prefix sum
+	for(int32 Cell = 0; Cell < NumCells; Cell++)
+	{
+		CellStart[Cell + 1] += CellStart[Cell];
+	}
+	
+	//Scatter
+	TArray<int32> Cursor = CellStart;
+	SortedPoints.AddUninitialized(InPoints.Num());
+	SortedIndices.AddUninitialized(InPoints.Num());
+	for(int32 Itr = 0; Itr < InPoints.Num(); Itr++)
+	{
+		const int32 Slot = Cursor[PointCells[Itr]]++;
+		SortedPoints[Slot] = InPoints[Itr];
+		SortedIndices[Slot] = Itr;
+	}
+}
+
+void FVictoryVertexGrid::QueryBox(const FVector2D& Center, float HalfSize, TArray<int32>& OutIndices) const
+{
+	if(!NumCellsX) return;
+	//~~~~~~~~~~~~~
+	
+	const int32 MinX = GetCellX(Center.X - HalfSize);
+	const int32 MaxX = GetCellX(Center.X + HalfSize);
+	const int32 MinY = GetCellY(Center.Y - HalfSize);
+	const int32 MaxY = GetCellY(Center.Y + HalfSize);
+	
+	for(int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		for(int32 X = MinX; X <= MaxX; X++)
+		{
+			const int32 Cell = Y * NumCellsX + X;
+			for(int32 Itr = CellStart[Cell]; Itr < CellStart[Cell + 1]; Itr++)
+			{
+				const FVector2D& Point = SortedPoints[Itr];
+				if(FMath::Abs(Point.X - Center.X) <= HalfSize && FMath::Abs(Point.Y - Center.Y) <= HalfSize)
+				{
+					OutIndices.Add(SortedIndices[Itr]);
+				}
+			}
+		}
+	}
+}
+
+int32 FVictoryVertexGrid::FindNearest(const FVector2D& Location, float MaxDistance) const
+{
+	if(!NumCellsX) return -1;
+	//~~~~~~~~~~~~~
+	
+	const int32 CenterX = GetCellX(Location.X);
+	const int32 CenterY = GetCellY(Location.Y);
+	const int32 MaxRing = FMath::Min(FMath::CeilToInt(MaxDistance / CellSize), FMath::Max(NumCellsX, NumCellsY));
+	
+	float BestDistSq = FMath::Square(MaxDistance);
+	int32 BestIndex = -1;
+	
+	//Rings of cells around the one Location is in
+	//		anything in ring N or further out is at least N-1 cells away
+	for(int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		if(BestIndex != -1 && Ring > 0 && BestDistSq <= FMath::Square((Ring - 1) * CellSize)) break;
+		//~~~~~~~~~~~~~
+		
+		const int32 MinY = FMath::Max(CenterY - Ring, 0);
+		const int32 MaxY = FMath::Min(CenterY + Ring, NumCellsY - 1);
+		for(int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			//Only the ring's edge, inner cells were done already
+			const bool bFullRow = (Y == CenterY - Ring || Y == CenterY + Ring);
+			const int32 StepX = bFullRow ? 1 : FMath::Max(Ring * 2, 1);
+			for(int32 X = CenterX - Ring; X <= CenterX + Ring; X += StepX)
+			{
+				if(X < 0 || X >= NumCellsX) continue;
+				//~~~~~~~~~~~~~
+				
+				const int32 Cell = Y * NumCellsX + X;
+				for(int32 Itr = CellStart[Cell]; Itr < CellStart[Cell + 1]; Itr++)
+				{
+					const float DistSq = FVector2D::DistSquared(SortedPoints[Itr], Location);
+					if(DistSq <= BestDistSq)
+					{
+						BestDistSq = DistSq;
+						BestIndex = SortedIndices[Itr];
+					}
+				}
+			}
+		}
+	}
+	
+	return BestIndex;
+}
+
+void FVictoryVertexGrid::GetThinned(int32 MaxPoints, TArray<int32>& OutIndices) const
+{
+	if(!NumCellsX || MaxPoints <= 0) return;
+	//~~~~~~~~~~~~~
+	
+	//Merge cells into blocks until there are few enough of them
+	const int32 Stride = FMath::Max(FMath::CeilToInt(FMath::Sqrt((float)(NumCellsX * NumCellsY) / MaxPoints)), 1);
+	
+	for(int32 BlockY = 0; BlockY < NumCellsY; BlockY += Stride)
+	{
+		for(int32 BlockX = 0; BlockX < NumCellsX; BlockX += Stride)
+		{
+			//First point of the first occupied cell in the block
+			bool bFound = false;
+			for(int32 Y = BlockY; Y < FMath::Min(BlockY + Stride, NumCellsY) && !bFound; Y++)
+			{
+				for(int32 X = BlockX; X < FMath::Min(BlockX + Stride, NumCellsX); X++)
+				{
+					const int32 Cell = Y * NumCellsX + X;
+					if(CellStart[Cell] < CellStart[Cell + 1])
+					{
+						OutIndices.Add(SortedIndices[CellStart[Cell]]);
+						bFound = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+//Victory.BenchVertexGrid [NumPoints] [NumQueries]
+//		times FindNearest against a brute force scan over random points and checks they agree
+static void BenchVertexGrid(const TArray<FString>& Args)
+{
+	const int32 NumPoints = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+	const int32 NumQueries = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 2000;
+	const FVector2D Size(1920, 1080);
+	const float CellSize = 16;
+	const float MaxDistance = 64;
+	
+	//Fixed seed so every run measures the same layout
+	FRandomStream Random(0x5EED);
+	TArray<FVector2D> Points;
+	Points.AddUninitialized(NumPoints);
+	for(int32 Itr = 0; Itr < NumPoints; Itr++)
+	{
+		Points[Itr] = FVector2D(Random.FRand() * Size.X, Random.FRand() * Size.Y);
+	}
+	TArray<FVector2D> Queries;
+	Queries.AddUninitialized(NumQueries);
+	for(int32 Itr = 0; Itr < NumQueries; Itr++)
+	{
+		Queries[Itr] = FVector2D(Random.FRand() * Size.X, Random.FRand() * Size.Y);
+	}
+	
+	double StartTime = FPlatformTime::Seconds();
+	FVictoryVertexGrid Grid;
+	Grid.Build(Points, Size, CellSize);
+	const double BuildTime = FPlatformTime::Seconds() - StartTime;
+	
+	TArray<int32> GridResults;
+	GridResults.AddUninitialized(NumQueries);
+	StartTime = FPlatformTime::Seconds();
+	for(int32 Itr = 0; Itr < NumQueries; Itr++)
+	{
+		GridResults[Itr] = Grid.FindNearest(Queries[Itr], MaxDistance);
+	}
+	const double GridTime = FPlatformTime::Seconds() - StartTime;
+	
+	int32 NumMismatches = 0;
+	StartTime = FPlatformTime::Seconds();
+	for(int32 Itr = 0; Itr < NumQueries; Itr++)
+	{
+		float BestDistSq = FMath::Square(MaxDistance);
+		int32 BestIndex = -1;
+		for(int32 Point = 0; Point < NumPoints; Point++)
+		{
+			const float DistSq = FVector2D::DistSquared(Points[Point], Queries[Itr]);
+			if(DistSq <= BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestIndex = Point;
+			}
+		}
+		
+		//Equally close points may be picked in a different order
+		const int32 GridIndex = GridResults[Itr];
+		if(GridIndex != BestIndex && (GridIndex == -1 || BestIndex == -1
+			|| FVector2D::DistSquared(Points[GridIndex], Queries[Itr]) != BestDistSq))
+		{
+			NumMismatches++;
+		}
+	}
+	const double BruteTime = FPlatformTime::Seconds() - StartTime;
+	
+	UE_LOG(Victory, Log, TEXT("BenchVertexGrid: %d points, %d queries, build %.2f ms, grid %.3f us/query, brute force %.3f us/query, %d mismatches: %s"),
+		NumPoints, NumQueries, BuildTime * 1000.0, GridTime * 1000000.0 / NumQueries, BruteTime * 1000000.0 / NumQueries,
+		NumMismatches, NumMismatches == 0 ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand CmdBenchVertexGrid(
+	TEXT("Victory.BenchVertexGrid"),
+	TEXT("Time vertex grid nearest queries against brute force and check they agree. Args: [NumPoints=100000] [NumQueries=2000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchVertexGrid)
+	);
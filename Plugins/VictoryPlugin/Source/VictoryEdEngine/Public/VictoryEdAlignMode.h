@@ -9,6 +9,9 @@
 //Input
 #include "InputCoreTypes.h"
 
+//Vertex Buttons
+#include "VictoryVertexGrid.h"
+
 class UVictoryEdEngine;
 
 struct FVButton;
@@ -70,15 +73,38 @@ public:
 	//Highlighted Actor
 	AStaticMeshActor* 				HighlightedActor;
 	
-	//Buttons
+	//Buttons, only for verticies that are on screen
 	TArray<FVButton> SelectedActorButtons;
 	TArray<FVButton> HighlightedActorButtons;
 	
+	//Buttons by screen location
+	FVictoryVertexGrid SelectedActorButtonGrid;
+	FVictoryVertexGrid HighlightedActorButtonGrid;
+	
+	//Buttons to draw, thinned out when there are too many
+	TArray<int32> SelectedActorDrawList;
+	TArray<int32> HighlightedActorDrawList;
+	
 	//CheckArrays - find the vertex button closest to camera
 	TArray<FVButton*> ClosestSelectedActorButtons;
 	TArray<FVButton*> ClosestHighlightedActorButtons;
 	int32 FindClosestOfButtons(TArray<FVButton*>& Inbuttons);
 	void RefreshVertexButtons(const FSceneView* View);
+	void ProjectVertexButtons(const FSceneView* View, const FPositionVertexBuffer* VertexBuffer, const FTransform& SMATransform, TArray<FVButton>& Buttons, FVictoryVertexGrid& ButtonGrid, TArray<int32>& DrawList);
+	void GetButtonsUnderCursor(TArray<FVButton>& Buttons, const FVictoryVertexGrid& ButtonGrid, TArray<FVButton*>& OutButtons);
+	
+	//Camera, actors or scale changed since buttons were made?
+	bool VertexButtonsNeedRefresh(const FSceneView* View) const;
+	
+	//What the buttons were made for
+	FMatrix 						ButtonsViewProjectionMatrix;
+	FIntRect 						ButtonsViewRect;
+	FTransform 						ButtonsSelectedTransform;
+	FTransform 						ButtonsHighlightedTransform;
+	const FPositionVertexBuffer* 	ButtonsSelectedVertexBuffer;
+	const FPositionVertexBuffer* 	ButtonsHighlightedVertexBuffer;
+	AStaticMeshActor* 				ButtonsHighlightedActor;
+	float 							ButtonsVerticiesScale;
 	//~~~~~~~~~
 	
 	//Vertex Scale
@@ -101,6 +127,7 @@ public:
 
 	//Vertex Functions
 	void PDI_DrawVerticies(const FSceneView* View, FPrimitiveDrawInterface* PDI, const FPositionVertexBuffer* VertexBuffer, const FTransform& SMATransform, bool DrawingSelectedActor);
+	void PDI_DrawVertex(FPrimitiveDrawInterface* PDI, const FVector& VertexPos, bool DrawingSelectedActor, int32 VertexCount);
 	
 	//Get Vertex Bufer
 	FPositionVertexBuffer* GetVerticies(AStaticMeshActor* TheSMA);
@@ -0,0 +1,39 @@
+#pragma once
+
+//Screen space buckets of projected vertices
+//		so finding the ones under the cursor, or thinning them for drawing, 
+//		only looks at a few cells instead of every vertex
+struct FVictoryVertexGrid
+{
+	FVictoryVertexGrid();
+	
+	//Bucket the points, all inside (0,0) - Size, into square cells of CellSize pixels
+	void Build(const TArray<FVector2D>& InPoints, const FVector2D& Size, float InCellSize);
+	void Reset();
+	
+	//Indices of points within HalfSize of Center on both axes
+	void QueryBox(const FVector2D& Center, float HalfSize, TArray<int32>& OutIndices) const;
+	
+	//Index of the point closest to Location within MaxDistance, -1 if none
+	int32 FindNearest(const FVector2D& Location, float MaxDistance) const;
+	
+	//At most about MaxPoints indices spread evenly over the occupied cells
+	void GetThinned(int32 MaxPoints, TArray<int32>& OutIndices) const;
+	
+	FORCEINLINE int32 Num() const { return SortedIndices.Num(); }
+	
+private:
+	float CellSize;
+	int32 NumCellsX;
+	int32 NumCellsY;
+	
+	//Points and their original indices, sorted by cell
+	TArray<FVector2D> SortedPoints;
+	TArray<int32> SortedIndices;
+	
+	//First sorted entry of each cell, plus one past the last
+	TArray<int32> CellStart;
+	
+	FORCEINLINE int32 GetCellX(float X) const { return FMath::Clamp(FMath::FloorToInt(X / CellSize), 0, NumCellsX - 1); }
+	FORCEINLINE int32 GetCellY(float Y) const { return FMath::Clamp(FMath::FloorToInt(Y / CellSize), 0, NumCellsY - 1); }
+};
@@ -57,6 +57,9 @@ protected:
 	// Check of we have LOS to a character
 	bool LOSTrace(AShooterCharacter* InEnemyChar) const;
 
+	/** shared enemy search of the game mode, NULL on clients */
+	class UShooterBotPerception* GetBotPerception() const;
+
 	int32 EnemyKeyID;
 	int32 NeedAmmoKeyID;
 
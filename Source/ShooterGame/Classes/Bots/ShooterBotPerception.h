@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterBotPerception.generated.h"
+
+/** living pawn in the perception grid */
+struct FPerceivedPawn
+{
+	class AShooterCharacter* Pawn;
+
+	FVector Location;
+};
+
+/** result of a line of sight trace, reused for a short time */
+struct FCachedLineOfSight
+{
+	/** world time of the trace */
+	float Time;
+
+	/** refresh trace is queued, the previous result is used until it arrives */
+	bool bPending;
+
+	/** trace stopped at the target */
+	bool bHitTarget;
+
+	/** trace stopped at a character of another team */
+	bool bHitEnemy;
+};
+
+/**
+ * Server side enemy search shared by all bots.
+ *
+ * Living pawns are bucketed in a 2D grid that is rebuilt at most once per frame, so closest
+ * enemy queries only look at nearby cells. Line of sight traces are cached per observer and
+ * target for LOSCacheTime, bots asking the same question in the same time window share one trace.
+ * Expired results are refreshed through the async trace queue, so bots react to the result a
+ * frame later instead of tracing on the game thread.
+ */
+UCLASS(config=Game)
+class UShooterBotPerception : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UShooterBotPerception(const FObjectInitializer& ObjectInitializer);
+
+	/** find closest living enemy of observer, optionally only enemies it has weapon line of sight to */
+	class AShooterCharacter* FindClosestEnemy(AController* Observer, class AShooterCharacter* ExcludeEnemy, bool bRequireLOS);
+
+	/** weapon line of sight from observer's eyes to target. bAnyEnemy accepts other enemies blocking the shot */
+	bool HasLineOfSight(AController* Observer, AActor* Target, bool bAnyEnemy);
+
+	/** line of sight traces per second, averaged over the last second */
+	float GetTracesPerSecond() const;
+
+	/** line of sight cache hits per second, averaged over the last second */
+	float GetCacheHitsPerSecond() const;
+
+protected:
+	/** size of a grid cell */
+	UPROPERTY(config)
+	float CellSize;
+
+	/** how long line of sight results are reused */
+	UPROPERTY(config)
+	float LOSCacheTime;
+
+	/** pawns in the grid */
+	TArray<FPerceivedPawn> Pawns;
+
+	/** indices into Pawns, per cell */
+	TMap<FIntPoint, TArray<int32> > Cells;
+
+	/** grid bounds */
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+
+	/** line of sight results, keyed by observer pawn and target */
+	TMap<uint64, FCachedLineOfSight> LOSCache;
+
+	/** frame the grid was last built */
+	uint64 LastUpdateFrame;
+
+	/** trace counters for the current second */
+	float StatsWindowStart;
+	int32 NumTraces;
+	int32 NumCacheHits;
+	float TracesPerSecond;
+	float CacheHitsPerSecond;
+
+	/** queued line of sight trace is done */
+	void OnLineOfSightTrace(const FHitResult& Hit, uint64 Key, TWeakObjectPtr<AController> Observer, TWeakObjectPtr<AActor> Target);
+
+	/** rebuild grid and drop stale line of sight results, once per frame */
+	void UpdateIndex(UWorld* World);
+
+	/** grid cell of location */
+	FIntPoint GetCell(const FVector& Location) const;
+};
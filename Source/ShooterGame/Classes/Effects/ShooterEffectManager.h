@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterTypes.h"
+#include "ShooterEffectManager.generated.h"
+
+/** surface lookups of one impact effect blueprint, built once from its defaults */
+struct FImpactEffectSet
+{
+	/** particles per physical surface */
+	TArray<UParticleSystem*> FX;
+
+	/** sound per physical surface */
+	TArray<USoundCue*> Sounds;
+
+	/** decal for all surfaces */
+	FDecalData Decal;
+};
+
+/** explosion light that is fading out */
+struct FFadingExplosionLight
+{
+	UPointLightComponent* Light;
+
+	/** world time the explosion started */
+	float StartTime;
+
+	/** fade out duration */
+	float FadeOut;
+
+	/** intensity of the explosion blueprint's light */
+	float Intensity;
+};
+
+/**
+ * Plays impact and explosion effects for the local world.
+ *
+ * Impact and explosion blueprints are only read for their defaults, no effect actors are spawned.
+ * Particles and explosion lights come from component pools and the number of effects started in
+ * a single frame is capped. Nothing is created on dedicated servers.
+ */
+UCLASS(config=Game, NotPlaceable, Transient)
+class AShooterEffectManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AShooterEffectManager(const FObjectInitializer& ObjectInitializer);
+
+	/** get effect manager of the world, creating it on first use. NULL on dedicated servers */
+	static AShooterEffectManager* Get(UWorld* World);
+
+	/** can another effect start this frame? Check before doing extra work for an effect */
+	bool HasBudget() const;
+
+	/** play impact effect matching the surface that was hit */
+	void PlayImpact(TSubclassOf<class AShooterImpactEffect> Template, const FVector& Location, const FRotator& Rotation, const FHitResult& SurfaceHit);
+
+	/** play explosion effect */
+	void PlayExplosion(TSubclassOf<class AShooterExplosionEffect> Template, const FVector& Location, const FRotator& Rotation, const FHitResult& SurfaceHit);
+
+	/** fade explosion lights */
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	/** max effects started in a single frame, the rest is dropped */
+	UPROPERTY(config)
+	int32 MaxEffectsPerFrame;
+
+	/** max pooled particle components, the one started longest ago is reused when all are playing */
+	UPROPERTY(config)
+	int32 MaxParticleComponents;
+
+	/** max pooled explosion lights, extra explosions play without a light */
+	UPROPERTY(config)
+	int32 MaxExplosionLights;
+
+	/** pooled particle components */
+	UPROPERTY(Transient)
+	TArray<UParticleSystemComponent*> ParticlePool;
+
+	/** world time each pooled particle component was last started */
+	TArray<float> ParticleStartTimes;
+
+	/** pooled explosion lights */
+	UPROPERTY(Transient)
+	TArray<UPointLightComponent*> LightPool;
+
+	/** lights currently fading out */
+	TArray<FFadingExplosionLight> FadingLights;
+
+	/** cached surface lookups, per impact blueprint */
+	TMap<UClass*, FImpactEffectSet> ImpactSets;
+
+	/** frame the budget was last reset */
+	uint64 BudgetFrame;
+
+	/** effects started this frame */
+	int32 EffectsThisFrame;
+
+	/** count an effect against this frame's budget, false if it's used up */
+	bool ConsumeBudget();
+
+	/** get surface lookups for impact blueprint */
+	const FImpactEffectSet& GetImpactSet(TSubclassOf<class AShooterImpactEffect> Template);
+
+	/** start particle system from the pool */
+	void PlayParticles(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation);
+
+	/** get a free light from the pool, NULL if all are in use */
+	UPointLightComponent* GetFreeLight();
+
+	/** spawn decal on hit surface */
+	void SpawnDecal(const FDecalData& Decal, const FHitResult& SurfaceHit);
+};
@@ -4,8 +4,8 @@
 #include "ShooterExplosionEffect.generated.h"
 
 //
-// Spawnable effect for explosion - NOT replicated to clients
-// Each explosion type should be defined as separate blueprint
+// Effect definition for explosion - NOT replicated to clients
+// Each explosion type should be defined as separate blueprint, AShooterEffectManager plays it from the defaults
 //
 UCLASS(Abstract, Blueprintable)
 class AShooterExplosionEffect : public AActor
@@ -49,6 +49,9 @@ private:
 	/** Point light component name */
 	FName ExplosionLightComponentName;
 
+	/** light intensity from defaults, cached when spawned */
+	float DefaultLightIntensity;
+
 public:
 	/** Returns ExplosionLight subobject **/
 	FORCEINLINE UPointLightComponent* GetExplosionLight() const { return ExplosionLight; }
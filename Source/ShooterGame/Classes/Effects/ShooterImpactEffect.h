@@ -4,8 +4,8 @@
 #include "ShooterImpactEffect.generated.h"
 
 //
-// Spawnable effect for weapon hit impact - NOT replicated to clients
-// Each impact type should be defined as separate blueprint
+// Effect definition for weapon hit impact - NOT replicated to clients
+// Each impact type should be defined as separate blueprint, AShooterEffectManager plays it from the defaults
 //
 UCLASS(Abstract, Blueprintable)
 class AShooterImpactEffect : public AActor
@@ -95,8 +95,6 @@ class AShooterImpactEffect : public AActor
 	/** spawn effect */
 	virtual void PostInitializeComponents() override;
 
-protected:
-
 	/** get FX for material type */
 	UParticleSystem* GetImpactFX(TEnumAsByte<EPhysicalSurface> SurfaceType) const;
 
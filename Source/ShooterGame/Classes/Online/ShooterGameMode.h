@@ -135,4 +135,74 @@ public:
 	UPROPERTY()
 	TArray<class AShooterPickup*> LevelPickups;
 
+	/** [server] take a parked projectile of given class, returns NULL when a new one has to be spawned */
+	class AShooterProjectile* AcquirePooledProjectile(TSubclassOf<class AShooterProjectile> ProjectileClass);
+
+	/** [server] park projectile for reuse, returns false when it should be destroyed instead */
+	bool ReleasePooledProjectile(class AShooterProjectile* Projectile);
+
+	/** enable or disable projectile pooling, parked projectiles are destroyed when disabled */
+	void SetUseProjectilePool(bool bEnable);
+
+	/** is projectile pooling enabled? */
+	bool IsUsingProjectilePool() const;
+
+	/** [server] take a parked weapon of given class, returns NULL when a new one has to be spawned */
+	class AShooterWeapon* AcquirePooledWeapon(TSubclassOf<class AShooterWeapon> WeaponClass);
+
+	/** [server] park weapon nobody holds for reuse, returns false when it should be destroyed instead */
+	bool ReleasePooledWeapon(class AShooterWeapon* Weapon);
+
+	/** [server] take a parked weapon pickup of given class, returns NULL when a new one has to be spawned */
+	class AShooter_Pickup* AcquirePooledPickup(TSubclassOf<class AShooter_Pickup> PickupClass);
+
+	/** [server] park used up weapon pickup for reuse, returns false when it should be destroyed instead */
+	bool ReleasePooledPickup(class AShooter_Pickup* Pickup);
+
+	/** [server] enemy search and line of sight cache shared by all bots */
+	class UShooterBotPerception* GetBotPerception();
+
+	/** [server] pickups by type and location, for bots looking for one */
+	class UShooterPickupRegistry* GetPickupRegistry();
+
+	/** [server] cached player start scores used by ChoosePlayerStart */
+	class UShooterSpawnScoring* GetSpawnScoring();
+
+protected:
+
+	/** reuse exploded projectiles instead of destroying them */
+	UPROPERTY(config)
+	bool bUseProjectilePool;
+
+	/** max parked projectiles kept for each projectile class */
+	UPROPERTY(config)
+	int32 MaxPooledProjectiles;
+
+	/** parked projectiles, per class */
+	TMap<UClass*, TArray<TWeakObjectPtr<class AShooterProjectile> > > ProjectilePool;
+
+	/** max parked weapons and weapon pickups kept for each class, 0 disables pooling them */
+	UPROPERTY(config)
+	int32 MaxPooledPickups;
+
+	/** parked weapons and weapon pickups, per class */
+	TMap<UClass*, TArray<TWeakObjectPtr<AActor> > > PickupPool;
+
+	/** take a parked actor of given class from PickupPool */
+	AActor* AcquirePooledPickupActor(UClass* ActorClass);
+
+	/** is there room in PickupPool for actor? */
+	bool CanPoolPickupActor(AActor* Actor) const;
+
+	/** bot perception, created on first use */
+	UPROPERTY(Transient)
+	class UShooterBotPerception* BotPerception;
+
+	/** pickup registry, created on first use */
+	UPROPERTY(Transient)
+	class UShooterPickupRegistry* PickupRegistry;
+
+	/** spawn scoring, created on first use */
+	UPROPERTY(Transient)
+	class UShooterSpawnScoring* SpawnScoring;
 };
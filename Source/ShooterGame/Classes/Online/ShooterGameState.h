@@ -28,8 +28,61 @@ public:
 	UPROPERTY(Transient, Replicated)
 	bool bTimerPaused;
 
+	/** server world time, sent every few seconds so clients can follow the server clock */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_ReplicatedWorldTimeSeconds)
+	float ReplicatedWorldTimeSeconds;
+
+	/** estimate of the server's world time, for evaluating server time stamps on clients */
+	float GetServerWorldTimeSeconds() const;
+
+	/** start sending the server clock */
+	virtual void PostInitializeComponents() override;
+
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
+	/** score or team of a player changed, ranking is sorted again on next use */
+	void MarkRankingDirty();
+
+	/** changes every time the ranking may have changed, poll to skip rebuilding rank maps */
+	uint32 GetRankingVersion() const;
+
+	// Begin AGameState interface
+	virtual void AddPlayerState(class APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(class APlayerState* PlayerState) override;
+	// End AGameState interface
+
 	void RequestFinishAndExitToMainMenu();
+
+	/** local impact and explosion effects, see AShooterEffectManager::Get */
+	UPROPERTY(Transient)
+	class AShooterEffectManager* EffectManager;
+
+	/** gameplay traces that can wait a frame, see UShooterTraceQueue::Get */
+	UPROPERTY(Transient)
+	class UShooterTraceQueue* TraceQueue;
+
+protected:
+
+	/** [server] refresh ReplicatedWorldTimeSeconds */
+	void UpdateServerTimeSeconds();
+
+	/** [client] work out the clock offset */
+	UFUNCTION()
+	void OnRep_ReplicatedWorldTimeSeconds();
+
+	/** server world time minus local world time, 0 on the server */
+	float ServerWorldTimeSecondsDelta;
+
+	/** sort players of each team by score */
+	void UpdateRanking() const;
+
+	/** players of each team, best score first */
+	mutable TArray<TArray<TWeakObjectPtr<AShooterPlayerState> > > RankedTeams;
+
+	/** RankedTeams needs sorting */
+	mutable bool bRankingDirty;
+
+	/** bumped by MarkRankingDirty */
+	uint32 RankingVersion;
 };
@@ -21,6 +21,9 @@ class AShooterPlayerState : public APlayerState
 
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** resort scoreboard ranking on clients */
+	virtual void OnRep_Score() override;
+
 	// End APlayerState interface
 
 	/**
@@ -111,4 +114,7 @@ protected:
 
 	/** helper for scoring points */
 	void ScorePoints(int32 Points);
+
+	/** tell game state that score or team changed */
+	void NotifyRankingChanged();
 };
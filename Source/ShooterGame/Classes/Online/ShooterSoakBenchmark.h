@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterSoakBenchmark.generated.h"
+
+/** numbers recorded for one soak frame */
+struct FSoakFrameSample
+{
+	/** wall time since previous frame */
+	float FrameMs;
+
+	/** collision queries issued by game code */
+	int32 SceneQueries;
+
+	/** bunches sent by the game net driver, RPCs and property updates */
+	int32 OutBunches;
+
+	/** bytes sent by the game net driver */
+	int32 OutBytes;
+
+	/** client connections open on the game net driver */
+	int32 NumConnections;
+};
+
+/**
+ * Headless server soak run, started by AShooterGameMode when the SoakFrames URL option is set:
+ *
+ *   ShooterGameServer /Game/Maps/Highrise?Bots=16?SoakFrames=3000?SoakSeed=1?SoakFPS=30 -nullrhi -nosound
+ *
+ * RNG is seeded and the engine runs with a fixed time step, so runs with the same options are
+ * comparable. The match has no time limit during a soak run. Once it is in progress every frame is
+ * sampled, after SoakFrames frames a JSON report is written to Saved/Profiling/Soak and the server
+ * exits. If the match ends or the map changes first, the report covers the frames sampled so far.
+ *
+ * To measure replication, connect headless clients (ShooterGame 127.0.0.1 -nullrhi -nosound) and
+ * compare out_bytes_per_connection of runs with ?SoakNetAdaptive=0 and ?SoakNetAdaptive=1, which
+ * sets Shooter.NetAdaptiveRelevancy for the run.
+ */
+UCLASS(NotPlaceable, Transient)
+class AShooterSoakBenchmark : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AShooterSoakBenchmark(const FObjectInitializer& ObjectInitializer);
+
+	/** seed RNG, fix time step and spawn benchmark if URL options ask for a soak run, NULL if they don't */
+	static AShooterSoakBenchmark* StartFromOptions(UWorld* World, const FString& Options);
+
+	/** sample frame */
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** report what was sampled if the run is cut short */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	/** frames to record */
+	int32 NumFrames;
+
+	/** RNG seed of this run */
+	int32 Seed;
+
+	/** bots requested for this run */
+	int32 NumBots;
+
+	/** Shooter.NetAdaptiveRelevancy during this run */
+	bool bNetAdaptiveRelevancy;
+
+	/** samples so far */
+	TArray<FSoakFrameSample> Samples;
+
+	/** time of previous sample */
+	double LastFrameTime;
+
+	/** net driver counters at previous sample */
+	uint32 LastOutBunches;
+	uint32 LastOutBytes;
+
+	/** report was written */
+	bool bFinished;
+
+	/** write report and shut down */
+	void Finish();
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterSpawnScoring.generated.h"
+
+/** influence cached for one player start */
+struct FScoredPlayerStart
+{
+	APlayerStart* Start;
+
+	FVector Location;
+
+	/** score per team slot, higher is safer */
+	TArray<float> Scores;
+
+	/** enemies per team slot that could see the start at the last sight check */
+	TArray<uint8> VisibleEnemies;
+};
+
+/** recent death, spawning next to it is a bad idea */
+struct FSpawnDeath
+{
+	FVector Location;
+
+	float Time;
+};
+
+/**
+ * Server side spawn point scores, owned by the game mode.
+ *
+ * Every RefreshInterval each player start gets a score per team slot from the closest enemy,
+ * nearby team mates, recent deaths and enemies that could see it. Sight traces are spread over
+ * refreshes, MaxSightTracesPerRefresh at a time, and the results kept until the start's next
+ * turn. Choosing a spawn then only reads scores. Without teams there is one slot and every
+ * pawn is an enemy.
+ */
+UCLASS(config=Game)
+class UShooterSpawnScoring : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UShooterSpawnScoring(const FObjectInitializer& ObjectInitializer);
+
+	/** recompute scores if they are older than RefreshInterval */
+	void Refresh();
+
+	/** a pawn died at location */
+	void AddDeath(const FVector& Location);
+
+	/** scored starts, in the game mode's PlayerStarts order */
+	const TArray<FScoredPlayerStart>& GetStarts() const;
+
+	/** "Play from Here" start, if there is one */
+	APlayerStart* GetPlayInEditorStart() const;
+
+	/** team slot the player's scores are in */
+	int32 GetTeamSlot(AController* Player) const;
+
+	/** leading candidates within this score of the best one are picked at random */
+	UPROPERTY(config)
+	float RandomScoreRange;
+
+protected:
+	/** seconds between refreshes */
+	UPROPERTY(config)
+	float RefreshInterval;
+
+	/** enemies further away than this don't lower the score */
+	UPROPERTY(config)
+	float SafeEnemyDistance;
+
+	/** enemies further away than this aren't checked for sight */
+	UPROPERTY(config)
+	float SightDistance;
+
+	/** team mates closer than this raise the score */
+	UPROPERTY(config)
+	float TeamPresenceRadius;
+
+	/** deaths closer than this lower the score */
+	UPROPERTY(config)
+	float DeathRadius;
+
+	/** how long deaths are remembered */
+	UPROPERTY(config)
+	float DeathMemoryTime;
+
+	/** sight traces per refresh over all starts */
+	UPROPERTY(config)
+	int32 MaxSightTracesPerRefresh;
+
+	/** closest enemies checked for sight per start and team slot */
+	UPROPERTY(config)
+	int32 MaxSightChecksPerStart;
+
+	/** score weights */
+	UPROPERTY(config)
+	float EnemyDistanceWeight;
+
+	UPROPERTY(config)
+	float VisibleEnemyWeight;
+
+	UPROPERTY(config)
+	float RecentDeathWeight;
+
+	UPROPERTY(config)
+	float TeamPresenceWeight;
+
+	/** scored starts */
+	TArray<FScoredPlayerStart> Starts;
+
+	/** "Play from Here" start */
+	APlayerStart* PlayInEditorStart;
+
+	/** recent deaths, oldest first */
+	TArray<FSpawnDeath> Deaths;
+
+	/** world time of the last refresh */
+	float LastRefreshTime;
+
+	/** start the next sight checks begin at */
+	int32 NextSightStart;
+
+	/** team slots in use */
+	int32 NumTeamSlots;
+
+	/** match Starts to the game mode's PlayerStarts */
+	void UpdateStarts(class AShooterGameMode* GameMode);
+};
@@ -6,7 +6,8 @@
 #include "PickupSpawner.generated.h"
 
 /**
- * 
+ * Server side respawn point for weapon pickups: places a PickupClass pickup on begin play and
+ * places a new one RespawnTime seconds after it was used up. Pickups come from the game mode's pool.
  */
 UCLASS()
 class SHOOTERGAME_API APickupSpawner : public AActor
@@ -18,5 +19,25 @@ class SHOOTERGAME_API APickupSpawner : public AActor
 public:
 	UPROPERTY(VisibleAnywhere, Category = MyStuff)
 		UStaticMeshComponent* EditorMesh;
-	
+
+	/** pickup placed here */
+	UPROPERTY(EditAnywhere, Category = MyStuff)
+		TSubclassOf<class AShooter_Pickup> PickupClass;
+
+	/** seconds until the next pickup is placed after the last one was used up, 0 to never respawn */
+	UPROPERTY(EditAnywhere, Category = MyStuff)
+		float RespawnTime;
+
+	virtual void BeginPlay() override;
+
+	/** [server] pickup placed by this spawner is gone */
+	void OnPickupConsumed(class AShooter_Pickup* Pickup);
+
+protected:
+	/** [server] place pickup if there is none */
+	void SpawnPickup();
+
+	/** pickup currently placed */
+	UPROPERTY(Transient)
+		class AShooter_Pickup* CurrentPickup;
 };
@@ -17,6 +17,9 @@ class AShooterPickup : public AActor
 	/** initial setup */
 	virtual void BeginPlay() override;
 
+	/** [server] add pickup to the bot pickup registry */
+	virtual void RegisterPickup(class UShooterPickupRegistry* Registry);
+
 private:
 	/** FX component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Effects)
@@ -60,6 +63,9 @@ protected:
 	/** handle touches */
 	void PickupOnTouch(class AShooterCharacter* Pawn);
 
+	/** [server] tell the pickup registry when this pickup is available next */
+	void UpdateRegistry(float AvailableTime);
+
 	/** show and enable pickup */
 	virtual void RespawnPickup();
 
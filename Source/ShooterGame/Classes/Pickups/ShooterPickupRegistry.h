@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterPickupRegistry.generated.h"
+
+namespace EShooterPickupType
+{
+	enum Type
+	{
+		Ammo,
+		Health,
+		Weapon,
+		Overshield,
+		MAX,
+	};
+}
+
+/** pickup known to the registry */
+struct FRegisteredPickup
+{
+	TWeakObjectPtr<AActor> Pickup;
+
+	FVector Location;
+
+	/** weapon class ammo and weapon pickups are for */
+	UClass* ForClass;
+
+	/** weapon classification of weapon pickups, INDEX_NONE otherwise */
+	int32 Classification;
+
+	EShooterPickupType::Type Type;
+
+	/** world time the pickup is or becomes available, MAX_FLT while it won't come back */
+	float AvailableTime;
+
+	/** grid cell it is in */
+	FIntPoint Cell;
+};
+
+/** what to look for */
+struct FPickupQuery
+{
+	EShooterPickupType::Type Type;
+
+	/** only pickups for this weapon class or its subclasses, NULL for any */
+	UClass* ForClass;
+
+	/** only weapon pickups of this classification, INDEX_NONE for any */
+	int32 Classification;
+
+	/** also accept pickups that respawn within this many seconds */
+	float MaxWaitTime;
+
+	/** only level pickups this pawn can use right now, NULL to skip the check */
+	class AShooterCharacter* ForPawn;
+
+	FPickupQuery(EShooterPickupType::Type InType)
+		: Type(InType)
+		, ForClass(NULL)
+		, Classification(INDEX_NONE)
+		, MaxWaitTime(0.0f)
+		, ForPawn(NULL)
+	{}
+};
+
+/**
+ * Server side index of pickups for bots.
+ *
+ * Pickups register themselves by type and report when they are taken and when they come back,
+ * so the registry knows what is available now and what respawns soon. Each type has its own 2D
+ * grid and nearest queries only look at cells around the searcher, independent of how many
+ * pickups the map has.
+ */
+UCLASS(config=Game)
+class UShooterPickupRegistry : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UShooterPickupRegistry(const FObjectInitializer& ObjectInitializer);
+
+	/** add pickup, or update it when it's known already */
+	void Register(AActor* Pickup, EShooterPickupType::Type Type, UClass* ForClass, int32 Classification, float AvailableTime);
+
+	/** remove pickup */
+	void Unregister(AActor* Pickup);
+
+	/** pickup was taken or came back, MAX_FLT while it won't come back */
+	void SetAvailableTime(AActor* Pickup, float AvailableTime);
+
+	/** pickup moved */
+	void UpdateLocation(AActor* Pickup);
+
+	/** closest pickup matching query, Now being the current world time */
+	AActor* FindNearest(const FVector& Location, const FPickupQuery& Query, float Now) const;
+
+	/** registered pickups */
+	int32 GetNumPickups() const;
+
+protected:
+	/** size of a grid cell */
+	UPROPERTY(config)
+	float CellSize;
+
+	/** registered pickups, with holes */
+	TArray<FRegisteredPickup> Entries;
+
+	/** holes in Entries */
+	TArray<int32> FreeEntries;
+
+	/** index into Entries, per pickup's UniqueID */
+	TMap<uint32, int32> EntryIndex;
+
+	/** indices into Entries, per type and cell */
+	TMap<uint64, TArray<int32> > Cells;
+
+	/** grid bounds per type, cells outside never had a pickup */
+	FIntPoint MinCell[EShooterPickupType::MAX];
+	FIntPoint MaxCell[EShooterPickupType::MAX];
+
+	/** grid cell of location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** key into Cells */
+	static uint64 GetCellKey(EShooterPickupType::Type Type, const FIntPoint& Cell);
+
+	/** put entry into its cell */
+	void AddToCell(int32 Index);
+
+	/** take entry out of its cell */
+	void RemoveFromCell(int32 Index);
+
+	/** does entry match query? */
+	bool Matches(const FRegisteredPickup& Entry, const FPickupQuery& Query, float Now) const;
+};
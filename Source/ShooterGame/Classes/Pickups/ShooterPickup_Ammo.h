@@ -13,6 +13,9 @@ class AShooterPickup_Ammo : public AShooterPickup
 
 	bool IsForWeapon(UClass* WeaponClass);
 
+	/** [server] add pickup to the bot pickup registry */
+	virtual void RegisterPickup(class UShooterPickupRegistry* Registry) override;
+
 protected:
 
 	/** how much ammo does it give? */
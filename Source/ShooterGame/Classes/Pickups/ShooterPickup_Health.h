@@ -11,6 +11,9 @@ class AShooterPickup_Health : public AShooterPickup
 	/** check if pawn can use this pickup */
 	virtual bool CanBePickedUp(class AShooterCharacter* TestPawn) const override;
 
+	/** [server] add pickup to the bot pickup registry */
+	virtual void RegisterPickup(class UShooterPickupRegistry* Registry) override;
+
 protected:
 
 	/** how much health does it give? */
@@ -18,5 +18,10 @@ class SHOOTERGAME_API AShooterPowerup : public AActor
 
 	UPROPERTY(EditDefaultsOnly, Category = Powerup)
 		bool bIsOvershield;
+
+	/** [server] add overshield to the bot pickup registry */
+	virtual void BeginPlay() override;
+
+	virtual void Destroyed() override;
 	
 };
@@ -7,7 +7,11 @@
 #include "Shooter_Pickup.generated.h"
 
 /**
- * 
+ * Weapon lying in the world.
+ *
+ * A dropped weapon keeps its AShooterWeapon instance, parked in HeldWeapon until somebody takes
+ * it, so ammo, heat and zoom survive the trip. Pickups without a held weapon hand out a weapon
+ * of Weapon_C from the game mode's pool. Used up pickups go back to the pool as well.
  */
 UCLASS()
 class SHOOTERGAME_API AShooter_Pickup : public AActor
@@ -25,4 +29,43 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = MyStuff)
 		int32 CurrentNumberOfBullets;
+
+	/** seconds a dropped weapon stays in the world, 0 keeps it until taken */
+	UPROPERTY(EditDefaultsOnly, Category = MyStuff)
+		float DroppedLifeSpan;
+
+	/** [server] place pickup of given class, reusing a parked one from the game mode's pool when possible */
+	static AShooter_Pickup* SpawnPickup(UWorld* World, TSubclassOf<AShooter_Pickup> PickupClass, const FVector& Location, const FRotator& Rotation);
+
+	/** [server] drop weapon that just left an inventory as a pickup holding that same weapon */
+	static AShooter_Pickup* DropWeapon(class AShooterWeapon* Weapon, TSubclassOf<AShooter_Pickup> PickupClass, const FVector& Location, const FRotator& Rotation);
+
+	/** [server] hand out this pickup's weapon, or a pooled or new Weapon_C when it doesn't hold one, with Bullets ammo */
+	class AShooterWeapon* TakeWeapon(int32 Bullets);
+
+	/** [server] pickup is used up: give it back to the pool and let its spawner know */
+	void Consume();
+
+	/** [server] reset pickup taken from the pool */
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+
+	/** [server] hide pickup and put it to sleep while it waits in the pool */
+	void ParkInPool();
+
+	/** [server] add pickup to the bot pickup registry */
+	virtual void BeginPlay() override;
+
+	virtual void Destroyed() override;
+
+	/** [server] spawner that placed this pickup */
+	UPROPERTY(Transient)
+		class APickupSpawner* Spawner;
+
+protected:
+	/** [server] parked weapon handed out by TakeWeapon */
+	UPROPERTY(Transient)
+		class AShooterWeapon* HeldWeapon;
+
+	/** [server] tell the pickup registry where this pickup is and whether it's there at all */
+	void UpdateRegistry(bool bAvailable);
 };
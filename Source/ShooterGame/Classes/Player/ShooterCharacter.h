@@ -531,8 +531,8 @@ public:
 	/** Whether or not this character has shields. */
 	UPROPERTY(EditDefaultsOnly, Category = Shields)
 		bool bHasShields;
-	/** The Current amount of shields this character has. */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Replicated, Category = Shields)
+	/** The Current amount of shields this character has. Follows ShieldCurve, updated every tick while it changes. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Shields)
 		float CurrentShieldAmount;
 
 	/** The rate at which the shield recovers */
@@ -547,7 +547,21 @@ public:
 	/** The total amount of time, in seconds, it takes to recover shields if currentshieldamount equals zero */
 	UPROPERTY(EditDefaultsOnly, Category = Shields)
 		float TotalRechargeTime;
+	/** shield amount right now, from ShieldCurve */
+	float GetShieldAmount() const;
+
 protected:
+	/** shields as a segment that is evaluated on demand, only replicated when recharge, decay or damage changes it */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_ShieldCurve)
+		FShieldCurve ShieldCurve;
+
+	UFUNCTION()
+		void OnRep_ShieldCurve();
+
+	/** copy current curve value to CurrentShieldAmount */
+	void UpdateShieldAmount();
+
+	/** [server] start recharging shields to MaxShieldAmount */
 	void RechargeShield();
 
 	void CalculateShieldChargeTime();
@@ -670,17 +684,18 @@ public:
 		void EvaluateAddingAmmoFromPickup(class AShooter_Pickup* P);
 	///////////////////////////////////////////////////////
 	///// OVERSHIELD
+	/** [server] start charging shields to OSPower */
 	void CalculateOvershield();
 
+	/** [server] overshield fully charged, start decaying it */
 	void ChargeOvershield();
 
+	/** [server] overshield decayed to MaxShieldAmount */
 	void DecayOvershield();
 
 	UPROPERTY(EditDefaultsOnly, Category = Overshield)
 		float OvershieldChargeTime;
 
-	float OvershieldChargeRate;
-
 	UPROPERTY(EditDefaultsOnly, Category = Overshield)
 		float OvershieldDecayTime;
 
@@ -738,6 +753,69 @@ public:
 
 	/** [local] start weapon grenade throw */
 	void StartGrenadeThrowNew();
+
+	//////////////////////////////////////////////////////////////////////////
+	// LAG COMPENSATION
+public:
+	/** [server] bounds of this pawn as they were at the given world time, falls back to the current bounds without history */
+	FBox GetHitBoxAtTime(float Time) const;
+
+	/** How far back, in seconds, the server keeps hitbox history for lag compensated hit verification */
+	UPROPERTY(EditDefaultsOnly, Category = LagCompensation)
+		float LagCompensationMaxRewind;
+
+	/** Seconds between hitbox snapshots */
+	UPROPERTY(EditDefaultsOnly, Category = LagCompensation)
+		float LagCompensationSnapshotInterval;
+
+protected:
+	/** [server] record the current hitbox if the snapshot interval has elapsed */
+	void SaveHitboxSnapshot();
+
+	/** [server] recent hitboxes of this pawn */
+	FShooterHitboxHistory HitboxHistory;
+
+	/** world time of the last hitbox snapshot */
+	float LastHitboxSnapshotTime;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Replication tuning
+public:
+	/** scale priority down with distance to the viewer */
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	/** [server] distance scale of our priority for viewer, computed once per viewer and frame and shared with our weapons */
+	float GetNetPriorityScale(const FVector& ViewPos, APlayerController* Viewer);
+
+	/** [server] something happened that remote clients should see soon: replicate at full rate for NetActivityHoldTime */
+	void NotifyNetActivity();
+
+	/** is distance and activity based replication tuning on (Shooter.NetAdaptiveRelevancy) */
+	static bool IsNetAdaptiveRelevancyEnabled();
+
+	/** priority falloff with distance to the viewer */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	FNetPriorityFalloff NetPriorityFalloff;
+
+	/** NetUpdateFrequency while standing still and not fighting, the class default is used while active */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	float NetIdleUpdateFrequency;
+
+	/** seconds to stay at full rate after the last activity */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	float NetActivityHoldTime;
+
+protected:
+	/** last GetNetPriorityScale result */
+	TWeakObjectPtr<APlayerController> NetPriorityViewer;
+	uint64 NetPriorityFrame;
+	float NetPriorityScale;
+
+	/** [server] switch NetUpdateFrequency between active and idle rate */
+	void UpdateNetUpdateFrequency();
+
+	/** world time of the last NotifyNetActivity */
+	float LastNetActivityTime;
 };
 	
 
@@ -27,4 +27,36 @@ class UShooterCheatManager : public UCheatManager
 
 	UFUNCTION(exec)
 	void SpawnBot();
+
+	/** fire projectiles with and without the projectile pool and compare the cost, keeping NumInFlight (default 64) alive at once, needs authority */
+	UFUNCTION(exec)
+	void BenchProjectilePool(int32 NumShots, int32 NumInFlight);
+
+	/** print bot count and line of sight traces per second of the shared bot perception, needs authority */
+	UFUNCTION(exec)
+	void BotPerceptionStats();
+
+	/** time radial damage against 1, 8 and 32 dummy pawns in radius, needs authority */
+	UFUNCTION(exec)
+	void BenchRadialDamage(int32 NumExplosions);
+
+	/** serialize sample packed weapon states, check they read back the same and fit their bit budgets */
+	UFUNCTION(exec)
+	void WeaponNetStateSize();
+
+	/** check the shotgun spread pattern generator against its reference checksum, it must match on every machine */
+	UFUNCTION(exec)
+	void SpreadPatternChecksum();
+
+	/** draw death messages and match timer with and without the HUD text cache and compare the cost */
+	UFUNCTION(exec)
+	void BenchHUDText(int32 NumIterations);
+
+	/** re-import the weapon tuning table from its source CSV and send it to clients, needs authority */
+	UFUNCTION(exec)
+	void ReloadWeaponTuning();
+
+	/** feed the hitbox history a scripted strafing path and check rewinds of 50, 100 and 200 ms against the exact positions */
+	UFUNCTION(exec)
+	void HitboxRewindAccuracy();
 };
@@ -17,6 +17,18 @@ public:
 	UFUNCTION(reliable, client)
 	void ClientGameStarted();
 
+	/** start receiving server's weapon tuning rows, on top of the cooked ones or replacing them */
+	UFUNCTION(reliable, client)
+	void ClientBeginWeaponTuning(bool bFromCooked);
+
+	/** some of server's weapon tuning rows, as CSV with a header line */
+	UFUNCTION(reliable, client)
+	void ClientAddWeaponTuningRows(const FString& RowsCSV);
+
+	/** use the weapon tuning rows received since ClientBeginWeaponTuning */
+	UFUNCTION(reliable, client)
+	void ClientEndWeaponTuning();
+
 	/** Starts the online game using the session name in the PlayerState */
 	UFUNCTION(reliable, client)
 	void ClientStartOnlineGame();
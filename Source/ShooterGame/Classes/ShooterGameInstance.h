@@ -78,6 +78,10 @@ public:
 
 	virtual void Init() override;
 	virtual void Shutdown() override;
+
+	/** weapon stats shared by all weapons, see UShooterWeaponTuning::Get */
+	UPROPERTY(Transient)
+	class UShooterWeaponTuning* WeaponTuning;
 	virtual void StartGameInstance() override;
 
 
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterTraceQueue.generated.h"
+
+/** result of a queued trace, the hit has bBlockingHit unset when nothing was hit */
+DECLARE_DELEGATE_OneParam(FShooterTraceResult, const FHitResult&);
+
+/**
+ * Line traces for gameplay that can wait a frame.
+ *
+ * Requests are handed to the engine's async trace queue, which runs everything queued during a frame
+ * as one batch on worker threads while the game thread carries on. Results are passed to the request
+ * delegates at the start of the next frame. Delegates bound to objects that were destroyed meanwhile
+ * are skipped, callers still have to check whether the result is meaningful for their current state.
+ */
+UCLASS(Transient)
+class UShooterTraceQueue : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UShooterTraceQueue(const FObjectInitializer& ObjectInitializer);
+
+	/** get trace queue of world, creating it on first use */
+	static UShooterTraceQueue* Get(UWorld* World);
+
+	/**
+	 * Queue a line trace for the first blocking hit, OnResult is called with it next frame.
+	 * Without a queue for the world, or with Shooter.AsyncTraces 0, the trace runs right away and OnResult is called before returning.
+	 */
+	static void LineTrace(UWorld* World, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FShooterTraceResult& OnResult);
+
+	/** traces waiting for their result */
+	int32 GetNumPending() const;
+
+protected:
+	/** engine callback, bound once */
+	FTraceDelegate TraceDoneDelegate;
+
+	/** result delegates of queued traces, by request id */
+	TMap<uint32, FShooterTraceResult> PendingResults;
+
+	/** id of the next request, passed to the engine as user data */
+	uint32 NextRequestId;
+
+	/** queue trace with the engine */
+	void QueueLineTrace(UWorld* World, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FShooterTraceResult& OnResult);
+
+	/** engine finished a queued trace */
+	void OnTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+};
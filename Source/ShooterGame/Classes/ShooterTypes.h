@@ -231,4 +231,296 @@ public:
 	{
 		EnsureReplicationByte++;
 	}
-};
\ No newline at end of file
+};
+
+/** server side snapshot of a pawn's hitbox at a point in time */
+struct FSavedHitbox
+{
+	/** world time the snapshot was taken */
+	float Time;
+
+	/** world space bounds of the pawn's components */
+	FBox Box;
+};
+
+/** fixed size ring buffer of hitbox snapshots, used to rewind pawns for lag compensated hit verification */
+struct FShooterHitboxHistory
+{
+	FShooterHitboxHistory()
+		: Head(0)
+		, Count(0)
+	{}
+
+	/** allocate room for Capacity snapshots and drop any existing history */
+	void Init(int32 Capacity)
+	{
+		Samples.Empty(Capacity);
+		Samples.AddZeroed(Capacity);
+		Reset();
+	}
+
+	/** forget all snapshots, keeping the allocation */
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+	}
+
+	/** store a snapshot, overwriting the oldest one when full. Times must be increasing. */
+	void Add(float Time, const FBox& Box)
+	{
+		if (Samples.Num() > 0)
+		{
+			Samples[Head].Time = Time;
+			Samples[Head].Box = Box;
+			Head = (Head + 1) % Samples.Num();
+			Count = FMath::Min(Count + 1, Samples.Num());
+		}
+	}
+
+	/** number of stored snapshots */
+	int32 Num() const
+	{
+		return Count;
+	}
+
+	/** get snapshot by age, 0 being the oldest stored one */
+	const FSavedHitbox& Get(int32 Index) const
+	{
+		return Samples[(Head - Count + Index + Samples.Num()) % Samples.Num()];
+	}
+
+	/**
+	 * Find the hitbox at the given time, interpolating between the two surrounding snapshots.
+	 * Times outside of the stored range are clamped to the oldest/newest snapshot.
+	 *
+	 * @returns false if there is no history
+	 */
+	bool GetBoxAtTime(float Time, FBox& OutBox) const
+	{
+		if (Count == 0)
+		{
+			return false;
+		}
+
+		const FSavedHitbox& Newest = Get(Count - 1);
+		if (Time >= Newest.Time)
+		{
+			OutBox = Newest.Box;
+			return true;
+		}
+
+		// walk back from the newest snapshot, fire times are almost always recent
+		for (int32 Index = Count - 2; Index >= 0; Index--)
+		{
+			const FSavedHitbox& Older = Get(Index);
+			if (Older.Time <= Time)
+			{
+				const FSavedHitbox& Newer = Get(Index + 1);
+				const float Span = Newer.Time - Older.Time;
+				const float Alpha = Span > KINDA_SMALL_NUMBER ? (Time - Older.Time) / Span : 1.0f;
+
+				OutBox = FBox(FMath::Lerp(Older.Box.Min, Newer.Box.Min, Alpha), FMath::Lerp(Older.Box.Max, Newer.Box.Max, Alpha));
+				return true;
+			}
+		}
+
+		OutBox = Get(0).Box;
+		return true;
+	}
+
+private:
+
+	/** snapshot storage */
+	TArray<FSavedHitbox> Samples;
+
+	/** slot the next snapshot is written to */
+	int32 Head;
+
+	/** number of valid snapshots */
+	int32 Count;
+};
+
+/** shield amount as a linear segment: starts at BaseAmount and moves by Rate per second until it reaches TargetAmount */
+USTRUCT()
+struct FShieldCurve
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** amount at StartTime */
+	UPROPERTY()
+	float BaseAmount;
+
+	/** change per second, negative while decaying */
+	UPROPERTY()
+	float Rate;
+
+	/** amount the segment stops at */
+	UPROPERTY()
+	float TargetAmount;
+
+	/** server world time the segment started */
+	UPROPERTY()
+	float StartTime;
+
+	FShieldCurve()
+		: BaseAmount(0.0f)
+		, Rate(0.0f)
+		, TargetAmount(0.0f)
+		, StartTime(0.0f)
+	{}
+
+	/** hold Amount */
+	void SetConstant(float Amount, float Time)
+	{
+		BaseAmount = Amount;
+		TargetAmount = Amount;
+		Rate = 0.0f;
+		StartTime = Time;
+	}
+
+	/** move from Amount to Target over Duration seconds */
+	void SetRamp(float Amount, float Target, float Duration, float Time)
+	{
+		BaseAmount = Amount;
+		TargetAmount = Target;
+		Rate = Duration > 0.0f ? (Target - Amount) / Duration : 0.0f;
+		StartTime = Time;
+
+		if (Rate == 0.0f)
+		{
+			BaseAmount = Target;
+		}
+	}
+
+	/** amount at Time, SegmentStart being StartTime in the caller's clock */
+	float Evaluate(float Time, float SegmentStart) const
+	{
+		const float Amount = BaseAmount + Rate * FMath::Max(Time - SegmentStart, 0.0f);
+		return (Rate >= 0.0f) ? FMath::Min(Amount, TargetAmount) : FMath::Max(Amount, TargetAmount);
+	}
+
+	/** seconds after the segment start until TargetAmount is reached */
+	float GetDuration() const
+	{
+		return (Rate != 0.0f) ? (TargetAmount - BaseAmount) / Rate : 0.0f;
+	}
+};
+
+/** replication priority scale by distance from the viewer: 1 up to FullDistance, falling linearly to MinScale at MinDistance */
+USTRUCT()
+struct FNetPriorityFalloff
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** full priority up to this distance */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	float FullDistance;
+
+	/** distance priority stops falling at */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	float MinDistance;
+
+	/** priority scale at MinDistance and beyond */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	float MinScale;
+
+	FNetPriorityFalloff()
+		: FullDistance(2000.0f)
+		, MinDistance(10000.0f)
+		, MinScale(0.25f)
+	{}
+
+	/** priority scale for squared distance to the viewer */
+	float GetScale(float DistanceSq) const
+	{
+		if (DistanceSq <= FMath::Square(FullDistance))
+		{
+			return 1.0f;
+		}
+		if (DistanceSq >= FMath::Square(MinDistance) || MinDistance <= FullDistance)
+		{
+			return MinScale;
+		}
+
+		const float Alpha = (FMath::Sqrt(DistanceSq) - FullDistance) / (MinDistance - FullDistance);
+		return FMath::Lerp(1.0f, MinScale, Alpha);
+	}
+};
+
+/**
+ * Pellet spread of a shotgun blast, generated from one seed.
+ *
+ * Pellet offsets are integer points in a disc, made with integer hashing and rejection only,
+ * so every machine generates the same pattern bit for bit from the same seed.
+ */
+struct FShooterSpreadPattern
+{
+	/** radius of the offset disc */
+	static const int32 Resolution = 32767;
+
+	/** checksum of the offsets of the first 8 pellets for seeds 0 to 1023, see GetChecksum */
+	static const uint32 ReferenceChecksum = 0xCB5D5BF5u;
+
+	/** offset of a pellet of the blast, inside the disc of radius Resolution */
+	static void GetPelletOffset(int32 Seed, int32 PelletIndex, int32& OutX, int32& OutY)
+	{
+		// about 1 in 5 candidates falls outside the disc, running out of attempts is practically impossible
+		for (uint32 Attempt = 0; Attempt < 32; Attempt++)
+		{
+			const uint32 Bits = Hash((uint32)Seed ^ Hash((uint32)PelletIndex * 32 + Attempt + 1));
+			const int32 X = (int32)(Bits & 0xFFFF) - 32768;
+			const int32 Y = (int32)(Bits >> 16) - 32768;
+			if ((int64)X * X + (int64)Y * Y <= (int64)Resolution * Resolution)
+			{
+				OutX = X;
+				OutY = Y;
+				return;
+			}
+		}
+
+		OutX = 0;
+		OutY = 0;
+	}
+
+	/** direction of a pellet, its offset scaled to a cone of ConeHalfAngle radians around AimDir */
+	static FVector GetPelletDir(const FVector& AimDir, int32 Seed, int32 PelletIndex, float ConeHalfAngle)
+	{
+		int32 X, Y;
+		GetPelletOffset(Seed, PelletIndex, X, Y);
+
+		FVector AxisX, AxisY;
+		AimDir.FindBestAxisVectors(AxisX, AxisY);
+
+		const float Scale = FMath::Tan(ConeHalfAngle) / Resolution;
+		return (AimDir + (AxisX * X + AxisY * Y) * Scale).SafeNormal();
+	}
+
+	/** order dependent checksum of the offsets of NumPellets pellets for seeds 0 to NumSeeds-1 */
+	static uint32 GetChecksum(int32 NumSeeds, int32 NumPellets)
+	{
+		uint32 Checksum = 0;
+		for (int32 Seed = 0; Seed < NumSeeds; Seed++)
+		{
+			for (int32 PelletIndex = 0; PelletIndex < NumPellets; PelletIndex++)
+			{
+				int32 X, Y;
+				GetPelletOffset(Seed, PelletIndex, X, Y);
+				Checksum = Hash(Checksum ^ (uint32)X) ^ (uint32)Y;
+			}
+		}
+		return Checksum;
+	}
+
+private:
+	/** integer finalizer, mixes every input bit into every output bit */
+	static uint32 Hash(uint32 Value)
+	{
+		Value ^= Value >> 16;
+		Value *= 0x85ebca6bu;
+		Value ^= Value >> 13;
+		Value *= 0xc2b2ae35u;
+		Value ^= Value >> 16;
+		return Value;
+	}
+};
@@ -19,6 +19,98 @@ struct FHitData
 	}
 };
 
+/** HUD string, converted to text and measured only when it changes. */
+struct FShooterHUDText
+{
+	/** 
+	 * Set the string, text and size are redone only if it changed.
+	 *
+	 * @param	InString	The string to draw.
+	 * @return	true, if the string changed.
+	 */
+	bool SetString(const FString& InString)
+	{
+		if (bValid && InString == String)
+		{
+			return false;
+		}
+
+		String = InString;
+		Text = FText::FromString(String);
+		bValid = true;
+		bMeasured = false;
+		return true;
+	}
+
+	/** 
+	 * Check if the string was made for another value, for strings formatted from numbers.
+	 *
+	 * @param	Value	The value the string should show.
+	 * @return	true, if the string needs to be set again.
+	 */
+	bool IsStale(int32 Value)
+	{
+		const bool bStale = !bValid || Value != Key;
+		Key = Value;
+		return bStale;
+	}
+
+	/** Unscaled size of the string in font, measured on first use. */
+	const FVector2D& GetSize(UCanvas* Canvas, UFont* InFont)
+	{
+		if (!bMeasured || Font != InFont)
+		{
+			Canvas->StrLen(InFont, String, Size.X, Size.Y);
+			Font = InFont;
+			bMeasured = true;
+		}
+		return Size;
+	}
+
+	/** Text to draw. */
+	const FText& GetText() const
+	{
+		return Text;
+	}
+
+	/** Has a string been set? */
+	bool IsSet() const
+	{
+		return bValid;
+	}
+
+	/** Forget the string, it will be converted and measured again. */
+	void Invalidate()
+	{
+		bValid = false;
+		bMeasured = false;
+	}
+
+	/** Initialise defaults. */
+	FShooterHUDText()
+		: Size(0.0f, 0.0f)
+		, Font(NULL)
+		, Key(0)
+		, bValid(false)
+		, bMeasured(false)
+	{
+	}
+
+private:
+	FString String;
+	FText Text;
+
+	/** Unscaled size in Font. */
+	FVector2D Size;
+	UFont* Font;
+
+	/** Value the string was formatted from. */
+	int32 Key;
+
+	bool bValid;
+	bool bMeasured;
+};
+
 struct FDeathMessage
 {
 	/** Name of player scoring kill. */
@@ -45,6 +137,10 @@ struct FDeathMessage
 	/** What killed the player. */
 	TWeakObjectPtr<class UShooterDamageType> DamageType;
 
+	/** Cached killer and victim text. */
+	FShooterHUDText KillerText;
+	FShooterHUDText VictimText;
+
 	/** Initialise defaults. */
 	FDeathMessage()
 		: bKillerIsOwner(false)
@@ -141,11 +237,21 @@ public:
 
 	/* Is the match over (IE Is the state Won or Lost). */
 	bool IsMatchOver() const;
+
+	/** 
+	 * Time drawing a full death message feed and the match timer on the next frame, with and without the text cache.
+	 *
+	 * @param	NumIterations	How many times to draw them.
+	 */
+	void BenchmarkTextDraw(int32 NumIterations);
 		
 protected:
 	/** Floor for automatic hud scaling. */
 	static const float MinHudScale;
 
+	/** Death messages kept at most. */
+	static const int32 MaxDeathMessages;
+
 	/** Lighter HUD color. */
 	FColor HUDLight;
 
@@ -284,6 +390,17 @@ protected:
 	/** Active death messages. */
 	TArray<FDeathMessage> DeathMessages;
 
+	/** Cached " killed " text of death messages. */
+	FShooterHUDText KilledText;
+
+	/** Cached match timer, warmup and position text. */
+	FShooterHUDText TimerText;
+	FShooterHUDText WarmupText;
+	FShooterHUDText PlaceText;
+
+	/** Draw iterations of a pending text benchmark, 0 if none. */
+	int32 PendingTextBenchmark;
+
 	/** State of match. */
 	EShooterMatchState::Type MatchState;
 
@@ -336,6 +453,12 @@ protected:
 	/** Draw death messages. */
 	void DrawDeathMessages();
 
+	/** Run pending text benchmark, needs the canvas. */
+	void RunTextBenchmark();
+
+	/** Forget all cached text. */
+	void InvalidateTextCache();
+
 	/** Delegate for telling other methods when players have started/stopped talking */
 	FOnPlayerTalkingStateChangedDelegate OnPlayerTalkingStateChangedDelegate;
 	void OnPlayerTalkingStateChanged(TSharedRef<FUniqueNetId> TalkingPlayerId, bool bIsTalking);
@@ -14,9 +14,28 @@ class AShooterProjectile : public AActor
 	/** initial setup */
 	virtual void PostInitializeComponents() override;
 
+	/** scale priority down with distance to the viewer */
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	/** priority falloff with distance to the viewer */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	FNetPriorityFalloff NetPriorityFalloff;
+
 	/** setup velocity */
 	void InitVelocity(FVector& ShootDirection);
 
+	/** [server] spawn projectile, reusing a parked one from the game mode's pool when possible */
+	static AShooterProjectile* SpawnProjectile(AActor* SpawnOwner, TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTM, FVector ShootDirection);
+
+	/** [server] reset projectile taken from the pool, velocity is set by InitVelocity afterwards */
+	void ActivateFromPool(AActor* NewOwner, APawn* NewInstigator, const FTransform& SpawnTM);
+
+	/** [server] hide projectile and put it to sleep while it waits in the pool */
+	void ParkInPool();
+
+	/** [server] give projectile back to the pool, or destroy it when the pool doesn't want it */
+	void ReleaseOrDestroy();
+
 	/** handle hit */
 	UFUNCTION()
 	void OnImpact(const FHitResult& HitResult);
@@ -52,12 +71,29 @@ protected:
 	UFUNCTION()
 	void OnRep_Exploded();
 
+	/** [client] surface trace for the replicated explosion is done */
+	void OnExplosionTrace(const FHitResult& Hit, uint8 ShotRecycleCount);
+
 	/** trigger explosion */
 	void Explode(const FHitResult& Impact);
 
 	/** shutdown projectile and prepare for destruction */
 	void DisableAndDestroy();
 
+	/** setup for a new shot, done on spawn and when reused from the pool */
+	void InitShotState();
+
+	/** reset movement and effects after being reused */
+	void ResetSimulation();
+
+	/** bumped every time the projectile is reused from the pool */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_RecycleCount)
+	uint8 RecycleCount;
+
+	/** [client] projectile was reused */
+	UFUNCTION()
+	void OnRep_RecycleCount();
+
 	/** update velocity on client */
 	virtual void PostNetReceiveVelocity(const FVector& NewVelocity) override;
 
@@ -19,6 +19,19 @@ namespace EWeaponState
 }
 
 
+UENUM()
+namespace EWeaponMagnetism
+{
+	enum Type
+	{
+		/** analytic cone vs capsule test over nearby pawns, then a single line trace */
+		Analytic,
+		/** line trace plus a pawn-only box sweep using TraceExtent, up to three scene queries */
+		Sweep,
+		/** plain line trace, no bullet magnetism */
+		None,
+	};
+}
 
 // CHANGED STUFF IN THIS
 USTRUCT()
@@ -54,6 +67,14 @@ struct FWeaponData
 	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
 	float NoAnimReloadDuration;
 
+	/** how shots are pulled towards nearby pawns */
+	UPROPERTY(EditDefaultsOnly, Category=Magnetism)
+	TEnumAsByte<EWeaponMagnetism::Type> Magnetism;
+
+	/** analytic magnetism: cone half angle (degrees) added on top of TraceExtent, widening with distance */
+	UPROPERTY(EditDefaultsOnly, Category=Magnetism)
+	float MagnetismConeAngle;
+
 	/** defaults */
 	FWeaponData()
 	{
@@ -64,6 +85,8 @@ struct FWeaponData
 		InitialClips = 4;
 		TimeBetweenShots = 0.2f;
 		NoAnimReloadDuration = 1.0f;
+		Magnetism = EWeaponMagnetism::Analytic;
+		MagnetismConeAngle = 0.0f;
 	}
 };
 
@@ -81,6 +104,119 @@ struct FWeaponAnim
 	UAnimMontage* Pawn3P;
 };
 
+/** combat state replicated to everyone but the owner, packed into a few bytes */
+USTRUCT()
+struct FShooterWeaponNetState
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** burst counter, wrapped to 1..255 so it only reads 0 when not firing */
+	UPROPERTY()
+	uint8 BurstCounter;
+
+	/** melee counter, wrapped like BurstCounter */
+	UPROPERTY()
+	uint8 MeleeCounter;
+
+	/** grenade counter, wrapped like BurstCounter */
+	UPROPERTY()
+	uint8 GrenadeCounter;
+
+	/** zoom level, 0 to MaxZoomLevel */
+	UPROPERTY()
+	uint8 ZoomLevel;
+
+	/** charge in half points, see PackCharge */
+	UPROPERTY()
+	uint8 Charge;
+
+	/** is reload animation playing? */
+	UPROPERTY()
+	uint32 bPendingReload : 1;
+
+	/** highest zoom level that fits in the packed flags */
+	static const uint8 MaxZoomLevel = 7;
+
+	FShooterWeaponNetState()
+		: BurstCounter(0)
+		, MeleeCounter(0)
+		, GrenadeCounter(0)
+		, ZoomLevel(0)
+		, Charge(0)
+		, bPendingReload(false)
+	{}
+
+	/** wrap an event counter into a byte, keeping 0 for "stopped" */
+	static uint8 PackCounter(int32 Counter);
+
+	/** quantize charge to half points, rounding down so thresholds are never reached early */
+	static uint8 PackCharge(float Charge);
+
+	static float UnpackCharge(uint8 PackedCharge);
+
+	/** one byte of flags and zoom level, followed only by the counters and charge that aren't 0 */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FShooterWeaponNetState& Other) const
+	{
+		return BurstCounter == Other.BurstCounter && MeleeCounter == Other.MeleeCounter && GrenadeCounter == Other.GrenadeCounter
+			&& ZoomLevel == Other.ZoomLevel && Charge == Other.Charge && bPendingReload == Other.bPendingReload;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterWeaponNetState> : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/** ammo and charge replicated to the owner only */
+USTRUCT()
+struct FShooterWeaponOwnerState
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** current total ammo */
+	UPROPERTY()
+	int32 Ammo;
+
+	/** current ammo - inside clip */
+	UPROPERTY()
+	int32 AmmoInClip;
+
+	/** charge in half points, see FShooterWeaponNetState::PackCharge */
+	UPROPERTY()
+	uint8 Charge;
+
+	FShooterWeaponOwnerState()
+		: Ammo(0)
+		, AmmoInClip(0)
+		, Charge(0)
+	{}
+
+	/** ammo as packed ints, one byte each for counts below 128 */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FShooterWeaponOwnerState& Other) const
+	{
+		return Ammo == Other.Ammo && AmmoInClip == Other.AmmoInClip && Charge == Other.Charge;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterWeaponOwnerState> : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 UCLASS(Abstract, Blueprintable)
 class AShooterWeapon : public AActor
 {
@@ -91,6 +227,16 @@ class AShooterWeapon : public AActor
 
 	virtual void Destroyed() override;
 
+	/** [server] pack replicated state before the net update */
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/** replicate with the priority scale of the pawn holding us */
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	/** NetUpdateFrequency while idle or holstered, the class default is used in every other state */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	float NetIdleUpdateFrequency;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Ammo
 	
@@ -269,11 +415,25 @@ protected:
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_MyPawn)
 	class AShooterCharacter* MyPawn;
 
-	/** weapon data */
+	/** weapon data, used when there is no tuning row. Read it through GetWeaponConfig */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Config)
 	FWeaponData WeaponConfig;
 
+	/** row of the weapon tuning table to take configs from instead of these defaults */
+	UPROPERTY(EditDefaultsOnly, Category=Config)
+	FName TuningRow;
+
+	/** tuning row, looked up again when the table is reloaded. NULL to use the blueprint configs */
+	const struct FShooterWeaponTuningRow* GetTuning() const;
+
+	/** weapon data from the tuning row, or WeaponConfig without one */
+	const FWeaponData& GetWeaponConfig() const;
+
 private:
+	/** resolved tuning row, valid for CachedTuningVersion */
+	mutable const struct FShooterWeaponTuningRow* CachedTuning;
+	mutable int32 CachedTuningVersion;
+
 	/** weapon mesh: 1st person view */
 	UPROPERTY(VisibleDefaultsOnly, Category=Mesh)
 	USkeletalMeshComponent* Mesh1P;
@@ -369,7 +529,6 @@ protected:
 	uint32 bWantsToFire : 1;
 
 	/** is reload animation playing? */
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_Reload)
 	uint32 bPendingReload : 1;
 
 	/** is equip animation playing? */
@@ -391,17 +550,28 @@ protected:
 	float EquipDuration;
 
 	/** current total ammo */
-	UPROPERTY(BlueprintReadWrite, Transient, Replicated)
+	UPROPERTY(BlueprintReadWrite, Transient)
 	int32 CurrentAmmo;
 
 	/** current ammo - inside clip */
-	UPROPERTY(BlueprintReadWrite, Transient, Replicated)
+	UPROPERTY(BlueprintReadWrite, Transient)
 	int32 CurrentAmmoInClip;
 
 	/** burst counter, used for replicating fire events to remote clients */
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_BurstCounter)
 	int32 BurstCounter;
 
+	/** counters, reload, zoom and charge for remote clients, packed in PreReplication */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_NetState)
+	FShooterWeaponNetState NetState;
+
+	/** ammo and charge for the owner, packed in PreReplication */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_OwnerState)
+	FShooterWeaponOwnerState OwnerState;
+
+	/** last received states, to only notify what changed */
+	FShooterWeaponNetState LastNetState;
+	FShooterWeaponOwnerState LastOwnerState;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Input - server side
 
@@ -425,11 +595,24 @@ protected:
 	void OnRep_MyPawn();
 
 	UFUNCTION()
-	void OnRep_BurstCounter();
+	void OnRep_NetState();
 
 	UFUNCTION()
+	void OnRep_OwnerState();
+
+	void OnRep_BurstCounter();
+
 	void OnRep_Reload();
 
+	/** charge carried by the replicated states, for weapons that charge their shots */
+	virtual float GetReplicatedCharge() const;
+
+	/** apply replicated charge */
+	virtual void SetReplicatedCharge(float NewCharge);
+
+	/** [server] clear zoom, heat and other per use state before going back to the pool */
+	virtual void ResetPooledState();
+
 	/** Called in network play to do the cosmetic fx for firing */
 	virtual void SimulateWeaponFire();
 
@@ -503,6 +686,19 @@ protected:
 	/** find hit */
 	FHitResult WeaponTrace(const FVector& TraceFrom, const FVector& TraceTo) const;
 
+	/** find hit, pulling the shot towards pawns with a line trace + pawn sweep */
+	FHitResult WeaponTraceSweep(const FVector& TraceFrom, const FVector& TraceTo, const FCollisionQueryParams& TraceParams) const;
+
+	/**
+	 * Find the pawn the shot should be pulled towards without touching the physics scene.
+	 *
+	 * @param TraceFrom		Shot origin.
+	 * @param TraceTo		Shot end.
+	 * @param OutAimPoint	Point on the pawn's capsule axis to aim at.
+	 * @returns the pawn, or NULL when no pawn is within the magnetism cone or the shot already goes through one
+	 */
+	class AShooterCharacter* FindMagnetismTarget(const FVector& TraceFrom, const FVector& TraceTo, FVector& OutAimPoint) const;
+
 protected:
 	/** Returns Mesh1P subobject **/
 	FORCEINLINE USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
@@ -518,7 +714,7 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = Zooming)
 		float MaxZoomLevel;
 	/** The current zoom level, as long as this isnt equal to MaxZoomLevel you can zoom. Leave this at ZERO in blueprint */
-	UPROPERTY(EditDefaultsOnly, Replicated, Category = Zooming)
+	UPROPERTY(EditDefaultsOnly, Category = Zooming)
 		float CurrentZoomLevel;
 	/** This array holds the FOV that each zoom level will set. The length of the array should be equal to MaxZoomLevel. Example: If you have MaxZoomLevel as 2, this will have two elements (numbered 0 and 1) */
 	UPROPERTY(EditDefaultsOnly, Category = Zooming)
@@ -554,6 +750,15 @@ public:
 	UFUNCTION(Blueprintcallable, Category = Weapon)
 		void AddAmmoFromPickup(int32 Bullets);
 
+	/** [server] put weapon that left the inventory to sleep while it lies in a pickup or waits in the pool */
+	void Park();
+
+	/** [server] wake parked weapon before it goes back into an inventory */
+	void Unpark();
+
+	/** [server] give weapon nobody holds back to the pool, or destroy it when the pool doesn't want it */
+	void ReleaseOrDestroy();
+
 	UPROPERTY(EditDefaultsOnly, Category = Weapon)
 		float HeadshotDamage;
 	
@@ -585,7 +790,7 @@ public:
 
 	// Weapon Trace uses this for box trace
 
-	/** Sets the size of the box trace being done, setting to ZERO in all aspects uses the normal line trace. */
+	/** Sets the size of the box trace being done, setting to ZERO in all aspects uses the normal line trace. Analytic magnetism uses its largest extent as the radius around the shot. */
 	UPROPERTY(EditDefaultsOnly, Category = Weapon)
 		FVector TraceExtent;
 
@@ -615,15 +820,31 @@ public:
 	/** the heat produced with each shot */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Overheat)
 		float HeatIncrease;
-	/** the rate at which heat decreases. NOTE: this sets the timer for the next decrease.
-	1.0 is one second. each time the current heat is decreased by 10 */
+	/** the time it takes for heat to decrease by 10. 1.0 is one second, heat cools down continuously */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Overheat)
 		float CooldownRate;
-	UPROPERTY(VisibleAnywhere, replicated, BlueprintReadOnly, Category = Overheat)
+	/** mirror of the heat component for blueprints and HUD, updated while the weapon cools down */
+	UPROPERTY(VisibleAnywhere, Transient, BlueprintReadOnly, Category = Overheat)
 		float CurrentHeat;
-	UPROPERTY(VisibleAnywhere, replicated, BlueprintReadOnly, Category = Overheat)
+	UPROPERTY(VisibleAnywhere, Transient, BlueprintReadOnly, Category = Overheat)
 		bool bIsOverheated;
 
+	/** [local + server] add heat for a shot */
+	void AddShotHeat(float Amount);
+
+	/** check if weapon is overheated */
+	bool IsOverheated() const;
+
+	/** get current heat */
+	float GetCurrentHeat() const;
+
+protected:
+	/** predicted heat shared by instant and charge weapons */
+	UPROPERTY(VisibleDefaultsOnly, Category = Overheat)
+		class UShooterWeaponHeatComponent* HeatComp;
+
+public:
+
 	//////////////////// PLASMA STUN
 	UPROPERTY(EditDefaultsOnly, category = Stun)
 		bool bHasPlasmaStun;
@@ -674,9 +895,26 @@ public:
 	/** [local + server] handle weapon fire */
 	void HandleMeleeingNew();
 
-	/** [local] weapon specific fire implementation */
+	/** [local] find a target in the melee box and ask the server to hit it */
 	virtual void WeaponMelee();
 
+	/** melee box as placed in front of the pawn's view, the same on the server and the owning client */
+	FTransform GetMeleeBoxTransform() const;
+
+	/** [local] pawn in the melee box closest to its center, NULL if there is none */
+	AShooterCharacter* FindMeleeTarget() const;
+
+	/**
+	 * Test the target's capsule, centered at TargetCenter, against the melee box where GetMeleeBoxTransform places it now.
+	 *
+	 * @param	Target			Pawn to test.
+	 * @param	TargetCenter	Where the target's capsule is centered, may be rewound.
+	 * @param	Tolerance		Distance added to the capsule radius.
+	 * @param	OutImpactPoint	Point of the melee box closest to the capsule.
+	 * @return	true, if the capsule is within Tolerance of the box.
+	 */
+	bool IsInMeleeBox(const AShooterCharacter* Target, const FVector& TargetCenter, float Tolerance, FVector& OutImpactPoint) const;
+
 	/** Called in network play to do the cosmetic fx for melee */
 	virtual void SimulateWeaponMelee();
 
@@ -686,18 +924,24 @@ public:
 	/** is fire animation playing? */
 	uint32 bPlayingMeleeAnim : 1;
 
+	/** [server] validate a melee hit against the target as the client saw it, rewound by ClientRewind (in 4 ms steps, like APlayerState::Ping) */
 	UFUNCTION(reliable, server, WithValidation)
-		void ServerWeaponMelee(AShooterCharacter* TargetChar);
+		void ServerWeaponMelee(AShooterCharacter* TargetChar, uint8 ClientRewind);
+
+	/** [server] time of the last accepted melee hit */
+	float LastMeleeHitTime;
+
+	/** [server] a swing was accepted and hasn't hit anything yet */
+	uint32 bMeleeSwingOpen : 1;
 
 	/** melee counter, used for replicating events events to remote clients */
-	UPROPERTY(Transient, ReplicatedUsing = OnRep_MeleeCounter)
-		int32 MeleeCounter;
+	int32 MeleeCounter;
 
-	UFUNCTION()
-		void OnRep_MeleeCounter();
+	void OnRep_MeleeCounter();
 
 	
 
+	/** melee hit volume, its relative transform is applied to the pawn's view rather than to Mesh1P, see GetMeleeBoxTransform */
 	UPROPERTY(EditDefaultsOnly, Category = MeleeBoxStuff)
 		class UBoxComponent* MeleeBoxNew;
 
@@ -706,15 +950,21 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = Melee)
 		float MeleeShieldDamage;
 
+	/** distance a target's capsule may be outside of the melee box and still be hit, covers interpolation error between client and server */
+	UPROPERTY(EditDefaultsOnly, Category = Melee)
+		float MeleeHitTolerance;
+
+	/** seconds the server rewinds a melee target on top of the attacker's ping, at most */
+	UPROPERTY(EditDefaultsOnly, Category = Melee)
+		float MeleeRewindTolerance;
+
 	UPROPERTY(EditDefaultsOnly, Category = Melee)
 		TSubclassOf<UDamageType> MeleeDamageType;
 
 	/** grenade counter, used for replicating events events to remote clients */
-	UPROPERTY(Transient, ReplicatedUsing = OnRep_GrenadeCounter)
-		int32 GrenadeCounter;
+	int32 GrenadeCounter;
 
-	UFUNCTION()
-		void OnRep_GrenadeCounter();
+	void OnRep_GrenadeCounter();
 
 	/** [local + server] start weapon grenade */
 	virtual void StartGrenadeNew();
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ShooterWeaponHeatComponent.generated.h"
+
+/** compact heat state, only replicated when a shot changes it */
+USTRUCT()
+struct FWeaponHeatState
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** heat right after the last shot, in whole heat points */
+	UPROPERTY()
+	uint8 Heat;
+
+	/** rolling shot counter so identical consecutive states still replicate */
+	UPROPERTY()
+	uint8 ShotCounter;
+
+	/** set when the last shot reached max heat, stays set until fully cooled */
+	UPROPERTY()
+	uint32 bOverheated : 1;
+
+	FWeaponHeatState()
+		: Heat(0)
+		, ShotCounter(0)
+		, bOverheated(false)
+	{}
+};
+
+/**
+ * Heat model shared by overheating weapons.
+ *
+ * Heat is a closed-form function of the heat after the last shot and the time of that shot,
+ * so cooling down needs no timers or RPCs. The owning client and the server both add heat
+ * locally for every shot; the server state replicates once per shot and is only adopted by
+ * the owner when it is hotter than the local prediction.
+ */
+UCLASS()
+class SHOOTERGAME_API UShooterWeaponHeatComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UShooterWeaponHeatComponent(const FObjectInitializer& ObjectInitializer);
+
+	/** heat at which the weapon overheats */
+	static const float MaxHeat;
+
+	/** [local + server] add heat for a shot, overheating when MaxHeat is reached */
+	void AddHeat(float Amount);
+
+	/** set how many seconds it takes to lose 10 heat */
+	void SetCooldownRate(float InCooldownRate);
+
+	/** current heat */
+	float GetHeat() const;
+
+	/** true from the shot that reached MaxHeat until the weapon has fully cooled down */
+	bool IsOverheated() const;
+
+	// Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+	// End UActorComponent Interface
+
+protected:
+	/** server heat state */
+	UPROPERTY(ReplicatedUsing = OnRep_HeatState)
+	FWeaponHeatState HeatState;
+
+	UFUNCTION()
+	void OnRep_HeatState();
+
+	/** heat right after the last shot */
+	float HeatAtLastShot;
+
+	/** local world time of the last shot */
+	float LastShotTime;
+
+	/** heat lost per second */
+	float CoolingPerSecond;
+
+	/** overheat latch, cleared lazily once heat reaches zero */
+	bool bOverheated;
+
+	/** heat at the given local world time */
+	float GetHeatAtTime(float Time) const;
+
+	/** restart the local model from the given heat */
+	void SetHeat(float NewHeat, bool bNewOverheated);
+
+	/** push heat into the owning weapon's blueprint visible properties */
+	void UpdateOwnerWeapon();
+};
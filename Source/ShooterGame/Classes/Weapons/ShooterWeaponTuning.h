@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Weapons/ShooterWeapon.h"
+#include "Weapons/ShooterWeapon_Instant.h"
+#include "Weapons/ShooterWeapon_Projectile.h"
+#include "Weapons/ShooterWeapon_Charge.h"
+#include "ShooterWeaponTuning.generated.h"
+
+/** stats of one weapon, named by the weapon's TuningRow. Only the config matching the weapon class is used */
+USTRUCT()
+struct FShooterWeaponTuningRow : public FTableRowBase
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, Category=Tuning)
+	FWeaponData Weapon;
+
+	UPROPERTY(EditAnywhere, Category=Tuning)
+	FInstantWeaponData Instant;
+
+	UPROPERTY(EditAnywhere, Category=Tuning)
+	FProjectileWeaponData Projectile;
+
+	UPROPERTY(EditAnywhere, Category=Tuning)
+	FChargeWeaponData Charge;
+};
+
+/**
+ * Weapon stats from a data table cooked with the game, so they can be tuned in one place and reloaded.
+ *
+ * The table is loaded once when the game instance starts. Weapons with a TuningRow read their configs
+ * from it, other weapons keep using their blueprint configs. This is for tuning, not memory: every weapon
+ * still carries the blueprint configs as the fallback.
+ *
+ * On a running server the rows can be re-imported from the source CSV, which is staged as a loose file.
+ * Clients already have the cooked rows, so they are only sent the rows that differ from those, a few
+ * rows per RPC.
+ */
+UCLASS(config=Game)
+class UShooterWeaponTuning : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UShooterWeaponTuning(const FObjectInitializer& ObjectInitializer);
+
+	/** tuning of world's game instance, NULL without one */
+	static UShooterWeaponTuning* Get(UWorld* World);
+
+	/** bumped every time the rows are replaced, row pointers from an older version must not be used */
+	static int32 GetVersion();
+
+	/** load cooked table */
+	void LoadTable();
+
+	/** row by name, NULL without table or row. Warns once per version about missing rows */
+	const FShooterWeaponTuningRow* FindRow(FName RowName) const;
+
+	/** [server] re-import rows from SourceCSVPath and send them to clients, returns a line describing the outcome */
+	FString ReloadFromSource(UWorld* World);
+
+	/** [server] replace rows with CSV text, rows are kept if it can't be parsed */
+	bool ApplyCSV(const FString& NewCSV, TArray<FString>& OutProblems);
+
+	/** go back to the cooked rows */
+	void RevertToCooked();
+
+	/** [server] send the rows that differ from the cooked ones to client */
+	void SendToClient(class AShooterPlayerController* PC) const;
+
+	/** [client] start collecting rows from the server, on top of a copy of the cooked rows or from scratch */
+	void BeginServerRows(bool bFromCooked);
+
+	/** [client] add or replace collected rows with CSV text */
+	bool AddServerRows(const FString& RowsCSV, TArray<FString>& OutProblems);
+
+	/** [client] use the rows collected since BeginServerRows */
+	void EndServerRows();
+
+	/** number of rows in use */
+	int32 GetNumRows() const;
+
+protected:
+	/** cooked table asset */
+	UPROPERTY(config)
+	FString TablePath;
+
+	/** CSV the table is imported from, relative to the game directory. Staged loose with packaged builds, see DefaultGame.ini */
+	UPROPERTY(config)
+	FString SourceCSVPath;
+
+	/** table loaded from TablePath */
+	UPROPERTY(Transient)
+	UDataTable* CookedTable;
+
+	/** rows in use, CookedTable unless reloaded */
+	UPROPERTY(Transient)
+	UDataTable* Table;
+
+	/** [client] rows being received from the server */
+	UPROPERTY(Transient)
+	UDataTable* PendingTable;
+
+	/** [server] whether clients keep their cooked rows under ClientRows */
+	bool bClientRowsFromCooked;
+
+	/** [server] rows that differ from the cooked ones, as CSV chunks of at most MaxClientChunkLength */
+	TArray<FString> ClientRows;
+
+	/** rows already warned about in this version */
+	mutable TSet<FName> MissingRows;
+
+	/** empty table of FShooterWeaponTuningRow */
+	UDataTable* CreateTable();
+
+	/** bump Version after Table changed */
+	void OnTableChanged();
+
+	/** [server] rebuild ClientRows from Table */
+	void UpdateClientRows();
+
+	static int32 Version;
+};
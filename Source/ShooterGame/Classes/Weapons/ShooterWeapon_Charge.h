@@ -78,8 +78,15 @@ class SHOOTERGAME_API AShooterWeapon_Charge : public AShooterWeapon
 		AShooterWeapon_Charge(const FObjectInitializer& ObjectInitializer);
 protected:
 	/** Current Charge Amount */
-	UPROPERTY(VisibleAnywhere, replicated, BlueprintReadOnly, Category = Charge)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Charge)
 		float CurrentChargeAmount;
+
+	/** CurrentChargeAmount travels in the packed weapon states */
+	virtual float GetReplicatedCharge() const override;
+	virtual void SetReplicatedCharge(float NewCharge) override;
+
+	/** drop charge too */
+	virtual void ResetPooledState() override;
 private:
 //	UPROPERTY(VisibleAnywhere, replicated, Category = Overheat)
 //		float CurrentHeat;
@@ -102,6 +109,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Config)
 		FChargeWeaponData ChargeConfig;
 
+	/** charge config from the tuning row, or the blueprint config without one */
+	const FChargeWeaponData& GetChargeConfig() const;
+
 	virtual void FireWeapon() override;
 
 	virtual void StartFire() override;
@@ -132,22 +142,6 @@ protected:
 		void ServerFireProjectile(FVector Origin, FVector_NetQuantizeNormal ShootDir);
 
 
-	void Cooldown();
-
-	UFUNCTION(reliable, server, WithValidation)
-		void ServerCooldown();
-
-	UFUNCTION(reliable, server, WithValidation)
-		void IncreaseHeat();
-
-	UFUNCTION(reliable, server, WithValidation)
-		void IncreaseHeatFromChargeShot();
-
-	void Overheat();
-
-	UFUNCTION(reliable, server, WithValidation)
-		void ServerOverheat();
-
 //	UPROPERTY(VisibleAnywhere, replicated, Category = Overheat)
 	//	bool bIsOverheated;
 public:
@@ -17,6 +17,69 @@ struct FInstantHitInfo
 	int32 RandomSeed;
 };
 
+/** shotgun pellet that hit an actor, batched into one server notify per blast */
+USTRUCT()
+struct FInstantPelletHit
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** actor hit by the pellet, NULL for world geometry or a miss */
+	UPROPERTY()
+	AActor* HitActor;
+
+	/** impact point, or trace end for a miss */
+	UPROPERTY()
+	FVector_NetQuantize ImpactPoint;
+
+	/** surface normal at impact */
+	UPROPERTY()
+	FVector_NetQuantizeNormal ImpactNormal;
+
+	/** bone hit, used for headshot detection */
+	UPROPERTY()
+	FName BoneName;
+
+	/** pellet of the blast, its direction is regenerated from the blast's seed */
+	UPROPERTY()
+	uint8 PelletIndex;
+
+	/** whether the pellet had a blocking hit */
+	UPROPERTY()
+	bool bBlockingHit;
+
+	FInstantPelletHit()
+		: HitActor(NULL)
+		, ImpactPoint(ForceInitToZero)
+		, ImpactNormal(ForceInitToZero)
+		, BoneName(NAME_None)
+		, PelletIndex(0)
+		, bBlockingHit(false)
+	{}
+
+	FInstantPelletHit(const FHitResult& Impact, const FVector& EndTrace, int32 InPelletIndex)
+		: HitActor(Impact.GetActor())
+		, ImpactPoint(Impact.bBlockingHit ? Impact.ImpactPoint : EndTrace)
+		, ImpactNormal(Impact.ImpactNormal)
+		, BoneName(Impact.BoneName)
+		, PelletIndex((uint8)InPelletIndex)
+		, bBlockingHit(Impact.bBlockingHit)
+	{}
+
+	/** rebuild the hit result on the server */
+	FHitResult ToHitResult() const
+	{
+		FHitResult Impact(ForceInit);
+		Impact.Actor = HitActor;
+		Impact.Location = ImpactPoint;
+		Impact.ImpactPoint = ImpactPoint;
+		Impact.Normal = ImpactNormal;
+		Impact.ImpactNormal = ImpactNormal;
+		Impact.BoneName = BoneName;
+		Impact.bBlockingHit = bBlockingHit;
+		return Impact;
+	}
+};
+
 // CHANGED STUFF IN THIS
 USTRUCT()
 struct FInstantWeaponData
@@ -56,7 +119,7 @@ struct FInstantWeaponData
 	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
 	TSubclassOf<UDamageType> DamageType;
 
-	/** hit verification: scale for bounding box of hit actor */
+	/** hit verification: scale for bounding box of hit actor. Pawns are checked against their lag compensated bounds, so this can stay tight */
 	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
 	float ClientSideHitLeeway;
 
@@ -64,6 +127,14 @@ struct FInstantWeaponData
 	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
 	float AllowedViewDotHitDir;
 
+	/** hit verification: how far a shotgun pellet's impact may be from its regenerated ray, covers the client firing from the camera instead of the muzzle */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float PelletRayTolerance;
+
+	/** hit verification: how far below the server's spread (degrees) a shotgun blast's reported spread may be */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float SpreadTolerance;
+
 	/** defaults */
 	FInstantWeaponData()
 	{
@@ -76,6 +147,8 @@ struct FInstantWeaponData
 		DamageType = UDamageType::StaticClass();
 		ClientSideHitLeeway = 200.0f;
 		AllowedViewDotHitDir = 0.8f;
+		PelletRayTolerance = 100.0f;
+		SpreadTolerance = 0.5f;
 	}
 };
 
@@ -95,10 +168,13 @@ protected:
 		return EAmmoType::EBullet;
 	}
 
-	/** weapon config */
+	/** weapon config, used when there is no tuning row */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FInstantWeaponData InstantConfig;
 
+	/** weapon config from the tuning row, or the blueprint config without one */
+	const FInstantWeaponData& GetInstantConfig() const;
+
 	/** impact effects */
 	UPROPERTY(EditDefaultsOnly, Category=Effects)
 	TSubclassOf<class AShooterImpactEffect> ImpactTemplate;
@@ -129,9 +205,22 @@ protected:
 	UFUNCTION(unreliable, server, WithValidation)
 	void ServerNotifyMiss(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread);
 
+	/** server notified of a shotgun blast, with the pellets that hit actors */
+	UFUNCTION(reliable, server, WithValidation)
+	void ServerNotifyBlast(FVector_NetQuantizeNormal AimDir, int32 RandomSeed, float ReticleSpread, const TArray<FInstantPelletHit>& Pellets);
+
+	/** [server] check a client reported hit against view direction and target bounds */
+	bool VerifyClientHit(const FHitResult& Impact, const FVector& Origin, float ReticleSpread) const;
+
+	/** [server] estimated world time at which the owning client fired, based on its ping */
+	float GetClientFireTime() const;
+
 	/** process the instant hit and notify the server if necessary */
 	void ProcessInstantHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
+	/** process a shotgun pellet, queueing its server notify into Pellets if it hit an actor */
+	void ProcessPelletHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, int32 PelletIndex, float ReticleSpread, TArray<FInstantPelletHit>& Pellets);
+
 	/** continue processing the instant hit, as if it has been confirmed by the server */
 	void ProcessInstantHit_Confirmed(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
@@ -147,6 +236,9 @@ protected:
 	/** [local + server] update spread on firing */
 	virtual void OnBurstFinished() override;
 
+	/** drop firing spread too */
+	virtual void ResetPooledState() override;
+
 
 	//////////////////////////////////////////////////////////////////////////
 	// Effects replication
@@ -154,9 +246,12 @@ protected:
 	UFUNCTION()
 	void OnRep_HitNotify();
 
-	/** called in network play to do the cosmetic fx  */
+	/** called in network play to do the cosmetic fx, for every pellet of a shotgun blast */
 	void SimulateInstantHit(const FVector& Origin, int32 RandomSeed, float ReticleSpread);
 
+	/** trace and play the fx of a single shot */
+	void SimulateShot(const FVector& Origin, const FVector& ShootDir);
+
 	/** spawn effects for impact */
 	void SpawnImpactEffects(const FHitResult& Impact);
 
@@ -179,14 +274,6 @@ protected:
 //	UPROPERTY(VisibleAnywhere, replicated, Category = Overheat)
 //		float CurrentHeat;
 	
-	UFUNCTION(reliable, server, WithValidation)
-		void IncreaseHeat();
-
-	void Overheat();
-
-	UFUNCTION(reliable, server, WithValidation)
-		void ServerOverheat();
-
 	//UPROPERTY(VisibleAnywhere, replicated, Category = Overheat)
 		//bool bIsOverheated;
 
@@ -194,11 +281,6 @@ protected:
 
 	virtual void OnBurstStarted() override;
 
-	void Cooldown();
-
-	UFUNCTION(reliable, server, WithValidation)
-		void ServerCooldown();
-
 public:
 	bool CanFire() const;
 
@@ -56,10 +56,13 @@ protected:
 		return EAmmoType::ERocket;
 	}
 
-	/** weapon config */
+	/** weapon config, used when there is no tuning row */
 	UPROPERTY(EditDefaultsOnly, Category=Config)
 	FProjectileWeaponData ProjectileConfig;
 
+	/** weapon config from the tuning row, or the blueprint config without one */
+	const FProjectileWeaponData& GetProjectileConfig() const;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Weapon usage
 
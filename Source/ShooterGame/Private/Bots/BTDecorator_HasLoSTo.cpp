@@ -86,7 +86,13 @@ bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(class UBehaviorTreeCompon
 
 		if (bGotTarget== true )
 		{
-			if (LOSTrace(OwnerComp->GetOwner(), EnemyActor, TargetLocation) == true)
+			// actor targets go through the shared line of sight cache, locations still need a trace of their own
+			AShooterAIController* ShooterController = Cast<AShooterAIController>(MyController);
+			if (EnemyActor && ShooterController)
+			{
+				HasLOS = ShooterController->HasWeaponLOSToEnemy(EnemyActor, true);
+			}
+			else if (LOSTrace(OwnerComp->GetOwner(), EnemyActor, TargetLocation) == true)
 			{
 				HasLOS = true;
 			}
@@ -114,6 +120,7 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 			TraceParams.AddIgnoredActor(MyBot);
 			const FVector StartLocation = MyBot->GetActorLocation();
 			FHitResult Hit(ForceInit);
+			SHOOTER_COUNT_SCENE_QUERY();
 			GetWorld()->LineTraceSingle(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
 			if (Hit.bBlockingHit == true)
 			{
@@ -4,6 +4,8 @@
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Bot pickup search"), STAT_ShooterBotFindPickup, STATGROUP_ShooterGame);
+
 UBTTask_FindPickup::UBTTask_FindPickup(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
 {
@@ -11,6 +13,8 @@ UBTTask_FindPickup::UBTTask_FindPickup(const FObjectInitializer& ObjectInitializ
 
 EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent* OwnerComp, uint8* NodeMemory)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotFindPickup);
+
 	UBehaviorTreeComponent* MyComp = OwnerComp;
 	AShooterAIController* MyController = MyComp ? Cast<AShooterAIController>(MyComp->GetOwner()) : NULL;
 	AShooterBot* MyBot = MyController ? Cast<AShooterBot>(MyController->GetPawn()) : NULL;
@@ -25,24 +29,12 @@ EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent* Owne
 		return EBTNodeResult::Failed;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	AShooterPickup_Ammo* BestPickup = NULL;
-	float BestDistSq = MAX_FLT;
-
-	for (int32 i = 0; i < GameMode->LevelPickups.Num(); ++i)
-	{
-		AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(GameMode->LevelPickups[i]);
-		if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(MyBot))
-		{
-			const float DistSq = (AmmoPickup->GetActorLocation() - MyLoc).SizeSquared();
-			if (BestDistSq == -1 || DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPickup = AmmoPickup;
-			}
-		}
-	}
+	// closest active ammo for instant hit weapons that this bot can take
+	FPickupQuery Query(EShooterPickupType::Ammo);
+	Query.ForClass = AShooterWeapon_Instant::StaticClass();
+	Query.ForPawn = MyBot;
 
+	AActor* BestPickup = GameMode->GetPickupRegistry()->FindNearest(MyBot->GetActorLocation(), Query, MyBot->GetWorld()->GetTimeSeconds());
 	if (BestPickup)
 	{
 		MyComp->GetBlackboardComponent()->SetValueAsVector(BlackboardKey.GetSelectedKeyID(), BestPickup->GetActorLocation());
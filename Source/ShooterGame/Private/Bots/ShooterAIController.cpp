@@ -50,30 +50,8 @@ void AShooterAIController::Respawn()
 
 void AShooterAIController::FindClosestEnemy()
 {
-	APawn* MyBot = GetPawn();
-	if (MyBot == NULL)
-	{
-		return;
-	}
-
-	const FVector MyLoc = MyBot->GetActorLocation();
-	float BestDistSq = MAX_FLT;
-	AShooterCharacter* BestPawn = NULL;
-
-	for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
-	{
-		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
-		if (TestPawn && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-			if (DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPawn = TestPawn;
-			}
-		}
-	}
-
+	UShooterBotPerception* Perception = GetBotPerception();
+	AShooterCharacter* BestPawn = Perception ? Perception->FindClosestEnemy(this, NULL, false) : NULL;
 	if (BestPawn)
 	{
 		SetEnemy(BestPawn);
@@ -82,90 +60,27 @@ void AShooterAIController::FindClosestEnemy()
 
 bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy)
 {
-	bool bGotEnemy = false;
-	APawn* MyBot = GetPawn();
-	if (MyBot != NULL)
+	UShooterBotPerception* Perception = GetBotPerception();
+	AShooterCharacter* BestPawn = Perception ? Perception->FindClosestEnemy(this, ExcludeEnemy, true) : NULL;
+	if (BestPawn)
 	{
-		const FVector MyLoc = MyBot->GetActorLocation();
-		float BestDistSq = MAX_FLT;
-		AShooterCharacter* BestPawn = NULL;
-
-		for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
-		{
-			AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
-			if (TestPawn && TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-			{
-				if (HasWeaponLOSToEnemy(TestPawn, true) == true)
-				{
-					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-					if (DistSq < BestDistSq)
-					{
-						BestDistSq = DistSq;
-						BestPawn = TestPawn;
-					}
-				}
-			}
-		}
-		if (BestPawn)
-		{
-			SetEnemy(BestPawn);
-			bGotEnemy = true;
-		}
+		SetEnemy(BestPawn);
+		return true;
 	}
-	return bGotEnemy;
+
+	return false;
 }
 
 bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const
 {
-	static FName LosTag = FName(TEXT("AIWeaponLosTrace"));
-	
-	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
-
-	bool bHasLOS = false;
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(LosTag, true, GetPawn());
-	TraceParams.bTraceAsyncScene = true;
-
-	TraceParams.bReturnPhysicalMaterial = true;	
-	FVector StartLocation = MyBot->GetActorLocation();	
-	StartLocation.Z += GetPawn()->BaseEyeHeight; //look from eyes
-	
-	FHitResult Hit(ForceInit);
-	const FVector EndLocation = InEnemyActor->GetActorLocation();
-	GetWorld()->LineTraceSingle(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-	if (Hit.bBlockingHit == true)
-	{
-		// Theres a blocking hit - check if its our enemy actor
-		AActor* HitActor = Hit.GetActor();
-		if (Hit.GetActor() != NULL)
-		{
-			if (HitActor == InEnemyActor)
-			{
-				bHasLOS = true;
-			}
-			else if (bAnyEnemy == true)
-			{
-				// Its not our actor, maybe its still an enemy ?
-				ACharacter* HitChar = Cast<ACharacter>(HitActor);
-				if (HitChar != NULL)
-				{
-					AShooterPlayerState* HitPlayerState = Cast<AShooterPlayerState>(HitChar->PlayerState);
-					AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(PlayerState);
-					if ((HitPlayerState != NULL) && (MyPlayerState != NULL))
-					{
-						if (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum())
-						{
-							bHasLOS = true;
-						}
-					}
-				}
-			}
-		}
-	}
-
-	
+	UShooterBotPerception* Perception = GetBotPerception();
+	return Perception && Perception->HasLineOfSight(const_cast<AShooterAIController*>(this), InEnemyActor, bAnyEnemy);
+}
 
-	return bHasLOS;
+UShooterBotPerception* AShooterAIController::GetBotPerception() const
+{
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	return MyGame ? MyGame->GetBotPerception() : NULL;
 }
 
 void AShooterAIController::ShootEnemy()
@@ -181,7 +96,7 @@ void AShooterAIController::ShootEnemy()
 	AShooterCharacter* Enemy = GetEnemy();
 	if ( Enemy && ( Enemy->IsAlive() )&& (MyWeapon->GetCurrentAmmo() > 0) && ( MyWeapon->CanFire() == true ) )
 	{
-		if (LineOfSightTo(Enemy, MyBot->GetActorLocation()))
+		if (HasWeaponLOSToEnemy(Enemy, true))
 		{
 			bCanShoot = true;
 		}
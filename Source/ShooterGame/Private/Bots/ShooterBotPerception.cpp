@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Bots/ShooterBotPerception.h"
+
+DECLARE_CYCLE_STAT(TEXT("Bot enemy search"), STAT_ShooterBotEnemySearch, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Bot line of sight"), STAT_ShooterBotLineOfSight, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS traces"), STAT_ShooterBotLOSTraces, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS cache hits"), STAT_ShooterBotLOSCacheHits, STATGROUP_ShooterGame);
+
+UShooterBotPerception::UShooterBotPerception(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	CellSize = 2000.0f;
+	LOSCacheTime = 0.2f;
+
+	MinCell = FIntPoint::ZeroValue;
+	MaxCell = FIntPoint::ZeroValue;
+	LastUpdateFrame = 0;
+
+	StatsWindowStart = 0.0f;
+	NumTraces = 0;
+	NumCacheHits = 0;
+	TracesPerSecond = 0.0f;
+	CacheHitsPerSecond = 0.0f;
+}
+
+FIntPoint UShooterBotPerception::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UShooterBotPerception::UpdateIndex(UWorld* World)
+{
+	if (LastUpdateFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastUpdateFrame = GFrameCounter;
+
+	Pawns.Reset();
+	Cells.Reset();
+	MinCell = FIntPoint(MAX_int32, MAX_int32);
+	MaxCell = FIntPoint(MIN_int32, MIN_int32);
+
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
+		if (TestPawn && TestPawn->IsAlive())
+		{
+			FPerceivedPawn Entry;
+			Entry.Pawn = TestPawn;
+			Entry.Location = TestPawn->GetActorLocation();
+
+			const FIntPoint Cell = GetCell(Entry.Location);
+			Cells.FindOrAdd(Cell).Add(Pawns.Add(Entry));
+
+			MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+			MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+		}
+	}
+
+	// roll trace stats and forget old line of sight results once a second
+	const float Now = World->GetTimeSeconds();
+	const float StatsTime = Now - StatsWindowStart;
+	if (StatsTime >= 1.0f)
+	{
+		TracesPerSecond = NumTraces / StatsTime;
+		CacheHitsPerSecond = NumCacheHits / StatsTime;
+		NumTraces = 0;
+		NumCacheHits = 0;
+		StatsWindowStart = Now;
+
+		for (TMap<uint64, FCachedLineOfSight>::TIterator It(LOSCache); It; ++It)
+		{
+			if (!It.Value().bPending && Now - It.Value().Time > LOSCacheTime)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+AShooterCharacter* UShooterBotPerception::FindClosestEnemy(AController* Observer, AShooterCharacter* ExcludeEnemy, bool bRequireLOS)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotEnemySearch);
+
+	APawn* MyPawn = Observer ? Observer->GetPawn() : NULL;
+	if (MyPawn == NULL)
+	{
+		return NULL;
+	}
+
+	UpdateIndex(MyPawn->GetWorld());
+	if (Pawns.Num() == 0)
+	{
+		return NULL;
+	}
+
+	const FVector MyLoc = MyPawn->GetActorLocation();
+	const FIntPoint MyCell = GetCell(MyLoc);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(MyCell.X - MinCell.X), FMath::Abs(MaxCell.X - MyCell.X)),
+		FMath::Max(FMath::Abs(MyCell.Y - MinCell.Y), FMath::Abs(MaxCell.Y - MyCell.Y)));
+
+	// enemies found so far, sorted by distance once a ring is done
+	TArray<TPair<float, AShooterCharacter*> > Candidates;
+	int32 NextCandidate = 0;
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		for (int32 X = MyCell.X - Ring; X <= MyCell.X + Ring; X++)
+		{
+			// only the border of the ring, the inside was done already
+			const bool bEdgeColumn = (X == MyCell.X - Ring || X == MyCell.X + Ring);
+			const int32 StepY = (bEdgeColumn || Ring == 0) ? 1 : Ring * 2;
+
+			for (int32 Y = MyCell.Y - Ring; Y <= MyCell.Y + Ring; Y += StepY)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+				if (Cell == NULL)
+				{
+					continue;
+				}
+
+				for (int32 i = 0; i < Cell->Num(); i++)
+				{
+					const FPerceivedPawn& Entry = Pawns[(*Cell)[i]];
+					if (Entry.Pawn != ExcludeEnemy && Entry.Pawn->IsEnemyFor(Observer))
+					{
+						Candidates.Add(TPair<float, AShooterCharacter*>((Entry.Location - MyLoc).SizeSquared(), Entry.Pawn));
+					}
+				}
+			}
+		}
+
+		if (NextCandidate == Candidates.Num())
+		{
+			continue;
+		}
+
+		// cells further out are at least this far away, closer candidates can be decided now
+		const float SafeDistSq = (Ring < MaxRing) ? FMath::Square(Ring * CellSize) : MAX_FLT;
+
+		Sort(Candidates.GetData() + NextCandidate, Candidates.Num() - NextCandidate,
+			[](const TPair<float, AShooterCharacter*>& A, const TPair<float, AShooterCharacter*>& B) { return A.Key < B.Key; });
+
+		while (NextCandidate < Candidates.Num() && Candidates[NextCandidate].Key <= SafeDistSq)
+		{
+			AShooterCharacter* TestPawn = Candidates[NextCandidate].Value;
+			NextCandidate++;
+
+			if (!bRequireLOS || HasLineOfSight(Observer, TestPawn, true))
+			{
+				return TestPawn;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+bool UShooterBotPerception::HasLineOfSight(AController* Observer, AActor* Target, bool bAnyEnemy)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotLineOfSight);
+
+	APawn* MyPawn = Observer ? Observer->GetPawn() : NULL;
+	if (MyPawn == NULL || Target == NULL)
+	{
+		return false;
+	}
+
+	UWorld* World = MyPawn->GetWorld();
+	UpdateIndex(World);
+
+	const float Now = World->GetTimeSeconds();
+	const uint64 Key = ((uint64)MyPawn->GetUniqueID() << 32) | (uint64)Target->GetUniqueID();
+
+	FCachedLineOfSight* Cached = LOSCache.Find(Key);
+	if (Cached && (Cached->bPending || Now - Cached->Time <= LOSCacheTime))
+	{
+		NumCacheHits++;
+		INC_DWORD_STAT(STAT_ShooterBotLOSCacheHits);
+		return Cached->bHitTarget || (bAnyEnemy && Cached->bHitEnemy);
+	}
+
+	if (Cached == NULL)
+	{
+		// nothing seen until the first trace is back
+		Cached = &LOSCache.Add(Key, FCachedLineOfSight());
+		Cached->Time = Now;
+		Cached->bHitTarget = false;
+		Cached->bHitEnemy = false;
+	}
+	Cached->bPending = true;
+
+	static FName LosTag = FName(TEXT("AIWeaponLosTrace"));
+
+	FCollisionQueryParams TraceParams(LosTag, true, MyPawn);
+	TraceParams.bTraceAsyncScene = true;
+
+	FVector StartLocation = MyPawn->GetActorLocation();
+	StartLocation.Z += MyPawn->BaseEyeHeight; //look from eyes
+
+	NumTraces++;
+	INC_DWORD_STAT(STAT_ShooterBotLOSTraces);
+	UShooterTraceQueue::LineTrace(World, StartLocation, Target->GetActorLocation(), COLLISION_WEAPON, TraceParams,
+		FShooterTraceResult::CreateUObject(this, &UShooterBotPerception::OnLineOfSightTrace, Key, TWeakObjectPtr<AController>(Observer), TWeakObjectPtr<AActor>(Target)));
+
+	// answered by the last result, the refresh may have completed right away
+	Cached = LOSCache.Find(Key);
+	return Cached && (Cached->bHitTarget || (bAnyEnemy && Cached->bHitEnemy));
+}
+
+void UShooterBotPerception::OnLineOfSightTrace(const FHitResult& Hit, uint64 Key, TWeakObjectPtr<AController> Observer, TWeakObjectPtr<AActor> Target)
+{
+	FCachedLineOfSight* Cached = LOSCache.Find(Key);
+	if (Cached == NULL)
+	{
+		return;
+	}
+
+	UWorld* World = Observer.IsValid() ? Observer->GetWorld() : NULL;
+	Cached->Time = World ? World->GetTimeSeconds() : Cached->Time;
+	Cached->bPending = false;
+	Cached->bHitTarget = false;
+	Cached->bHitEnemy = false;
+
+	AActor* HitActor = Hit.bBlockingHit ? Hit.GetActor() : NULL;
+	if (HitActor == NULL || !Target.IsValid())
+	{
+		return;
+	}
+
+	if (HitActor == Target.Get())
+	{
+		Cached->bHitTarget = true;
+	}
+	else
+	{
+		// not our target, maybe it's still an enemy?
+		ACharacter* HitChar = Cast<ACharacter>(HitActor);
+		AShooterPlayerState* HitPlayerState = HitChar ? Cast<AShooterPlayerState>(HitChar->PlayerState) : NULL;
+		AShooterPlayerState* MyPlayerState = Observer.IsValid() ? Cast<AShooterPlayerState>(Observer->PlayerState) : NULL;
+		if (HitPlayerState && MyPlayerState)
+		{
+			Cached->bHitEnemy = (HitPlayerState->GetTeamNum() != MyPlayerState->GetTeamNum());
+		}
+	}
+}
+
+float UShooterBotPerception::GetTracesPerSecond() const
+{
+	return TracesPerSecond;
+}
+
+float UShooterBotPerception::GetCacheHitsPerSecond() const
+{
+	return CacheHitsPerSecond;
+}
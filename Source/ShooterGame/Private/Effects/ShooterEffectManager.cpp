@@ -0,0 +1,265 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Effects/ShooterEffectManager.h"
+#include "Particles/ParticleSystemComponent.h"
+
+AShooterEffectManager::AShooterEffectManager(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	bReplicates = false;
+
+	MaxEffectsPerFrame = 24;
+	MaxParticleComponents = 48;
+	MaxExplosionLights = 8;
+
+	BudgetFrame = 0;
+	EffectsThisFrame = 0;
+}
+
+AShooterEffectManager* AShooterEffectManager::Get(UWorld* World)
+{
+	if (World == NULL || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return NULL;
+	}
+
+	AShooterGameState* const MyGameState = Cast<AShooterGameState>(World->GameState);
+	if (MyGameState == NULL)
+	{
+		return NULL;
+	}
+
+	if (MyGameState->EffectManager == NULL)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.bNoCollisionFail = true;
+		MyGameState->EffectManager = World->SpawnActor<AShooterEffectManager>(SpawnInfo);
+	}
+
+	return MyGameState->EffectManager;
+}
+
+bool AShooterEffectManager::HasBudget() const
+{
+	return BudgetFrame != GFrameCounter || EffectsThisFrame < MaxEffectsPerFrame;
+}
+
+bool AShooterEffectManager::ConsumeBudget()
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		EffectsThisFrame = 0;
+	}
+
+	if (EffectsThisFrame >= MaxEffectsPerFrame)
+	{
+		return false;
+	}
+
+	EffectsThisFrame++;
+	return true;
+}
+
+const FImpactEffectSet& AShooterEffectManager::GetImpactSet(TSubclassOf<AShooterImpactEffect> Template)
+{
+	FImpactEffectSet* ImpactSet = ImpactSets.Find(*Template);
+	if (ImpactSet == NULL)
+	{
+		const AShooterImpactEffect* ImpactCDO = Template->GetDefaultObject<AShooterImpactEffect>();
+
+		ImpactSet = &ImpactSets.Add(*Template, FImpactEffectSet());
+		ImpactSet->FX.AddZeroed(SurfaceType_Max);
+		ImpactSet->Sounds.AddZeroed(SurfaceType_Max);
+		for (int32 SurfaceType = 0; SurfaceType < SurfaceType_Max; SurfaceType++)
+		{
+			ImpactSet->FX[SurfaceType] = ImpactCDO->GetImpactFX((EPhysicalSurface)SurfaceType);
+			ImpactSet->Sounds[SurfaceType] = ImpactCDO->GetImpactSound((EPhysicalSurface)SurfaceType);
+		}
+		ImpactSet->Decal = ImpactCDO->DefaultDecal;
+	}
+
+	return *ImpactSet;
+}
+
+void AShooterEffectManager::PlayImpact(TSubclassOf<AShooterImpactEffect> Template, const FVector& Location, const FRotator& Rotation, const FHitResult& SurfaceHit)
+{
+	if (Template == NULL || !ConsumeBudget())
+	{
+		return;
+	}
+
+	const FImpactEffectSet& ImpactSet = GetImpactSet(Template);
+	const EPhysicalSurface HitSurfaceType = UPhysicalMaterial::DetermineSurfaceType(SurfaceHit.PhysMaterial.Get());
+
+	if (ImpactSet.FX[HitSurfaceType])
+	{
+		PlayParticles(ImpactSet.FX[HitSurfaceType], Location, Rotation);
+	}
+
+	if (ImpactSet.Sounds[HitSurfaceType])
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, ImpactSet.Sounds[HitSurfaceType], Location);
+	}
+
+	SpawnDecal(ImpactSet.Decal, SurfaceHit);
+}
+
+void AShooterEffectManager::PlayExplosion(TSubclassOf<AShooterExplosionEffect> Template, const FVector& Location, const FRotator& Rotation, const FHitResult& SurfaceHit)
+{
+	if (Template == NULL || !ConsumeBudget())
+	{
+		return;
+	}
+
+	const AShooterExplosionEffect* ExplosionCDO = Template->GetDefaultObject<AShooterExplosionEffect>();
+
+	if (ExplosionCDO->ExplosionFX)
+	{
+		PlayParticles(ExplosionCDO->ExplosionFX, Location, Rotation);
+	}
+
+	if (ExplosionCDO->ExplosionSound)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, ExplosionCDO->ExplosionSound, Location);
+	}
+
+	SpawnDecal(ExplosionCDO->Decal, SurfaceHit);
+
+	const UPointLightComponent* DefLight = ExplosionCDO->GetExplosionLight();
+	UPointLightComponent* Light = (DefLight && DefLight->bVisible && ExplosionCDO->ExplosionLightFadeOut > 0.0f) ? GetFreeLight() : NULL;
+	if (Light)
+	{
+		Light->AttenuationRadius = DefLight->AttenuationRadius;
+		Light->bUseInverseSquaredFalloff = DefLight->bUseInverseSquaredFalloff;
+		Light->MarkRenderStateDirty();
+
+		Light->SetWorldLocation(Location);
+		Light->SetLightColor(DefLight->LightColor);
+		Light->SetIntensity(0.0f);
+		Light->SetVisibility(true);
+
+		FFadingExplosionLight FadingLight;
+		FadingLight.Light = Light;
+		FadingLight.StartTime = GetWorld()->GetTimeSeconds();
+		FadingLight.FadeOut = ExplosionCDO->ExplosionLightFadeOut;
+		FadingLight.Intensity = DefLight->Intensity;
+		FadingLights.Add(FadingLight);
+
+		SetActorTickEnabled(true);
+	}
+}
+
+void AShooterEffectManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (int32 i = FadingLights.Num() - 1; i >= 0; i--)
+	{
+		const FFadingExplosionLight& FadingLight = FadingLights[i];
+		const float TimeRemaining = FMath::Max(0.0f, FadingLight.FadeOut - (Now - FadingLight.StartTime));
+
+		if (TimeRemaining > 0)
+		{
+			const float FadeAlpha = 1.0f - FMath::Square(TimeRemaining / FadingLight.FadeOut);
+			FadingLight.Light->SetIntensity(FadingLight.Intensity * FadeAlpha);
+		}
+		else
+		{
+			FadingLight.Light->SetVisibility(false);
+			FadingLights.RemoveAtSwap(i, 1, false);
+		}
+	}
+
+	if (FadingLights.Num() == 0)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void AShooterEffectManager::PlayParticles(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation)
+{
+	int32 PoolIndex = INDEX_NONE;
+	for (int32 i = 0; i < ParticlePool.Num(); i++)
+	{
+		if (!ParticlePool[i]->IsActive())
+		{
+			PoolIndex = i;
+			break;
+		}
+	}
+
+	if (PoolIndex == INDEX_NONE)
+	{
+		if (ParticlePool.Num() < MaxParticleComponents)
+		{
+			UParticleSystemComponent* NewPSC = ConstructObject<UParticleSystemComponent>(UParticleSystemComponent::StaticClass(), this);
+			NewPSC->bAutoActivate = false;
+			NewPSC->bAutoDestroy = false;
+			NewPSC->RegisterComponent();
+			PoolIndex = ParticlePool.Add(NewPSC);
+			ParticleStartTimes.Add(0.0f);
+		}
+		else
+		{
+			// every component is busy, cut the one started longest ago short
+			PoolIndex = 0;
+			for (int32 i = 1; i < ParticleStartTimes.Num(); i++)
+			{
+				if (ParticleStartTimes[i] < ParticleStartTimes[PoolIndex])
+				{
+					PoolIndex = i;
+				}
+			}
+			ParticlePool[PoolIndex]->KillParticlesForced();
+		}
+	}
+
+	UParticleSystemComponent* PSC = ParticlePool[PoolIndex];
+	ParticleStartTimes[PoolIndex] = GetWorld()->GetTimeSeconds();
+	PSC->SetTemplate(Template);
+	PSC->SetWorldLocationAndRotation(Location, Rotation);
+	PSC->ActivateSystem(true);
+}
+
+UPointLightComponent* AShooterEffectManager::GetFreeLight()
+{
+	for (int32 i = 0; i < LightPool.Num(); i++)
+	{
+		if (!LightPool[i]->bVisible)
+		{
+			return LightPool[i];
+		}
+	}
+
+	if (LightPool.Num() >= MaxExplosionLights)
+	{
+		return NULL;
+	}
+
+	UPointLightComponent* Light = ConstructObject<UPointLightComponent>(UPointLightComponent::StaticClass(), this);
+	Light->CastShadows = false;
+	Light->bVisible = false;
+	Light->RegisterComponent();
+	LightPool.Add(Light);
+
+	return Light;
+}
+
+void AShooterEffectManager::SpawnDecal(const FDecalData& Decal, const FHitResult& SurfaceHit)
+{
+	if (Decal.DecalMaterial)
+	{
+		FRotator RandomDecalRotation = SurfaceHit.ImpactNormal.Rotation();
+		RandomDecalRotation.Roll = FMath::FRandRange(-180.0f, 180.0f);
+
+		UGameplayStatics::SpawnDecalAttached(Decal.DecalMaterial, FVector(Decal.DecalSize, Decal.DecalSize, 1.0f),
+			SurfaceHit.Component.Get(), SurfaceHit.BoneName,
+			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
+			Decal.LifeSpan);
+	}
+}
@@ -18,12 +18,16 @@ AShooterExplosionEffect::AShooterExplosionEffect(const FObjectInitializer& Objec
 	ExplosionLight->bVisible = true;
 
 	ExplosionLightFadeOut = 0.2f;
+	DefaultLightIntensity = 0.0f;
 }
 
 void AShooterExplosionEffect::BeginPlay()
 {
 	Super::BeginPlay();
 
+	UPointLightComponent* DefLight = Cast<UPointLightComponent>(GetClass()->GetDefaultSubobjectByName(ExplosionLightComponentName));
+	DefaultLightIntensity = DefLight ? DefLight->Intensity : ExplosionLight->Intensity;
+
 	if (ExplosionFX)
 	{
 		UGameplayStatics::SpawnEmitterAtLocation(this, ExplosionFX, GetActorLocation(), GetActorRotation());
@@ -56,9 +60,7 @@ void AShooterExplosionEffect::Tick(float DeltaSeconds)
 	if (TimeRemaining > 0)
 	{
 		const float FadeAlpha = 1.0f - FMath::Square(TimeRemaining / ExplosionLightFadeOut);
-
-		UPointLightComponent* DefLight = Cast<UPointLightComponent>(GetClass()->GetDefaultSubobjectByName(ExplosionLightComponentName));
-		ExplosionLight->SetIntensity(DefLight->Intensity * FadeAlpha);
+		ExplosionLight->SetIntensity(DefaultLightIntensity * FadeAlpha);
 	}
 	else
 	{
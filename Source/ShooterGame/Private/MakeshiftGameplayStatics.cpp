@@ -3,6 +3,9 @@
 #include "ShooterGame.h"
 #include "MakeshiftGameplayStatics.h"
 
+DECLARE_CYCLE_STAT(TEXT("Radial damage"), STAT_ShooterRadialDamage, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Radial damage victims"), STAT_ShooterRadialDamageVictims, STATGROUP_ShooterGame);
+
 /*
 UMakeshiftGameplayStatics::UMakeshiftGameplayStatics(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -12,7 +15,38 @@ UMakeshiftGameplayStatics::UMakeshiftGameplayStatics(const FObjectInitializer& O
 
 */
 
-/** @RETURN True if weapon trace from Origin hits component VictimComp.  OutHitResult will contain properties of the hit. */
+/** overlapped component of a radial damage victim */
+struct FRadialDamageOverlap
+{
+	AActor* Actor;
+	UPrimitiveComponent* Component;
+	float DistSq;
+};
+
+/** actor that will take radial damage */
+struct FRadialDamageVictim
+{
+	AActor* Actor;
+	FHitResult Hit;
+};
+
+/** buffers kept between explosions, so a blast doesn't allocate once they have grown */
+struct FRadialDamageScratch
+{
+	TArray<FOverlapResult> Overlaps;
+	TArray<FRadialDamageOverlap> Components;
+	TArray<FRadialDamageVictim> Victims;
+	bool bInUse;
+
+	FRadialDamageScratch() : bInUse(false) {}
+};
+
+static FRadialDamageScratch GRadialDamageScratch;
+
+/** max component centers traced per actor before it counts as occluded */
+static const int32 MaxRadialOcclusionTraces = 3;
+
+/** @RETURN True if weapon trace from Origin hits VictimComp's actor.  OutHitResult will contain properties of the hit. */
 static bool ComponentIsDamageableFrom(UPrimitiveComponent* VictimComp, FVector const& Origin, AActor const* IgnoredActor, const TArray<AActor*>& IgnoreActors, ECollisionChannel TraceChannel, FHitResult& OutHitResult)
 {
 	static FName NAME_ComponentIsVisibleFrom = FName(TEXT("ComponentIsVisibleFrom"));
@@ -30,15 +64,16 @@ static bool ComponentIsDamageableFrom(UPrimitiveComponent* VictimComp, FVector c
 		// tiny nudge so LineTraceSingle doesn't early out with no hits
 		TraceStart.Z += 0.01f;
 	}
+	SHOOTER_COUNT_SCENE_QUERY();
 	bool const bHadBlockingHit = World->LineTraceSingle(OutHitResult, TraceStart, TraceEnd, TraceChannel, LineParams);
 	//::DrawDebugLine(World, TraceStart, TraceEnd, FLinearColor::Red, true);
 
 	// If there was a blocking hit, it will be the last one
 	if (bHadBlockingHit)
 	{
-		if (OutHitResult.Component == VictimComp)
+		if (OutHitResult.GetActor() == VictimComp->GetOwner())
 		{
-			// if blocking hit was the victim component, it is visible
+			// if blocking hit was any part of the victim, it is visible
 			return true;
 		}
 		else
@@ -65,21 +100,29 @@ bool UMakeshiftGameplayStatics::ApplyRadialDamageWithShieldDamage(UObject* World
 
 bool UMakeshiftGameplayStatics::ApplyRadialDamageWithFalloffWithShieldDamage(UObject* WorldContextObject, float BaseDamage, float MinimumDamage, const FVector& Origin, float DamageInnerRadius, float DamageOuterRadius, float DamageFalloff, TSubclassOf<class UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser, AController* InstigatedByController, ECollisionChannel DamagePreventionChannel, float ShieldDamage, float MinimumShieldDamage)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterRadialDamage);
+
 	static FName NAME_ApplyRadialDamage = FName(TEXT("ApplyRadialDamage"));
 	FCollisionQueryParams SphereParams(NAME_ApplyRadialDamage, false, DamageCauser);
 
 	SphereParams.AddIgnoredActors(IgnoreActors);
 
+	// damage can set off another explosion, nested calls get their own buffers
+	FRadialDamageScratch LocalScratch;
+	FRadialDamageScratch& Scratch = GRadialDamageScratch.bInUse ? LocalScratch : GRadialDamageScratch;
+	Scratch.bInUse = true;
+	Scratch.Overlaps.Reset();
+	Scratch.Components.Reset();
+	Scratch.Victims.Reset();
+
 	// query scene to see what we hit
-	TArray<FOverlapResult> Overlaps;
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject);
-	World->OverlapMulti(Overlaps, Origin, FQuat::Identity, FCollisionShape::MakeSphere(DamageOuterRadius), SphereParams, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects));
+	SHOOTER_COUNT_SCENE_QUERY();
+	World->OverlapMulti(Scratch.Overlaps, Origin, FQuat::Identity, FCollisionShape::MakeSphere(DamageOuterRadius), SphereParams, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects));
 
-	// collate into per-actor list of hit components
-	TMap<AActor*, TArray<FHitResult> > OverlapComponentMap;
-	for (int32 Idx = 0; Idx<Overlaps.Num(); ++Idx)
+	for (int32 Idx = 0; Idx<Scratch.Overlaps.Num(); ++Idx)
 	{
-		FOverlapResult const& Overlap = Overlaps[Idx];
+		FOverlapResult const& Overlap = Scratch.Overlaps[Idx];
 		AActor* const OverlapActor = Overlap.GetActor();
 
 		if (OverlapActor &&
@@ -87,13 +130,43 @@ bool UMakeshiftGameplayStatics::ApplyRadialDamageWithFalloffWithShieldDamage(UOb
 			OverlapActor != DamageCauser &&
 			Overlap.Component.IsValid())
 		{
-			FHitResult Hit;
+			FRadialDamageOverlap Entry;
+			Entry.Actor = OverlapActor;
+			Entry.Component = Overlap.Component.Get();
+			Entry.DistSq = (Entry.Component->Bounds.Origin - Origin).SizeSquared();
+			Scratch.Components.Add(Entry);
+		}
+	}
+
+	// group components per actor, closest first
+	Scratch.Components.Sort([](const FRadialDamageOverlap& A, const FRadialDamageOverlap& B)
+	{
+		return (A.Actor != B.Actor) ? (A.Actor < B.Actor) : (A.DistSq < B.DistSq);
+	});
+
+	// one occlusion test per actor: trace its closest components until one can be seen
+	for (int32 Idx = 0; Idx < Scratch.Components.Num(); )
+	{
+		AActor* const OverlapActor = Scratch.Components[Idx].Actor;
+		bool bVisible = (DamagePreventionChannel == ECC_MAX);
+		FHitResult Hit;
+
+		for (int32 NumTraces = 0; !bVisible && NumTraces < MaxRadialOcclusionTraces && Idx + NumTraces < Scratch.Components.Num() && Scratch.Components[Idx + NumTraces].Actor == OverlapActor; NumTraces++)
+		{
+			bVisible = ComponentIsDamageableFrom(Scratch.Components[Idx + NumTraces].Component, Origin, DamageCauser, IgnoreActors, DamagePreventionChannel, Hit);
+		}
 
-			if (DamagePreventionChannel == ECC_MAX || ComponentIsDamageableFrom(Overlap.Component.Get(), Origin, DamageCauser, IgnoreActors, DamagePreventionChannel, Hit))
-			{
-				TArray<FHitResult>& HitList = OverlapComponentMap.FindOrAdd(OverlapActor);
-				HitList.Add(Hit);
-			}
+		if (bVisible)
+		{
+			FRadialDamageVictim Victim;
+			Victim.Actor = OverlapActor;
+			Victim.Hit = Hit;
+			Scratch.Victims.Add(Victim);
+		}
+
+		while (Idx < Scratch.Components.Num() && Scratch.Components[Idx].Actor == OverlapActor)
+		{
+			Idx++;
 		}
 	}
 
@@ -103,15 +176,16 @@ bool UMakeshiftGameplayStatics::ApplyRadialDamageWithFalloffWithShieldDamage(UOb
 	bool bAppliedDamage = false;
 
 	// call damage function on each affected actors
-	for (TMap<AActor*, TArray<FHitResult> >::TIterator It(OverlapComponentMap); It; ++It)
+	FRadialDamageEvent DmgEvent;
+	DmgEvent.DamageTypeClass = ValidDamageTypeClass;
+	DmgEvent.Origin = Origin;
+	DmgEvent.ComponentHits.Add(FHitResult());
+
+	for (int32 Idx = 0; Idx < Scratch.Victims.Num(); Idx++)
 	{
-		AActor* const Victim = It.Key();
-		TArray<FHitResult> const& ComponentHits = It.Value();
+		AActor* const Victim = Scratch.Victims[Idx].Actor;
 
-		FRadialDamageEvent DmgEvent;
-		DmgEvent.DamageTypeClass = ValidDamageTypeClass;
-		DmgEvent.ComponentHits = ComponentHits;
-		DmgEvent.Origin = Origin;
+		DmgEvent.ComponentHits[0] = Scratch.Victims[Idx].Hit;
 		DmgEvent.Params = FRadialDamageParams(BaseDamage, MinimumDamage, DamageInnerRadius, DamageOuterRadius, DamageFalloff);
 		//Victim->TakeDamage(BaseDamage, DmgEvent, InstigatedByController, DamageCauser);
 		
@@ -121,10 +195,13 @@ bool UMakeshiftGameplayStatics::ApplyRadialDamageWithFalloffWithShieldDamage(UOb
 		}
 
 		Victim->TakeDamage(DmgEvent.Params.BaseDamage, DmgEvent, InstigatedByController, DamageCauser);
+		INC_DWORD_STAT(STAT_ShooterRadialDamageVictims);
 
 		bAppliedDamage = true;
 	}
 
+	Scratch.bInUse = false;
+
 	return bAppliedDamage;
 }
 
@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "ShooterSpectatorPawn.h"
 
+DECLARE_CYCLE_STAT(TEXT("Spawn selection"), STAT_ShooterChoosePlayerStart, STATGROUP_ShooterGame);
+
 AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnOb(TEXT("/Game/Blueprints/Pawns/PlayerPawn"));
@@ -23,6 +25,9 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 	bNeedsBotCreation = true;
 	bUseSeamlessTravel = true;	
 	DamageSelfScale = 1.0;
+	bUseProjectilePool = true;
+	MaxPooledProjectiles = 32;
+	MaxPooledPickups = 8;
 }
 
 FString AShooterGameMode::GetBotsCountOptionName()
@@ -36,6 +41,12 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	SetAllowBots(BotsCountOptionValue > 0 ? true : false, BotsCountOptionValue);	
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	// a soak run ends after its frame count, not on the match timer
+	if (AShooterSoakBenchmark::StartFromOptions(GetWorld(), Options))
+	{
+		RoundTime = 0;
+	}
+
 	const UGameInstance* GI = GetGameInstance();
 	if (GI && Cast<UShooterGameInstance>(GI)->GetIsOnline())
 	{
@@ -70,6 +81,11 @@ void AShooterGameMode::DefaultTimer()
 		return;
 	}
 
+	if (IsMatchInProgress())
+	{
+		GetSpawnScoring()->Refresh();
+	}
+
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
 	if (MyGameState && MyGameState->RemainingTime > 0 && !MyGameState->bTimerPaused)
 	{
@@ -257,6 +273,13 @@ void AShooterGameMode::PostLogin(APlayerController* NewPlayer)
 		NewPC->ClientSetSpectatorCamera(NewPC->GetSpawnLocation(), NewPC->GetControlRotation());
 	}
 
+	// weapon stats may have been reloaded since the server started
+	UShooterWeaponTuning* Tuning = UShooterWeaponTuning::Get(GetWorld());
+	if (NewPC && Tuning && !NewPC->IsLocalController())
+	{
+		Tuning->SendToClient(NewPC);
+	}
+
 	// notify new player if match is already in progress
 	if (NewPC && IsMatchInProgress())
 	{
@@ -281,6 +304,11 @@ void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, AP
 		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
 		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
 	}
+
+	if (KilledPawn)
+	{
+		GetSpawnScoring()->AddDeath(KilledPawn->GetActorLocation());
+	}
 }
 
 float AShooterGameMode::ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const
@@ -339,45 +367,63 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController(AController* InContro
 
 AActor* AShooterGameMode::ChoosePlayerStart(AController* Player)
 {
-	TArray<APlayerStart*> PreferredSpawns;
-	TArray<APlayerStart*> FallbackSpawns;
+	SCOPE_CYCLE_COUNTER(STAT_ShooterChoosePlayerStart);
+
+	UShooterSpawnScoring* Scoring = GetSpawnScoring();
+	Scoring->Refresh();
 
-	APlayerStart* BestStart = NULL;
-	for (int32 i = 0; i < PlayerStarts.Num(); i++)
+	// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
+	APlayerStart* BestStart = Scoring->GetPlayInEditorStart();
+	if (BestStart)
 	{
-		APlayerStart* TestSpawn = PlayerStarts[i];
-		if (Cast<APlayerStartPIE>( TestSpawn ) != NULL )
+		return BestStart;
+	}
+
+	const TArray<FScoredPlayerStart>& Starts = Scoring->GetStarts();
+	const int32 TeamSlot = Scoring->GetTeamSlot(Player);
+
+	TArray<TPair<float, APlayerStart*> > Candidates;
+	for (int32 i = 0; i < Starts.Num(); i++)
+	{
+		APlayerStart* TestSpawn = Starts[i].Start;
+		if (TestSpawn && IsSpawnpointAllowed(TestSpawn, Player))
+		{
+			Candidates.Add(TPair<float, APlayerStart*>(Starts[i].Scores[TeamSlot], TestSpawn));
+		}
+	}
+
+	if (Candidates.Num() > 0)
+	{
+		Sort(Candidates.GetData(), Candidates.Num(), [](const TPair<float, APlayerStart*>& A, const TPair<float, APlayerStart*>& B) { return A.Key > B.Key; });
+
+		// pick at random among the leaders, so spawns don't become predictable
+		int32 NumLeaders = 1;
+		while (NumLeaders < Candidates.Num() && Candidates[0].Key - Candidates[NumLeaders].Key <= Scoring->RandomScoreRange)
 		{
-			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			BestStart = TestSpawn;
-			break;
+			NumLeaders++;
 		}
-		else if (TestSpawn != NULL)
+
+		const int32 Picked = FMath::RandHelper(NumLeaders);
+		if (IsSpawnpointPreferred(Candidates[Picked].Value, Player))
+		{
+			BestStart = Candidates[Picked].Value;
+		}
+		else
 		{
-			if (IsSpawnpointAllowed(TestSpawn, Player))
+			// occupied, take the best free one
+			for (int32 i = 0; i < Candidates.Num(); i++)
 			{
-				if (IsSpawnpointPreferred(TestSpawn, Player))
+				if (i != Picked && IsSpawnpointPreferred(Candidates[i].Value, Player))
 				{
-					PreferredSpawns.Add(TestSpawn);
-				}
-				else
-				{
-					FallbackSpawns.Add(TestSpawn);
+					BestStart = Candidates[i].Value;
+					break;
 				}
 			}
 		}
-	}
 
-	
-	if (BestStart == NULL)
-	{
-		if (PreferredSpawns.Num() > 0)
-		{
-			BestStart = PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())];
-		}
-		else if (FallbackSpawns.Num() > 0)
+		if (BestStart == NULL)
 		{
-			BestStart = FallbackSpawns[FMath::RandHelper(FallbackSpawns.Num())];
+			BestStart = Candidates[0].Value;
 		}
 	}
 
@@ -406,7 +452,14 @@ bool AShooterGameMode::IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController
 
 bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AController* Player) const
 {
+	// players are spawned before they get a pawn, check against the one they'll get
 	ACharacter* MyPawn = Player ? Cast<ACharacter>(Player->GetPawn()) : NULL;
+	if (MyPawn == NULL)
+	{
+		UClass* PawnClass = const_cast<AShooterGameMode*>(this)->GetDefaultPawnClassForController(Player);
+		MyPawn = PawnClass ? Cast<ACharacter>(PawnClass->GetDefaultObject()) : NULL;
+	}
+
 	if (MyPawn)
 	{
 		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
@@ -514,3 +567,167 @@ void AShooterGameMode::RestartGame()
 	Super::RestartGame();
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Projectile pool
+
+AShooterProjectile* AShooterGameMode::AcquirePooledProjectile(TSubclassOf<AShooterProjectile> ProjectileClass)
+{
+	TArray<TWeakObjectPtr<AShooterProjectile> >* Parked = ProjectilePool.Find(*ProjectileClass);
+	while (Parked && Parked->Num() > 0)
+	{
+		AShooterProjectile* Projectile = Parked->Pop(false).Get();
+		if (Projectile && !Projectile->IsPendingKill())
+		{
+			return Projectile;
+		}
+	}
+
+	return NULL;
+}
+
+bool AShooterGameMode::ReleasePooledProjectile(AShooterProjectile* Projectile)
+{
+	if (!bUseProjectilePool || Projectile == NULL || Projectile->IsPendingKill())
+	{
+		return false;
+	}
+
+	TArray<TWeakObjectPtr<AShooterProjectile> >& Parked = ProjectilePool.FindOrAdd(Projectile->GetClass());
+	if (Parked.Num() >= MaxPooledProjectiles)
+	{
+		return false;
+	}
+
+	Projectile->ParkInPool();
+	Parked.Add(Projectile);
+	return true;
+}
+
+void AShooterGameMode::SetUseProjectilePool(bool bEnable)
+{
+	bUseProjectilePool = bEnable;
+
+	if (!bUseProjectilePool)
+	{
+		for (TMap<UClass*, TArray<TWeakObjectPtr<AShooterProjectile> > >::TIterator It(ProjectilePool); It; ++It)
+		{
+			for (int32 i = 0; i < It.Value().Num(); i++)
+			{
+				AShooterProjectile* Projectile = It.Value()[i].Get();
+				if (Projectile)
+				{
+					Projectile->Destroy();
+				}
+			}
+		}
+
+		ProjectilePool.Empty();
+	}
+}
+
+bool AShooterGameMode::IsUsingProjectilePool() const
+{
+	return bUseProjectilePool;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Weapon and pickup pool
+
+AActor* AShooterGameMode::AcquirePooledPickupActor(UClass* ActorClass)
+{
+	TArray<TWeakObjectPtr<AActor> >* Parked = PickupPool.Find(ActorClass);
+	while (Parked && Parked->Num() > 0)
+	{
+		AActor* Actor = Parked->Pop(false).Get();
+		if (Actor && !Actor->IsPendingKill())
+		{
+			return Actor;
+		}
+	}
+
+	return NULL;
+}
+
+bool AShooterGameMode::CanPoolPickupActor(AActor* Actor) const
+{
+	if (Actor == NULL || Actor->IsPendingKill() || MaxPooledPickups <= 0)
+	{
+		return false;
+	}
+
+	const TArray<TWeakObjectPtr<AActor> >* Parked = PickupPool.Find(Actor->GetClass());
+	return Parked == NULL || Parked->Num() < MaxPooledPickups;
+}
+
+AShooterWeapon* AShooterGameMode::AcquirePooledWeapon(TSubclassOf<AShooterWeapon> WeaponClass)
+{
+	return Cast<AShooterWeapon>(AcquirePooledPickupActor(*WeaponClass));
+}
+
+bool AShooterGameMode::ReleasePooledWeapon(AShooterWeapon* Weapon)
+{
+	if (!CanPoolPickupActor(Weapon))
+	{
+		return false;
+	}
+
+	Weapon->Park();
+	PickupPool.FindOrAdd(Weapon->GetClass()).Add(Weapon);
+	return true;
+}
+
+AShooter_Pickup* AShooterGameMode::AcquirePooledPickup(TSubclassOf<AShooter_Pickup> PickupClass)
+{
+	return Cast<AShooter_Pickup>(AcquirePooledPickupActor(*PickupClass));
+}
+
+bool AShooterGameMode::ReleasePooledPickup(AShooter_Pickup* Pickup)
+{
+	if (!CanPoolPickupActor(Pickup))
+	{
+		return false;
+	}
+
+	Pickup->ParkInPool();
+	PickupPool.FindOrAdd(Pickup->GetClass()).Add(Pickup);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Bot perception
+
+UShooterBotPerception* AShooterGameMode::GetBotPerception()
+{
+	if (BotPerception == NULL)
+	{
+		BotPerception = ConstructObject<UShooterBotPerception>(UShooterBotPerception::StaticClass(), this);
+	}
+
+	return BotPerception;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Pickup registry
+
+UShooterPickupRegistry* AShooterGameMode::GetPickupRegistry()
+{
+	if (PickupRegistry == NULL)
+	{
+		PickupRegistry = ConstructObject<UShooterPickupRegistry>(UShooterPickupRegistry::StaticClass(), this);
+	}
+
+	return PickupRegistry;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Spawn scoring
+
+UShooterSpawnScoring* AShooterGameMode::GetSpawnScoring()
+{
+	if (SpawnScoring == NULL)
+	{
+		SpawnScoring = ConstructObject<UShooterSpawnScoring>(UShooterSpawnScoring::StaticClass(), this);
+	}
+
+	return SpawnScoring;
+}
@@ -2,11 +2,19 @@
 
 #include "ShooterGame.h"
 
+DECLARE_CYCLE_STAT(TEXT("Scoreboard ranking"), STAT_ShooterUpdateRanking, STATGROUP_ShooterGame);
+
 AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	ReplicatedWorldTimeSeconds = 0.0f;
+	ServerWorldTimeSecondsDelta = 0.0f;
+	EffectManager = NULL;
+	TraceQueue = NULL;
+	bRankingDirty = true;
+	RankingVersion = 1;
 }
 
 void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -17,38 +25,120 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME( AShooterGameState, RemainingTime );
 	DOREPLIFETIME( AShooterGameState, bTimerPaused );
 	DOREPLIFETIME( AShooterGameState, TeamScores );
+	DOREPLIFETIME( AShooterGameState, ReplicatedWorldTimeSeconds );
+}
+
+void AShooterGameState::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	if (Role == ROLE_Authority)
+	{
+		// clocks drift slowly, an update every few seconds is plenty
+		UpdateServerTimeSeconds();
+		GetWorldTimerManager().SetTimer(this, &AShooterGameState::UpdateServerTimeSeconds, 5.0f, true);
+	}
+}
+
+void AShooterGameState::UpdateServerTimeSeconds()
+{
+	ReplicatedWorldTimeSeconds = GetWorld()->GetTimeSeconds();
+}
+
+void AShooterGameState::OnRep_ReplicatedWorldTimeSeconds()
+{
+	// the value is about half a round trip old when it arrives
+	APlayerController* const LocalPC = GEngine->GetFirstLocalPlayerController(GetWorld());
+	const float HalfPing = (LocalPC && LocalPC->PlayerState) ? LocalPC->PlayerState->ExactPing * 0.0005f : 0.0f;
+	ServerWorldTimeSecondsDelta = ReplicatedWorldTimeSeconds + HalfPing - GetWorld()->GetTimeSeconds();
+}
+
+float AShooterGameState::GetServerWorldTimeSeconds() const
+{
+	return GetWorld()->GetTimeSeconds() + ServerWorldTimeSecondsDelta;
 }
 
 void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
 {
 	OutRankedMap.Empty();
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+	if (bRankingDirty)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		UpdateRanking();
+	}
+
+	if (RankedTeams.IsValidIndex(TeamIndex))
+	{
+		const TArray<TWeakObjectPtr<AShooterPlayerState> >& TeamRanking = RankedTeams[TeamIndex];
+		for (int32 Rank = 0; Rank < TeamRanking.Num(); Rank++)
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->Score), CurPlayerState);
+			OutRankedMap.Add(Rank, TeamRanking[Rank]);
 		}
 	}
+}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+void AShooterGameState::UpdateRanking() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterUpdateRanking);
 
-	//now, add them back to the ranked map
-	OutRankedMap.Empty();
+	bRankingDirty = false;
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	for (int32 i = 0; i < RankedTeams.Num(); i++)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		RankedTeams[i].Reset();
+	}
+
+	for (int32 i = 0; i < PlayerArray.Num(); ++i)
+	{
+		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
+		const int32 TeamIndex = CurPlayerState ? CurPlayerState->GetTeamNum() : INDEX_NONE;
+		if (TeamIndex >= 0)
+		{
+			if (TeamIndex >= RankedTeams.Num())
+			{
+				RankedTeams.AddZeroed(TeamIndex - RankedTeams.Num() + 1);
+			}
+
+			RankedTeams[TeamIndex].Add(CurPlayerState);
+		}
+	}
+
+	for (int32 i = 0; i < RankedTeams.Num(); i++)
+	{
+		// ties keep join order, so equal scores don't swap places between updates
+		RankedTeams[i].Sort([](const TWeakObjectPtr<AShooterPlayerState>& A, const TWeakObjectPtr<AShooterPlayerState>& B)
+		{
+			const int32 ScoreA = FMath::TruncToInt(A->Score);
+			const int32 ScoreB = FMath::TruncToInt(B->Score);
+			return (ScoreA != ScoreB) ? (ScoreA > ScoreB) : (A->PlayerId < B->PlayerId);
+		});
 	}
-	
 }
 
+void AShooterGameState::MarkRankingDirty()
+{
+	bRankingDirty = true;
+	RankingVersion++;
+}
+
+uint32 AShooterGameState::GetRankingVersion() const
+{
+	return RankingVersion;
+}
+
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	MarkRankingDirty();
+}
+
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	Super::RemovePlayerState(PlayerState);
+
+	MarkRankingDirty();
+}
 
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
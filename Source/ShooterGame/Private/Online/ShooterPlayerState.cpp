@@ -23,6 +23,8 @@ void AShooterPlayerState::Reset()
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+
+	NotifyRankingChanged();
 }
 
 void AShooterPlayerState::UnregisterPlayerWithSession()
@@ -45,11 +47,20 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	NotifyRankingChanged();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	NotifyRankingChanged();
+}
+
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+
+	NotifyRankingChanged();
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
@@ -152,6 +163,18 @@ void AShooterPlayerState::ScorePoints(int32 Points)
 	}
 
 	Score += Points;
+
+	NotifyRankingChanged();
+}
+
+void AShooterPlayerState::NotifyRankingChanged()
+{
+	UWorld* World = GetWorld();
+	AShooterGameState* const MyGameState = World ? Cast<AShooterGameState>(World->GameState) : NULL;
+	if (MyGameState)
+	{
+		MyGameState->MarkRankingDirty();
+	}
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
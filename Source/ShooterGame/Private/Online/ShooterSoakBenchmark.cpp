@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Online/ShooterSoakBenchmark.h"
+
+AShooterSoakBenchmark::AShooterSoakBenchmark(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+
+	NumFrames = 0;
+	Seed = 0;
+	NumBots = 0;
+	bNetAdaptiveRelevancy = false;
+	LastFrameTime = 0.0;
+	LastOutBunches = 0;
+	LastOutBytes = 0;
+	bFinished = false;
+}
+
+AShooterSoakBenchmark* AShooterSoakBenchmark::StartFromOptions(UWorld* World, const FString& Options)
+{
+	const int32 SoakFrames = AGameMode::GetIntOption(Options, TEXT("SoakFrames"), 0);
+	if (SoakFrames <= 0)
+	{
+		return NULL;
+	}
+
+	const int32 SoakSeed = AGameMode::GetIntOption(Options, TEXT("SoakSeed"), 1);
+	const int32 SoakFPS = FMath::Max(AGameMode::GetIntOption(Options, TEXT("SoakFPS"), 30), 1);
+
+	FMath::RandInit(SoakSeed);
+	FMath::SRandInit(SoakSeed);
+
+	// same simulated time per frame no matter how long the frame took
+	FApp::SetBenchmarking(true);
+	FApp::SetFixedDeltaTime(1.0 / SoakFPS);
+
+	IConsoleVariable* NetAdaptiveVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Shooter.NetAdaptiveRelevancy"));
+	if (NetAdaptiveVar && AGameMode::HasOption(Options, TEXT("SoakNetAdaptive")))
+	{
+		NetAdaptiveVar->Set(AGameMode::GetIntOption(Options, TEXT("SoakNetAdaptive"), 1));
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.bNoCollisionFail = true;
+	AShooterSoakBenchmark* Benchmark = World->SpawnActor<AShooterSoakBenchmark>(SpawnInfo);
+	if (Benchmark)
+	{
+		Benchmark->NumFrames = SoakFrames;
+		Benchmark->Seed = SoakSeed;
+		Benchmark->NumBots = AGameMode::GetIntOption(Options, AShooterGameMode::GetBotsCountOptionName(), 0);
+		Benchmark->bNetAdaptiveRelevancy = AShooterCharacter::IsNetAdaptiveRelevancyEnabled();
+		Benchmark->Samples.Reserve(SoakFrames);
+
+		UE_LOG(LogShooter, Log, TEXT("Soak: %d frames, %d bots, seed %d, %d fps, adaptive relevancy %d"), SoakFrames, Benchmark->NumBots, SoakSeed, SoakFPS, Benchmark->bNetAdaptiveRelevancy ? 1 : 0);
+	}
+
+	return Benchmark;
+}
+
+void AShooterSoakBenchmark::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	UWorld* World = GetWorld();
+	AGameMode* GameMode = World->GetAuthGameMode();
+	UNetDriver* NetDriver = World->GetNetDriver();
+
+	const double Now = FPlatformTime::Seconds();
+	const uint32 OutBunches = NetDriver ? NetDriver->OutBunches : 0;
+	const uint32 OutBytes = NetDriver ? NetDriver->OutBytes : 0;
+
+	// nobody is going to join, don't wait for players
+	if (GameMode && GameMode->GetMatchState() == MatchState::WaitingToStart)
+	{
+		GameMode->StartMatch();
+	}
+
+	// match ended before all frames were sampled, report what there is
+	if (GameMode && GameMode->HasMatchEnded())
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Soak: match ended after %d of %d frames"), Samples.Num(), NumFrames);
+		Finish();
+		return;
+	}
+
+	if (GameMode && GameMode->IsMatchInProgress() && LastFrameTime > 0.0)
+	{
+		FSoakFrameSample Sample;
+		Sample.FrameMs = (Now - LastFrameTime) * 1000.0;
+		Sample.SceneQueries = GShooterSceneQueries;
+		// net driver resets its counters every stat period
+		Sample.OutBunches = (OutBunches >= LastOutBunches) ? OutBunches - LastOutBunches : OutBunches;
+		Sample.OutBytes = (OutBytes >= LastOutBytes) ? OutBytes - LastOutBytes : OutBytes;
+		Sample.NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+		Samples.Add(Sample);
+
+		if (Samples.Num() >= NumFrames)
+		{
+			Finish();
+		}
+	}
+
+	GShooterSceneQueries = 0;
+	LastFrameTime = Now;
+	LastOutBunches = OutBunches;
+	LastOutBytes = OutBytes;
+}
+
+void AShooterSoakBenchmark::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (!bFinished)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Soak: run ended after %d of %d frames"), Samples.Num(), NumFrames);
+		Finish();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterSoakBenchmark::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	bFinished = true;
+	SetActorTickEnabled(false);
+
+	TArray<float> SortedMs;
+	double TotalMs = 0.0;
+	int64 TotalQueries = 0;
+	int64 TotalBunches = 0;
+	int64 TotalBytes = 0;
+	int64 TotalConnections = 0;
+	double BytesPerConnection = 0.0;
+
+	FString FramesJson;
+	for (int32 i = 0; i < Samples.Num(); i++)
+	{
+		const FSoakFrameSample& Sample = Samples[i];
+		SortedMs.Add(Sample.FrameMs);
+		TotalMs += Sample.FrameMs;
+		TotalQueries += Sample.SceneQueries;
+		TotalBunches += Sample.OutBunches;
+		TotalBytes += Sample.OutBytes;
+		TotalConnections += Sample.NumConnections;
+		if (Sample.NumConnections > 0)
+		{
+			BytesPerConnection += (double)Sample.OutBytes / Sample.NumConnections;
+		}
+
+		FramesJson += FString::Printf(TEXT("%s\n\t\t[%.3f, %d, %d, %d, %d]"), i > 0 ? TEXT(",") : TEXT(""),
+			Sample.FrameMs, Sample.SceneQueries, Sample.OutBunches, Sample.OutBytes, Sample.NumConnections);
+	}
+	SortedMs.Sort();
+	if (SortedMs.Num() == 0)
+	{
+		SortedMs.Add(0.0f);
+	}
+
+	const int32 Num = SortedMs.Num();
+	const FPlatformMemoryStats MemStats = FPlatformMemory::GetStats();
+
+	FString Report = TEXT("{\n");
+	Report += FString::Printf(TEXT("\t\"map\": \"%s\",\n"), *GetWorld()->GetMapName());
+	Report += FString::Printf(TEXT("\t\"bots\": %d,\n\t\"seed\": %d,\n\t\"frames\": %d,\n"), NumBots, Seed, Samples.Num());
+	Report += FString::Printf(TEXT("\t\"fixed_delta_seconds\": %.4f,\n"), FApp::GetFixedDeltaTime());
+	Report += FString::Printf(TEXT("\t\"net_adaptive_relevancy\": %s,\n"), bNetAdaptiveRelevancy ? TEXT("true") : TEXT("false"));
+	Report += FString::Printf(TEXT("\t\"frame_ms\": { \"avg\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n"),
+		TotalMs / Num, SortedMs[Num / 2], SortedMs[(Num * 95) / 100], SortedMs[(Num * 99) / 100], SortedMs[Num - 1]);
+	Report += FString::Printf(TEXT("\t\"scene_queries\": %lld,\n\t\"out_bunches\": %lld,\n\t\"out_bytes\": %lld,\n"), TotalQueries, TotalBunches, TotalBytes);
+	Report += FString::Printf(TEXT("\t\"avg_connections\": %.2f,\n\t\"out_bytes_per_connection\": %.0f,\n"), (double)TotalConnections / Num, BytesPerConnection);
+	Report += FString::Printf(TEXT("\t\"peak_used_physical_mb\": %.1f,\n"), MemStats.PeakUsedPhysical / (1024.0 * 1024.0));
+	Report += TEXT("\t\"frame_columns\": [\"frame_ms\", \"scene_queries\", \"out_bunches\", \"out_bytes\", \"connections\"],\n");
+	Report += FString::Printf(TEXT("\t\"frame_samples\": [%s\n\t]\n}\n"), *FramesJson);
+
+	const FString ReportPath = FPaths::ProfilingDir() / TEXT("Soak") / FString::Printf(TEXT("Soak-%s-%s.json"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(Report, *ReportPath))
+	{
+		UE_LOG(LogShooter, Log, TEXT("Soak: report written to %s"), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Soak: failed to write report to %s"), *ReportPath);
+	}
+
+	FPlatformMisc::RequestExit(false);
+}
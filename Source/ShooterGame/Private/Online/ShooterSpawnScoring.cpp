@@ -0,0 +1,264 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Online/ShooterSpawnScoring.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn scoring refresh"), STAT_ShooterSpawnScoring, STATGROUP_ShooterGame);
+
+/** deaths remembered at most */
+static const int32 MaxSpawnDeaths = 64;
+
+UShooterSpawnScoring::UShooterSpawnScoring(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	RandomScoreRange = 0.1f;
+	RefreshInterval = 0.5f;
+	SafeEnemyDistance = 3000.0f;
+	SightDistance = 6000.0f;
+	TeamPresenceRadius = 1500.0f;
+	DeathRadius = 1000.0f;
+	DeathMemoryTime = 10.0f;
+	MaxSightTracesPerRefresh = 64;
+	MaxSightChecksPerStart = 2;
+
+	EnemyDistanceWeight = 1.0f;
+	VisibleEnemyWeight = 1.0f;
+	RecentDeathWeight = 0.5f;
+	TeamPresenceWeight = 0.25f;
+
+	PlayInEditorStart = NULL;
+	LastRefreshTime = -1.0f;
+	NextSightStart = 0;
+	NumTeamSlots = 1;
+}
+
+const TArray<FScoredPlayerStart>& UShooterSpawnScoring::GetStarts() const
+{
+	return Starts;
+}
+
+APlayerStart* UShooterSpawnScoring::GetPlayInEditorStart() const
+{
+	return PlayInEditorStart;
+}
+
+int32 UShooterSpawnScoring::GetTeamSlot(AController* Player) const
+{
+	AShooterPlayerState* PlayerState = Player ? Cast<AShooterPlayerState>(Player->PlayerState) : NULL;
+	if (PlayerState && NumTeamSlots > 1)
+	{
+		return FMath::Clamp(PlayerState->GetTeamNum(), 0, NumTeamSlots - 1);
+	}
+
+	return 0;
+}
+
+void UShooterSpawnScoring::AddDeath(const FVector& Location)
+{
+	UWorld* World = GetOuter() ? GetOuter()->GetWorld() : NULL;
+	if (World == NULL)
+	{
+		return;
+	}
+
+	if (Deaths.Num() >= MaxSpawnDeaths)
+	{
+		Deaths.RemoveAt(0, 1, false);
+	}
+
+	FSpawnDeath Death;
+	Death.Location = Location;
+	Death.Time = World->GetTimeSeconds();
+	Deaths.Add(Death);
+}
+
+void UShooterSpawnScoring::UpdateStarts(AShooterGameMode* GameMode)
+{
+	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameMode->GameState);
+	const int32 NewNumTeamSlots = FMath::Max(MyGameState ? MyGameState->NumTeams : 0, 1);
+
+	int32 NumPlayerStarts = 0;
+	for (int32 i = 0; i < GameMode->PlayerStarts.Num(); i++)
+	{
+		if (GameMode->PlayerStarts[i])
+		{
+			NumPlayerStarts++;
+		}
+	}
+
+	if (NumPlayerStarts == Starts.Num() && NewNumTeamSlots == NumTeamSlots)
+	{
+		return;
+	}
+
+	NumTeamSlots = NewNumTeamSlots;
+	NextSightStart = 0;
+	PlayInEditorStart = NULL;
+	Starts.Reset();
+
+	for (int32 i = 0; i < GameMode->PlayerStarts.Num(); i++)
+	{
+		APlayerStart* Start = GameMode->PlayerStarts[i];
+		if (Start == NULL)
+		{
+			continue;
+		}
+
+		if (PlayInEditorStart == NULL && Cast<APlayerStartPIE>(Start) != NULL)
+		{
+			PlayInEditorStart = Start;
+		}
+
+		FScoredPlayerStart& Scored = Starts[Starts.AddZeroed()];
+		Scored.Start = Start;
+		Scored.Location = Start->GetActorLocation();
+		Scored.Scores.Init(0.0f, NumTeamSlots);
+		Scored.VisibleEnemies.Init(0, NumTeamSlots);
+	}
+}
+
+void UShooterSpawnScoring::Refresh()
+{
+	AShooterGameMode* GameMode = Cast<AShooterGameMode>(GetOuter());
+	UWorld* World = GameMode ? GameMode->GetWorld() : NULL;
+	if (World == NULL)
+	{
+		return;
+	}
+
+	const float Now = World->GetTimeSeconds();
+	if (LastRefreshTime >= 0.0f && Now - LastRefreshTime < RefreshInterval && Starts.Num() > 0)
+	{
+		return;
+	}
+	LastRefreshTime = Now;
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterSpawnScoring);
+
+	UpdateStarts(GameMode);
+	if (Starts.Num() == 0)
+	{
+		return;
+	}
+
+	// forget old deaths
+	int32 NumExpired = 0;
+	while (NumExpired < Deaths.Num() && Now - Deaths[NumExpired].Time > DeathMemoryTime)
+	{
+		NumExpired++;
+	}
+	if (NumExpired > 0)
+	{
+		Deaths.RemoveAt(0, NumExpired, false);
+	}
+
+	// living pawns and their teams
+	TArray<AShooterCharacter*> Pawns;
+	TArray<int32> PawnTeams;
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
+		if (TestPawn && TestPawn->IsAlive())
+		{
+			AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(TestPawn->PlayerState);
+			Pawns.Add(TestPawn);
+			PawnTeams.Add(PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE);
+		}
+	}
+
+	static FName SpawnSightTag = FName(TEXT("SpawnSight"));
+
+	const float SightDistanceSq = FMath::Square(SightDistance);
+	const float TeamPresenceRadiusSq = FMath::Square(TeamPresenceRadius);
+	const float DeathRadiusSq = FMath::Square(DeathRadius);
+
+	TArray<TPair<float, int32> > ByDistance;
+	int32 TracesLeft = MaxSightTracesPerRefresh;
+	const int32 FirstSightStart = NextSightStart % Starts.Num();
+
+	// sight checks go round robin, starting where the last refresh ran out of traces
+	for (int32 Offset = 0; Offset < Starts.Num(); Offset++)
+	{
+		const int32 StartIndex = (FirstSightStart + Offset) % Starts.Num();
+		FScoredPlayerStart& Scored = Starts[StartIndex];
+
+		const bool bCheckSight = TracesLeft > 0;
+		if (bCheckSight)
+		{
+			NextSightStart = StartIndex + 1;
+		}
+
+		ByDistance.Reset();
+		for (int32 i = 0; i < Pawns.Num(); i++)
+		{
+			ByDistance.Add(TPair<float, int32>((Pawns[i]->GetActorLocation() - Scored.Location).SizeSquared(), i));
+		}
+		Sort(ByDistance.GetData(), ByDistance.Num(), [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+		float DeathHeat = 0.0f;
+		for (int32 i = 0; i < Deaths.Num(); i++)
+		{
+			if ((Deaths[i].Location - Scored.Location).SizeSquared() < DeathRadiusSq)
+			{
+				DeathHeat += 1.0f - (Now - Deaths[i].Time) / DeathMemoryTime;
+			}
+		}
+
+		for (int32 Slot = 0; Slot < NumTeamSlots; Slot++)
+		{
+			float ClosestEnemyDistSq = -1.0f;
+			int32 TeamMates = 0;
+			int32 SightChecks = 0;
+			int32 Visible = 0;
+
+			for (int32 i = 0; i < ByDistance.Num(); i++)
+			{
+				const float DistSq = ByDistance[i].Key;
+				const int32 PawnIndex = ByDistance[i].Value;
+
+				// without teams every pawn is an enemy
+				const bool bEnemy = (NumTeamSlots <= 1 || PawnTeams[PawnIndex] != Slot);
+				if (!bEnemy)
+				{
+					TeamMates += (DistSq < TeamPresenceRadiusSq) ? 1 : 0;
+					continue;
+				}
+
+				if (ClosestEnemyDistSq < 0.0f)
+				{
+					ClosestEnemyDistSq = DistSq;
+				}
+
+				if (bCheckSight && TracesLeft > 0 && SightChecks < MaxSightChecksPerStart && DistSq < SightDistanceSq)
+				{
+					AShooterCharacter* Enemy = Pawns[PawnIndex];
+					FVector EyeLocation = Enemy->GetActorLocation();
+					EyeLocation.Z += Enemy->BaseEyeHeight;
+
+					FCollisionQueryParams TraceParams(SpawnSightTag, false, Enemy);
+					TraceParams.bTraceAsyncScene = true;
+
+					SHOOTER_COUNT_SCENE_QUERY();
+					if (!World->LineTraceTest(EyeLocation, Scored.Location, ECC_Visibility, TraceParams))
+					{
+						Visible++;
+					}
+
+					SightChecks++;
+					TracesLeft--;
+				}
+			}
+
+			if (bCheckSight)
+			{
+				Scored.VisibleEnemies[Slot] = (uint8)FMath::Min(Visible, 255);
+			}
+
+			const float EnemyDistance = (ClosestEnemyDistSq >= 0.0f) ? FMath::Sqrt(ClosestEnemyDistSq) : SafeEnemyDistance;
+			Scored.Scores[Slot] = EnemyDistanceWeight * FMath::Min(EnemyDistance / SafeEnemyDistance, 1.0f)
+				- VisibleEnemyWeight * Scored.VisibleEnemies[Slot]
+				- RecentDeathWeight * DeathHeat
+				+ TeamPresenceWeight * FMath::Min(TeamMates, 2) * 0.5f;
+		}
+	}
+}
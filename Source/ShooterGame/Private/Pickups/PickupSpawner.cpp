@@ -9,5 +9,43 @@ APickupSpawner::APickupSpawner(const FObjectInitializer& ObjectInitializer)
 {
 	EditorMesh = ObjectInitializer.CreateDefaultSubobject<UStaticMeshComponent>(this, TEXT("EditorMesh"));
 	RootComponent = EditorMesh;
+
+	RespawnTime = 30.0f;
+	CurrentPickup = NULL;
+}
+
+void APickupSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (Role == ROLE_Authority)
+	{
+		SpawnPickup();
+	}
 }
 
+void APickupSpawner::SpawnPickup()
+{
+	if (CurrentPickup == NULL)
+	{
+		CurrentPickup = AShooter_Pickup::SpawnPickup(GetWorld(), PickupClass, GetActorLocation(), GetActorRotation());
+		if (CurrentPickup)
+		{
+			CurrentPickup->Spawner = this;
+		}
+	}
+}
+
+void APickupSpawner::OnPickupConsumed(AShooter_Pickup* Pickup)
+{
+	if (Pickup != CurrentPickup)
+	{
+		return;
+	}
+
+	CurrentPickup = NULL;
+	if (RespawnTime > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(this, &APickupSpawner::SpawnPickup, RespawnTime, false);
+	}
+}
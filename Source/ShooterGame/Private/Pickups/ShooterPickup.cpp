@@ -37,6 +37,20 @@ void AShooterPickup::BeginPlay()
 	if (GameMode)
 	{
 		GameMode->LevelPickups.Add(this);
+		RegisterPickup(GameMode->GetPickupRegistry());
+	}
+}
+
+void AShooterPickup::RegisterPickup(UShooterPickupRegistry* Registry)
+{
+}
+
+void AShooterPickup::UpdateRegistry(float AvailableTime)
+{
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode)
+	{
+		GameMode->GetPickupRegistry()->SetAvailableTime(this, AvailableTime);
 	}
 }
 
@@ -73,6 +87,7 @@ void AShooterPickup::PickupOnTouch(class AShooterCharacter* Pawn)
 				{
 					GetWorldTimerManager().SetTimer(this, &AShooterPickup::RespawnPickup, RespawnTime, false);
 				}
+				UpdateRegistry(RespawnTime > 0.0f ? GetWorld()->GetTimeSeconds() + RespawnTime : MAX_FLT);
 			}
 		}
 	}
@@ -83,6 +98,7 @@ void AShooterPickup::RespawnPickup()
 	bIsActive = true;
 	PickedUpBy = NULL;
 	OnRespawned();
+	UpdateRegistry(GetWorld()->GetTimeSeconds());
 
 	TArray<AActor*> OverlappingPawns;
 	GetOverlappingActors(OverlappingPawns, AShooterCharacter::StaticClass());
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Pickups/ShooterPickupRegistry.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup query candidates"), STAT_ShooterPickupCandidates, STATGROUP_ShooterGame);
+
+UShooterPickupRegistry::UShooterPickupRegistry(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	CellSize = 4000.0f;
+
+	for (int32 i = 0; i < EShooterPickupType::MAX; i++)
+	{
+		MinCell[i] = FIntPoint(MAX_int32, MAX_int32);
+		MaxCell[i] = FIntPoint(MIN_int32, MIN_int32);
+	}
+}
+
+FIntPoint UShooterPickupRegistry::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+uint64 UShooterPickupRegistry::GetCellKey(EShooterPickupType::Type Type, const FIntPoint& Cell)
+{
+	return ((uint64)Type << 48) | ((uint64)(uint16)Cell.X << 16) | (uint64)(uint16)Cell.Y;
+}
+
+void UShooterPickupRegistry::AddToCell(int32 Index)
+{
+	FRegisteredPickup& Entry = Entries[Index];
+	Entry.Cell = GetCell(Entry.Location);
+	Cells.FindOrAdd(GetCellKey(Entry.Type, Entry.Cell)).Add(Index);
+
+	FIntPoint& TypeMin = MinCell[Entry.Type];
+	FIntPoint& TypeMax = MaxCell[Entry.Type];
+	TypeMin = FIntPoint(FMath::Min(TypeMin.X, Entry.Cell.X), FMath::Min(TypeMin.Y, Entry.Cell.Y));
+	TypeMax = FIntPoint(FMath::Max(TypeMax.X, Entry.Cell.X), FMath::Max(TypeMax.Y, Entry.Cell.Y));
+}
+
+void UShooterPickupRegistry::RemoveFromCell(int32 Index)
+{
+	const FRegisteredPickup& Entry = Entries[Index];
+	const uint64 Key = GetCellKey(Entry.Type, Entry.Cell);
+
+	TArray<int32>* Cell = Cells.Find(Key);
+	if (Cell)
+	{
+		Cell->RemoveSingleSwap(Index);
+		if (Cell->Num() == 0)
+		{
+			Cells.Remove(Key);
+		}
+	}
+}
+
+void UShooterPickupRegistry::Register(AActor* Pickup, EShooterPickupType::Type Type, UClass* ForClass, int32 Classification, float AvailableTime)
+{
+	if (Pickup == NULL)
+	{
+		return;
+	}
+
+	Unregister(Pickup);
+
+	const int32 Index = (FreeEntries.Num() > 0) ? FreeEntries.Pop(false) : Entries.AddZeroed();
+
+	FRegisteredPickup& Entry = Entries[Index];
+	Entry.Pickup = Pickup;
+	Entry.Location = Pickup->GetActorLocation();
+	Entry.ForClass = ForClass;
+	Entry.Classification = Classification;
+	Entry.Type = Type;
+	Entry.AvailableTime = AvailableTime;
+
+	EntryIndex.Add(Pickup->GetUniqueID(), Index);
+	AddToCell(Index);
+}
+
+void UShooterPickupRegistry::Unregister(AActor* Pickup)
+{
+	int32 Index = INDEX_NONE;
+	if (Pickup && EntryIndex.RemoveAndCopyValue(Pickup->GetUniqueID(), Index))
+	{
+		RemoveFromCell(Index);
+		Entries[Index].Pickup = NULL;
+		FreeEntries.Add(Index);
+	}
+}
+
+void UShooterPickupRegistry::SetAvailableTime(AActor* Pickup, float AvailableTime)
+{
+	const int32* Index = Pickup ? EntryIndex.Find(Pickup->GetUniqueID()) : NULL;
+	if (Index)
+	{
+		Entries[*Index].AvailableTime = AvailableTime;
+	}
+}
+
+void UShooterPickupRegistry::UpdateLocation(AActor* Pickup)
+{
+	const int32* Index = Pickup ? EntryIndex.Find(Pickup->GetUniqueID()) : NULL;
+	if (Index)
+	{
+		RemoveFromCell(*Index);
+		Entries[*Index].Location = Pickup->GetActorLocation();
+		AddToCell(*Index);
+	}
+}
+
+int32 UShooterPickupRegistry::GetNumPickups() const
+{
+	return EntryIndex.Num();
+}
+
+bool UShooterPickupRegistry::Matches(const FRegisteredPickup& Entry, const FPickupQuery& Query, float Now) const
+{
+	if (Entry.AvailableTime > Now + Query.MaxWaitTime)
+	{
+		return false;
+	}
+
+	if (Query.ForClass && (Entry.ForClass == NULL || !Entry.ForClass->IsChildOf(Query.ForClass)))
+	{
+		return false;
+	}
+
+	return Query.Classification == INDEX_NONE || Entry.Classification == Query.Classification;
+}
+
+AActor* UShooterPickupRegistry::FindNearest(const FVector& Location, const FPickupQuery& Query, float Now) const
+{
+	const FIntPoint& TypeMin = MinCell[Query.Type];
+	const FIntPoint& TypeMax = MaxCell[Query.Type];
+	if (TypeMin.X > TypeMax.X)
+	{
+		return NULL;
+	}
+
+	const FIntPoint MyCell = GetCell(Location);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(MyCell.X - TypeMin.X), FMath::Abs(TypeMax.X - MyCell.X)),
+		FMath::Max(FMath::Abs(MyCell.Y - TypeMin.Y), FMath::Abs(TypeMax.Y - MyCell.Y)));
+
+	// matching pickups found so far, sorted by distance once a ring is done
+	TArray<TPair<float, AActor*> > Candidates;
+	int32 NextCandidate = 0;
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		for (int32 X = MyCell.X - Ring; X <= MyCell.X + Ring; X++)
+		{
+			// only the border of the ring, the inside was done already
+			const bool bEdgeColumn = (X == MyCell.X - Ring || X == MyCell.X + Ring);
+			const int32 StepY = (bEdgeColumn || Ring == 0) ? 1 : Ring * 2;
+
+			for (int32 Y = MyCell.Y - Ring; Y <= MyCell.Y + Ring; Y += StepY)
+			{
+				const TArray<int32>* Cell = Cells.Find(GetCellKey(Query.Type, FIntPoint(X, Y)));
+				if (Cell == NULL)
+				{
+					continue;
+				}
+
+				for (int32 i = 0; i < Cell->Num(); i++)
+				{
+					const FRegisteredPickup& Entry = Entries[(*Cell)[i]];
+					AActor* Pickup = Entry.Pickup.Get();
+					if (Pickup && Matches(Entry, Query, Now))
+					{
+						Candidates.Add(TPair<float, AActor*>((Entry.Location - Location).SizeSquared(), Pickup));
+					}
+				}
+			}
+		}
+
+		if (NextCandidate == Candidates.Num())
+		{
+			continue;
+		}
+
+		// cells further out are at least this far away, closer candidates can be decided now
+		const float SafeDistSq = (Ring < MaxRing) ? FMath::Square(Ring * CellSize) : MAX_FLT;
+
+		Sort(Candidates.GetData() + NextCandidate, Candidates.Num() - NextCandidate,
+			[](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+
+		while (NextCandidate < Candidates.Num() && Candidates[NextCandidate].Key <= SafeDistSq)
+		{
+			AActor* Pickup = Candidates[NextCandidate].Value;
+			NextCandidate++;
+			INC_DWORD_STAT(STAT_ShooterPickupCandidates);
+
+			// pawn specific checks only for the few closest candidates
+			AShooterPickup* LevelPickup = Query.ForPawn ? Cast<AShooterPickup>(Pickup) : NULL;
+			if (LevelPickup == NULL || LevelPickup->CanBePickedUp(Query.ForPawn))
+			{
+				return Pickup;
+			}
+		}
+	}
+
+	return NULL;
+}
@@ -12,6 +12,11 @@ bool AShooterPickup_Ammo::IsForWeapon(UClass* WeaponClass)
 	return WeaponType->IsChildOf(WeaponClass);
 }
 
+void AShooterPickup_Ammo::RegisterPickup(UShooterPickupRegistry* Registry)
+{
+	Registry->Register(this, EShooterPickupType::Ammo, WeaponType, INDEX_NONE, bIsActive ? 0.0f : MAX_FLT);
+}
+
 bool AShooterPickup_Ammo::CanBePickedUp(class AShooterCharacter* TestPawn) const
 {
 	AShooterWeapon* TestWeapon = (TestPawn ? TestPawn->FindWeapon(WeaponType) : NULL);
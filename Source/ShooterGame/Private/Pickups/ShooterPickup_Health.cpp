@@ -7,6 +7,11 @@ AShooterPickup_Health::AShooterPickup_Health(const FObjectInitializer& ObjectIni
 	Health = 50;
 }
 
+void AShooterPickup_Health::RegisterPickup(UShooterPickupRegistry* Registry)
+{
+	Registry->Register(this, EShooterPickupType::Health, NULL, INDEX_NONE, bIsActive ? 0.0f : MAX_FLT);
+}
+
 bool AShooterPickup_Health::CanBePickedUp(class AShooterCharacter* TestPawn) const
 {
 	return TestPawn && (TestPawn->Health < TestPawn->GetMaxHealth());
@@ -10,3 +10,25 @@ AShooterPowerup::AShooterPowerup(const FObjectInitializer& ObjectInitializer)
 
 }
 
+void AShooterPowerup::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame && bIsOvershield)
+	{
+		MyGame->GetPickupRegistry()->Register(this, EShooterPickupType::Overshield, NULL, INDEX_NONE, 0.0f);
+	}
+}
+
+void AShooterPowerup::Destroyed()
+{
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame)
+	{
+		MyGame->GetPickupRegistry()->Unregister(this);
+	}
+
+	Super::Destroyed();
+}
+
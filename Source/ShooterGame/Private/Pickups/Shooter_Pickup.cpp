@@ -7,6 +7,191 @@
 AShooter_Pickup::AShooter_Pickup(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
+	bReplicates = true;
+	bReplicateMovement = true;
 
+	DroppedLifeSpan = 30.0f;
+	Spawner = NULL;
+	HeldWeapon = NULL;
 }
 
+AShooter_Pickup* AShooter_Pickup::SpawnPickup(UWorld* World, TSubclassOf<AShooter_Pickup> PickupClass, const FVector& Location, const FRotator& Rotation)
+{
+	if (World == NULL || PickupClass == NULL)
+	{
+		return NULL;
+	}
+
+	AShooterGameMode* MyGame = World->GetAuthGameMode<AShooterGameMode>();
+	AShooter_Pickup* Pickup = MyGame ? MyGame->AcquirePooledPickup(PickupClass) : NULL;
+	if (Pickup)
+	{
+		Pickup->ActivateFromPool(Location, Rotation);
+		return Pickup;
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.bNoCollisionFail = true;
+	return World->SpawnActor<AShooter_Pickup>(PickupClass, Location, Rotation, SpawnInfo);
+}
+
+AShooter_Pickup* AShooter_Pickup::DropWeapon(AShooterWeapon* Weapon, TSubclassOf<AShooter_Pickup> PickupClass, const FVector& Location, const FRotator& Rotation)
+{
+	AShooter_Pickup* Pickup = Weapon ? SpawnPickup(Weapon->GetWorld(), PickupClass, Location, Rotation) : NULL;
+	if (Pickup)
+	{
+		Weapon->Park();
+		Pickup->HeldWeapon = Weapon;
+		Pickup->CurrentNumberOfBullets = Weapon->GetCurrentAmmo();
+
+		if (Pickup->DroppedLifeSpan > 0.0f)
+		{
+			Pickup->GetWorldTimerManager().SetTimer(Pickup, &AShooter_Pickup::Consume, Pickup->DroppedLifeSpan, false);
+		}
+	}
+
+	return Pickup;
+}
+
+AShooterWeapon* AShooter_Pickup::TakeWeapon(int32 Bullets)
+{
+	AShooterWeapon* Weapon = HeldWeapon;
+	HeldWeapon = NULL;
+
+	if (Weapon)
+	{
+		Weapon->Unpark();
+
+		// ammo may have been handed out of this pickup while it was lying around
+		if (Weapon->GetCurrentAmmo() != Bullets)
+		{
+			Weapon->PickedUp(Bullets);
+		}
+		return Weapon;
+	}
+
+	if (Weapon_C == NULL)
+	{
+		return NULL;
+	}
+
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	Weapon = MyGame ? MyGame->AcquirePooledWeapon(Weapon_C) : NULL;
+	if (Weapon)
+	{
+		Weapon->Unpark();
+	}
+	else
+	{
+		FVector const& Loc = FVector(0, 0, 0);
+		FRotator const& Rot = FRotator(0, 0, -90);
+		Weapon = Cast<AShooterWeapon>(GetWorld()->SpawnActor(Weapon_C, &Loc, &Rot));
+	}
+
+	if (Weapon)
+	{
+		Weapon->PickedUp(Bullets);
+	}
+	return Weapon;
+}
+
+void AShooter_Pickup::Consume()
+{
+	GetWorldTimerManager().ClearTimer(this, &AShooter_Pickup::Consume);
+
+	if (HeldWeapon)
+	{
+		HeldWeapon->ReleaseOrDestroy();
+		HeldWeapon = NULL;
+	}
+
+	APickupSpawner* MySpawner = Spawner;
+	Spawner = NULL;
+	if (MySpawner)
+	{
+		MySpawner->OnPickupConsumed(this);
+	}
+
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame == NULL || !MyGame->ReleasePooledPickup(this))
+	{
+		Destroy();
+	}
+}
+
+void AShooter_Pickup::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	SetNetDormancy(DORM_Awake);
+
+	CurrentNumberOfBullets = GetClass()->GetDefaultObject<AShooter_Pickup>()->CurrentNumberOfBullets;
+	SetActorLocationAndRotation(Location, Rotation);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	UpdateRegistry(true);
+}
+
+void AShooter_Pickup::ParkInPool()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	// hidden state goes out with the last update before the channel sleeps
+	SetNetDormancy(DORM_DormantAll);
+
+	UpdateRegistry(false);
+}
+
+void AShooter_Pickup::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame)
+	{
+		MyGame->GetPickupRegistry()->Register(this, EShooterPickupType::Weapon, Weapon_C, WeaponClassification, 0.0f);
+	}
+}
+
+void AShooter_Pickup::UpdateRegistry(bool bAvailable)
+{
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame)
+	{
+		UShooterPickupRegistry* Registry = MyGame->GetPickupRegistry();
+		Registry->SetAvailableTime(this, bAvailable ? GetWorld()->GetTimeSeconds() : MAX_FLT);
+		if (bAvailable)
+		{
+			Registry->UpdateLocation(this);
+		}
+	}
+}
+
+void AShooter_Pickup::Destroyed()
+{
+	// destroyed directly instead of used up, don't leak the weapon or leave the spawner waiting
+	if (Role == ROLE_Authority)
+	{
+		if (HeldWeapon)
+		{
+			HeldWeapon->Destroy();
+			HeldWeapon = NULL;
+		}
+
+		if (Spawner)
+		{
+			Spawner->OnPickupConsumed(this);
+			Spawner = NULL;
+		}
+
+		AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		if (MyGame)
+		{
+			MyGame->GetPickupRegistry()->Unregister(this);
+		}
+	}
+
+	Super::Destroyed();
+}
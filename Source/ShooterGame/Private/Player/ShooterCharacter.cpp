@@ -2,6 +2,15 @@
 
 #include "ShooterGame.h"
 
+DECLARE_CYCLE_STAT(TEXT("Pickup evaluate"), STAT_ShooterPickupEvaluate, STATGROUP_ShooterGame);
+
+static TAutoConsoleVariable<int32> CVarNetAdaptiveRelevancy(
+	TEXT("Shooter.NetAdaptiveRelevancy"),
+	1,
+	TEXT("Distance, visibility and activity based replication priority and rate for characters, weapons and projectiles.\n")
+	TEXT(" 0: off, engine defaults\n")
+	TEXT(" 1: on (default)"));
+
 AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterCharacterMovement>(ACharacter::CharacterMovementComponentName))
 {
@@ -54,7 +63,18 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	ShieldBreakParticleComp->bAutoDestroy = false;
 	ShieldBreakParticleComp->AttachParent = GetMesh();
 
+
 	CachedMovementSpeedOnSpawn = GetCharacterMovement()->MaxWalkSpeed;
+
+	LagCompensationMaxRewind = 0.4f;
+	LagCompensationSnapshotInterval = 1.0f / 30.0f;
+	LastHitboxSnapshotTime = 0.0f;
+
+	NetIdleUpdateFrequency = 10.0f;
+	NetActivityHoldTime = 1.0f;
+	LastNetActivityTime = 0.0f;
+	NetPriorityFrame = 0;
+	NetPriorityScale = 1.0f;
 }
 
 void AShooterCharacter::PostInitializeComponents()
@@ -66,6 +86,14 @@ void AShooterCharacter::PostInitializeComponents()
 	{
 		Health = GetMaxHealth();
 		SpawnDefaultInventory();
+
+		// only remote shooters need to be rewound
+		if (GetNetMode() != NM_Standalone && LagCompensationSnapshotInterval > 0.0f)
+		{
+			HitboxHistory.Init(FMath::CeilToInt(LagCompensationMaxRewind / LagCompensationSnapshotInterval) + 1);
+		}
+
+		ShieldCurve.SetConstant(CurrentShieldAmount, GetWorld()->GetTimeSeconds());
 	}
 
 	// set initial mesh visibility (3rd person view)
@@ -262,6 +290,8 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 		return 0.f;
 	}
 
+	UpdateShieldAmount();
+
 	// Modify based on game rules.
 	AShooterGameMode* const Game = GetWorld()->GetAuthGameMode<AShooterGameMode>();
 	Damage = Game ? Game->ModifyDamage(Damage, this, DamageEvent, EventInstigator, DamageCauser) : 0.f;
@@ -270,6 +300,8 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 	float MyDamage = ActualDamage;
 	if (MyDamage > 0.f)
 	{
+		NotifyNetActivity();
+
 		if (CurrentWeapon->CurrentZoomLevel != 0)
 		{
 			//EndZoom();
@@ -286,7 +318,7 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 
 				if (MyDamage > 0.f)
 				{
-					GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("TOOK HealthDamage 1"));
+					SHOOTER_DEBUG(Damage, Verbose, FColor::Yellow, TEXT("TOOK HealthDamage 1"));
 					Health -= MyDamage;
 				}
 
@@ -303,7 +335,7 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 		}
 		else
 		{
-			GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("TOOK HealthDamage 2"));
+			SHOOTER_DEBUG(Damage, Verbose, FColor::Yellow, TEXT("TOOK HealthDamage 2"));
 			Health -= MyDamage;
 		}
 		if (Health <= 0)
@@ -320,17 +352,27 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 
 		if (bHasShields)
 		{
-			if (GetWorldTimerManager().IsTimerActive(this, &AShooterCharacter::CalculateShieldChargeTime))
+			SHOOTER_DEBUG(Damage, Verbose, FColor::Yellow, TEXT("TOOK DAMAGE"));
+
+			const float Now = GetWorld()->GetTimeSeconds();
+			if (bHasOvershield && CurrentShieldAmount > MaxShieldAmount)
 			{
-				GetWorldTimerManager().ClearTimer(this, &AShooterCharacter::CalculateShieldChargeTime);
+				// overshield keeps decaying from where the hit left it
+				ShieldCurve.SetRamp(CurrentShieldAmount, MaxShieldAmount, (CurrentShieldAmount - MaxShieldAmount) * OvershieldDecayRate, Now);
+				GetWorldTimerManager().SetTimer(this, &AShooterCharacter::DecayOvershield, ShieldCurve.GetDuration(), false);
 			}
-
-			if (GetWorldTimerManager().IsTimerActive(this, &AShooterCharacter::RechargeShield))
+			else
 			{
-				GetWorldTimerManager().ClearTimer(this, &AShooterCharacter::RechargeShield);
+				if (bHasOvershield)
+				{
+					bHasOvershield = false;
+					GetWorldTimerManager().ClearTimer(this, &AShooterCharacter::DecayOvershield);
+				}
+
+				// hold shields until the recharge delay is over, setting the timer again restarts the delay
+				ShieldCurve.SetConstant(CurrentShieldAmount, Now);
+				GetWorldTimerManager().SetTimer(this, &AShooterCharacter::CalculateShieldChargeTime, 3.0f, false);
 			}
-			GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("TOOK DAMAGE"));
-			GetWorldTimerManager().SetTimer(this, &AShooterCharacter::CalculateShieldChargeTime, 3.0f, false);
 		}
 	}
 
@@ -620,7 +662,7 @@ void AShooterCharacter::SpawnDefaultInventory()
 
 void AShooterCharacter::DestroyInventory()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("DESTROY INVENTORY, THIS SHOULD NOT BE SHOW BEFORE THE SPAWN STUFF"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Green, TEXT("DESTROY INVENTORY, THIS SHOULD NOT BE SHOW BEFORE THE SPAWN STUFF"));
 	if (Role < ROLE_Authority)
 	{
 		return;
@@ -633,7 +675,7 @@ void AShooterCharacter::DestroyInventory()
 		if (Weapon)
 		{
 			RemoveWeapon(Weapon);
-			Weapon->Destroy();
+			Weapon->ReleaseOrDestroy();
 		}
 	}
 }
@@ -1000,7 +1042,7 @@ void AShooterCharacter::OnStopFire()
 // CHANGED STUFF IN THIS
 void AShooterCharacter::OnStartTargeting()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("ONSTARTTARGETTING"));
+	SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("ONSTARTTARGETTING"));
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->IsGameInputAllowed())
 	{
@@ -1131,6 +1173,22 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 	{
 		SetRunning(false, false);
 	}
+
+	if (Role == ROLE_Authority)
+	{
+		SaveHitboxSnapshot();
+
+		if (!bIsDying)
+		{
+			UpdateNetUpdateFrequency();
+		}
+	}
+
+	if (ShieldCurve.Rate != 0.0f)
+	{
+		UpdateShieldAmount();
+	}
+
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->HasHealthRegen())
 	{
@@ -1207,7 +1265,7 @@ void AShooterCharacter::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	// everyone
 	DOREPLIFETIME(AShooterCharacter, CurrentWeapon);
 	DOREPLIFETIME(AShooterCharacter, Health);
-	DOREPLIFETIME(AShooterCharacter, CurrentShieldAmount);
+	DOREPLIFETIME(AShooterCharacter, ShieldCurve);
 	//DOREPLIFETIME(AShooterCharacter, PreviousWeapon);
 }
 
@@ -1295,7 +1353,7 @@ void AShooterCharacter::TakeHeadshotDamage(float Damage, struct FDamageEvent con
 {
 	if (HeadshotDamage != 0.f)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("headshot damage != 0.f"));
+		SHOOTER_DEBUG(Damage, Log, FColor::Red, TEXT("headshot damage != 0.f"));
 
 
 		// a headshot took place
@@ -1326,6 +1384,8 @@ void AShooterCharacter::TakeHeadshotDamage(float Damage, struct FDamageEvent con
 
 float AShooterCharacter::CalculateDamageToUse(float Damage, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, class AActor* DamageCauser, float HeadshotDamage, float ShieldDamage)
 {
+	UpdateShieldAmount();
+
 	if (DamageEvent.IsOfType(FRadialDamageEvent::ClassID))
 	{
 		FRadialDamageEvent* const RadialDamageEvent = (FRadialDamageEvent*)&DamageEvent;
@@ -1345,7 +1405,7 @@ float AShooterCharacter::CalculateDamageToUse(float Damage, struct FDamageEvent
 
 				float ActualHealthDamage = InternalTakeRadialDamage(Damage, *RadialDamageEvent, EventInstigator, DamageCauser);
 
-				GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, TEXT("ACTUALDAMAGESHILED > CURRENTSHIELDAMOUNT"));
+				SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("ACTUALDAMAGESHILED > CURRENTSHIELDAMOUNT"));
 				// actualhealthdamage - actualdamageshield + currentshieldamount
 				//return ActualHealthDamage + CurrentShieldAmount;
 
@@ -1363,7 +1423,7 @@ float AShooterCharacter::CalculateDamageToUse(float Damage, struct FDamageEvent
 			{
 				// damage is less than shields left so we do shield damage
 				//return ActualDamageShield;
-				GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, TEXT("ACTUALDAMAGESHILED < CURRENTSHIELDAMOUNT"));
+				SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("ACTUALDAMAGESHILED < CURRENTSHIELDAMOUNT"));
 				//return ShieldDamage;
 
 				return ActualDamageShield;
@@ -1375,7 +1435,7 @@ float AShooterCharacter::CalculateDamageToUse(float Damage, struct FDamageEvent
 
 			ActualHealthDamage = InternalTakeRadialDamage(Damage, *RadialDamageEvent, EventInstigator, DamageCauser);
 
-			GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, TEXT("HAS NO SHIELDS"));
+			SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("HAS NO SHIELDS"));
 
 			return ActualHealthDamage;
 		}
@@ -1446,7 +1506,7 @@ void AShooterCharacter::CalculateShieldChargeTime()
 	RechargeShield();
 	if (GEngine)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("CALCULATED SHIELDS"));
+		SHOOTER_DEBUG(Damage, Log, FColor::Yellow, TEXT("CALCULATED SHIELDS"));
 	}
 }
 
@@ -1457,28 +1517,38 @@ void AShooterCharacter::RechargeShield()
 		return;
 	}
 
+	UpdateShieldAmount();
+
+	const float Now = GetWorld()->GetTimeSeconds();
 	if (CurrentShieldAmount < MaxShieldAmount)
 	{
-		CurrentShieldAmount += 1;
-
-		if (CurrentShieldAmount < MaxShieldAmount)
-		{
-			GetWorldTimerManager().SetTimer(this, &AShooterCharacter::RechargeShield, ShieldRecoverRate, false);
-		}
-		else
-		{
-			if (CurrentShieldAmount > MaxShieldAmount)
-			{
-				CurrentShieldAmount = MaxShieldAmount;
-			}
-		}
+		ShieldCurve.SetRamp(CurrentShieldAmount, MaxShieldAmount, (MaxShieldAmount - CurrentShieldAmount) * ShieldRecoverRate, Now);
 	}
 	else
 	{
 		CurrentShieldAmount = MaxShieldAmount;
+		ShieldCurve.SetConstant(CurrentShieldAmount, Now);
 	}
 }
 
+float AShooterCharacter::GetShieldAmount() const
+{
+	// the segment starts in server time, clients that get it late still land partway through a ramp
+	const AShooterGameState* const MyGameState = Cast<AShooterGameState>(GetWorld()->GameState);
+	const float Now = (Role < ROLE_Authority && MyGameState) ? MyGameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	return ShieldCurve.Evaluate(Now, ShieldCurve.StartTime);
+}
+
+void AShooterCharacter::UpdateShieldAmount()
+{
+	CurrentShieldAmount = GetShieldAmount();
+}
+
+void AShooterCharacter::OnRep_ShieldCurve()
+{
+	UpdateShieldAmount();
+}
+
 void AShooterCharacter::MyAddWeapon(AShooterWeapon* Weapon)
 {
 	AddWeapon(Weapon);
@@ -1513,17 +1583,12 @@ bool AShooterCharacter::TryPickUp_Validate(class AShooter_Pickup* P, int32 C)
 
 void AShooterCharacter::TryPickUp_Implementation(class AShooter_Pickup* P, int32 C)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Yellow, TEXT("Try Pickup Implementation!"));
-	if (P->Weapon_C)
+	SHOOTER_DEBUG(Pickup, Log, FColor::Yellow, TEXT("Try Pickup Implementation!"));
+	AShooterWeapon* Weap = P ? P->TakeWeapon(C) : NULL;
+	if (Weap)
 	{
-
-		FVector const& Loc = FVector(0, 0, 0);
-		FRotator const& Rot = FRotator(0, 0, -90);
-		AShooterWeapon* Weap = Cast<AShooterWeapon>(GetWorld()->SpawnActor(P->Weapon_C, &Loc, &Rot));
-		Weap->PickedUp(C);
 		MyAddWeapon(Weap);
 		OnNextWeapon();
-		//P->Destroy();
 	}
 }
 
@@ -1554,14 +1619,16 @@ bool AShooterCharacter::EvaluatePickup_Validate(class AShooter_Pickup* P)
 
 void AShooterCharacter::EvaluatePickup_Implementation(class AShooter_Pickup* P)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("EVALUATE PICKUP MOTHERFUCKER!"));
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPickupEvaluate);
+
+	SHOOTER_DEBUG(Pickup, Log, FColor::Red, TEXT("EVALUATE PICKUP MOTHERFUCKER!"));
 
 	if (P)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("P IS TOTALLY VALID"));
+		SHOOTER_DEBUG(Pickup, Log, FColor::Red, TEXT("P IS TOTALLY VALID"));
 		if (P->WeaponClassification == CurrentWeapon->WeaponClassification)
 		{
-			GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("SAME AS CURRENT WEAPON!"));
+			SHOOTER_DEBUG(Pickup, Log, FColor::Red, TEXT("SAME AS CURRENT WEAPON!"));
 			// same type of weapon, should be adding ammo
 			if (CurrentWeapon->GetCurrentAmmo() < CurrentWeapon->GetMaxAmmo())
 			{
@@ -1571,8 +1638,8 @@ void AShooterCharacter::EvaluatePickup_Implementation(class AShooter_Pickup* P)
 				CurrentWeapon->AddAmmoFromPickup(P->CurrentNumberOfBullets);
 				if (NewAmmoAmount <= 0)
 				{
-					// no ammo left, destroy pickup
-					P->Destroy();
+					// no ammo left, pickup is used up
+					P->Consume();
 				}
 				else
 				{
@@ -1584,7 +1651,7 @@ void AShooterCharacter::EvaluatePickup_Implementation(class AShooter_Pickup* P)
 		}
 		else if (PreviousWeapon && P->WeaponClassification == PreviousWeapon->WeaponClassification)
 		{
-				GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("SAME AS PREVIOUS WEAPON!"));
+				SHOOTER_DEBUG(Pickup, Log, FColor::Red, TEXT("SAME AS PREVIOUS WEAPON!"));
 				// not same as current weapon, but same as previous weapon. should be adding ammo to previous weapon
 				if (PreviousWeapon->GetCurrentAmmo() < PreviousWeapon->GetMaxAmmo())
 				{
@@ -1594,8 +1661,8 @@ void AShooterCharacter::EvaluatePickup_Implementation(class AShooter_Pickup* P)
 					PreviousWeapon->AddAmmoFromPickup(P->CurrentNumberOfBullets);
 					if (NewAmmoAmount <= 0)
 					{
-						// no ammo left, destroy pickup
-						P->Destroy();
+						// no ammo left, pickup is used up
+						P->Consume();
 					}
 					else
 					{
@@ -1607,25 +1674,19 @@ void AShooterCharacter::EvaluatePickup_Implementation(class AShooter_Pickup* P)
 		else
 		{
 
-			GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("PICKUP THE DAMN GUN!"));
+			SHOOTER_DEBUG(Pickup, Log, FColor::Red, TEXT("PICKUP THE DAMN GUN!"));
 			// not the same type as either weapon, should drop current weapon and add weapon from pickup
 			DropCurrentWeapon2();
 
-
-
-			if (P->Weapon_C)
+			// the same weapon that was dropped here, or a pooled one
+			AShooterWeapon* Weap = P->TakeWeapon(P->CurrentNumberOfBullets);
+			if (Weap)
 			{
-
-				FVector const& Loc = FVector(0, 0, 0);
-				FRotator const& Rot = FRotator(0, 0, -90);
-				AShooterWeapon* Weap = Cast<AShooterWeapon>(GetWorld()->SpawnActor(P->Weapon_C, &Loc, &Rot));
-				Weap->PickedUp(P->CurrentNumberOfBullets);
 				MyAddWeapon(Weap);
 				EquipWeapon(Weap);
-				//P->Destroy();
 			}
 
-			P->Destroy();
+			P->Consume();
 		}
 	}
 }
@@ -1637,24 +1698,22 @@ bool AShooterCharacter::DropCurrentWeapon2_Validate()
 
 void AShooterCharacter::DropCurrentWeapon2_Implementation()
 {
-	if (CurrentWeapon->PickupBP)
+	AShooterWeapon* Weapon = CurrentWeapon;
+	if (Weapon && Weapon->PickupBP)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("HAS A PICKUPBP!"));
-		if (CurrentWeapon->GetCurrentAmmo() > 0 && CurrentWeapon->PickupBP)
+		SHOOTER_DEBUG(Pickup, Log, FColor::Red, TEXT("HAS A PICKUPBP!"));
+		RemoveWeapon(Weapon);
+
+		// has ammo so drop it as a pickup, the weapon goes along with its state
+		AShooter_Pickup* Pickup = NULL;
+		if (Weapon->GetCurrentAmmo() > 0)
 		{
-			// has ammo so drop pickup
-			FVector const& Loc = GetActorLocation();
-			FRotator const& Rot = GetActorRotation();
-			AShooter_Pickup* Pickup = Cast<AShooter_Pickup>(GetWorld()->SpawnActor(CurrentWeapon->PickupBP, &Loc, &Rot));
-			if (Pickup)
-			{
-				Pickup->CurrentNumberOfBullets = CurrentWeapon->GetCurrentAmmo();
-			}
-			RemoveWeapon(CurrentWeapon);
+			Pickup = AShooter_Pickup::DropWeapon(Weapon, Weapon->PickupBP, GetActorLocation(), GetActorRotation());
 		}
-		else
+
+		if (Pickup == NULL)
 		{
-			RemoveWeapon(CurrentWeapon);
+			Weapon->ReleaseOrDestroy();
 		}
 	}
 }
@@ -1686,7 +1745,7 @@ void AShooterCharacter::EvaluateAddingAmmoFromPickup_Implementation(class AShoot
 				}
 				else
 				{
-					P->Destroy();
+					P->Consume();
 				}
 
 			}
@@ -1704,7 +1763,7 @@ void AShooterCharacter::EvaluateAddingAmmoFromPickup_Implementation(class AShoot
 					}
 					else
 					{
-						P->Destroy();
+						P->Consume();
 					}
 				}
 			}
@@ -1723,7 +1782,7 @@ void AShooterCharacter::EvaluateAddingAmmoFromPickup_Implementation(class AShoot
 				}
 				else
 				{
-					P->Destroy();
+					P->Consume();
 				}
 			}
 		}
@@ -1779,21 +1838,16 @@ bool AShooterCharacter::ServerGrenadeThrow_Validate(FVector StartLocation, FVect
 void AShooterCharacter::ServerGrenadeThrow_Implementation(FVector StartLocation, FVector_NetQuantizeNormal MyAim)
 {
 	FTransform SpawnTM(MyAim.Rotation(), StartLocation);
-	AShooterProjectile* Grenade = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, GrenadeConfig.GrenadeClass, SpawnTM));
+	AShooterProjectile* Grenade = AShooterProjectile::SpawnProjectile(this, GrenadeConfig.GrenadeClass, SpawnTM, MyAim);
 
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Yellow, TEXT("SERVER GRENADE THROW IMPLEMENTATION!!!!!!!!"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("SERVER GRENADE THROW IMPLEMENTATION!!!!!!!!"));
 	if (Grenade)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Yellow, TEXT("SERVER GRENADE THROW IMPLEMENTATION 2!!!!!!!!"));
-		Grenade->Instigator = Instigator;
-		Grenade->SetOwner(this);
-		Grenade->InitVelocity(MyAim);
-
-		UGameplayStatics::FinishSpawningActor(Grenade, SpawnTM);
+		SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("SERVER GRENADE THROW IMPLEMENTATION 2!!!!!!!!"));
 
 		CurrentWeapon->StartGrenadeAnim();
 
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Yellow, TEXT("SERVER GRENADE THROW IMPLEMENTATION 3!!!!!!!!"));
+		SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("SERVER GRENADE THROW IMPLEMENTATION 3!!!!!!!!"));
 	}
 
 	/*if (bThrowingGrenade || Grenades <= 0)
@@ -1873,12 +1927,12 @@ void AShooterCharacter::ApplyGrenadeConfig(FGrenadeData& Data)
 
 void AShooterCharacter::MyStartCrouch()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("MY START CROUCH"));
+	SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("MY START CROUCH"));
 	GetCharacterMovement()->bWantsToCrouch = true;
 
 	if (GetCharacterMovement()->IsFalling())
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("CROUCH JUMP"));
+		SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("CROUCH JUMP"));
 		//FVector newLoc = GetMesh()->RelativeLocation;
 		//newLoc.Z = newLoc.Z - 9999;
 		//GetMesh()->SetRelativeLocation(newLoc);
@@ -1888,12 +1942,12 @@ void AShooterCharacter::MyStartCrouch()
 
 void AShooterCharacter::MyStopCrouch()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("MY STOP CROUCH"));
+	SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("MY STOP CROUCH"));
 	GetCharacterMovement()->bWantsToCrouch = false;
 
 	if (GetCharacterMovement()->IsFalling())
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("CROUCH JUMP END"));
+		SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("CROUCH JUMP END"));
 		//FVector newLoc = GetMesh()->RelativeLocation;
 		//newLoc.Z = newLoc.Z + 9999;
 		//GetMesh()->SetRelativeLocation(newLoc);
@@ -1905,11 +1959,11 @@ void AShooterCharacter::MyRecalculateBaseEyeHeight()
 	RecalculateBaseEyeHeight();
 	if (bIsCrouched)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("bIsCrouched = true"));
+		SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("bIsCrouched = true"));
 	}
 	else
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("bIsCrouched = false"));
+		SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("bIsCrouched = false"));
 	}
 
 }
@@ -1988,7 +2042,7 @@ void AShooterCharacter::StartZoom()
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	MyPC->PlayerCameraManager->UnlockFOV();
 
-	GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("START ZOOM"));
+	SHOOTER_DEBUG(Movement, Log, FColor::Yellow, TEXT("START ZOOM"));
 
 	if (CurrentWeapon->CurrentZoomLevel != CurrentWeapon->MaxZoomLevel)
 	{
@@ -2063,36 +2117,16 @@ void AShooterCharacter::ClientEndZoom_Implementation()
 
 void AShooterCharacter::CalculateOvershield()
 {
-	OvershieldChargeRate = (OvershieldChargeTime / (OSPower - CurrentShieldAmount)) * 5;
+	UpdateShieldAmount();
 
 	bOvershieldCharging = true;
+	GetWorldTimerManager().ClearTimer(this, &AShooterCharacter::CalculateShieldChargeTime);
+	GetWorldTimerManager().ClearTimer(this, &AShooterCharacter::DecayOvershield);
 
-	ChargeOvershield();
-}
-
-void AShooterCharacter::ChargeOvershield()
-{
 	if (CurrentShieldAmount < OSPower)
 	{
-		CurrentShieldAmount += 5;
-
-		if (CurrentShieldAmount < OSPower)
-		{
-			GetWorldTimerManager().SetTimer(this, &AShooterCharacter::ChargeOvershield, OvershieldChargeRate, false);
-		}
-		else
-		{
-			bOvershieldCharging = false;
-			bHasOvershield = true;
-
-			CurrentShieldAmount = OSPower;
-
-			/////////////////////////////////// CALCULATE OS DECAY
-
-			OvershieldDecayRate = (OvershieldDecayTime / (OSPower - MaxShieldAmount));
-
-			DecayOvershield();
-		}
+		ShieldCurve.SetRamp(CurrentShieldAmount, OSPower, OvershieldChargeTime, GetWorld()->GetTimeSeconds());
+		GetWorldTimerManager().SetTimer(this, &AShooterCharacter::ChargeOvershield, OvershieldChargeTime, false);
 	}
 	else
 	{
@@ -2100,29 +2134,36 @@ void AShooterCharacter::ChargeOvershield()
 	}
 }
 
-void AShooterCharacter::DecayOvershield()
+void AShooterCharacter::ChargeOvershield()
 {
+	bOvershieldCharging = false;
+	bHasOvershield = true;
 
-	if (CurrentShieldAmount > MaxShieldAmount)
-	{
-		CurrentShieldAmount -= 1;
+	CurrentShieldAmount = OSPower;
 
+	/////////////////////////////////// CALCULATE OS DECAY
 
-		if (CurrentShieldAmount > MaxShieldAmount)
-		{
-			GetWorldTimerManager().SetTimer(this, &AShooterCharacter::DecayOvershield, OvershieldDecayRate, false);
-		}
-		else
-		{
-			bHasOvershield = false;
-		}
+	OvershieldDecayRate = (OvershieldDecayTime / (OSPower - MaxShieldAmount));
+
+	if (CurrentShieldAmount > MaxShieldAmount)
+	{
+		ShieldCurve.SetRamp(CurrentShieldAmount, MaxShieldAmount, OvershieldDecayTime, GetWorld()->GetTimeSeconds());
+		GetWorldTimerManager().SetTimer(this, &AShooterCharacter::DecayOvershield, OvershieldDecayTime, false);
 	}
 	else
 	{
-		bHasOvershield = false;
+		DecayOvershield();
 	}
 }
 
+void AShooterCharacter::DecayOvershield()
+{
+	bHasOvershield = false;
+
+	UpdateShieldAmount();
+	ShieldCurve.SetConstant(CurrentShieldAmount, GetWorld()->GetTimeSeconds());
+}
+
 
 bool AShooterCharacter::UpdatePreviousWeapon_Validate()
 {
@@ -2167,7 +2208,7 @@ void AShooterCharacter::ResetStun_Implementation()
 ///////////////////// NEW MELEE STUFF TESTING
 void AShooterCharacter::OnStartMeleeNew()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Yellow, TEXT("ONSTARTMELEENEW!!!"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("ONSTARTMELEENEW!!!"));
 	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
 	if (MyPC && MyPC->IsGameInputAllowed())
 	{
@@ -2183,7 +2224,7 @@ void AShooterCharacter::OnStartMeleeNew()
 
 void AShooterCharacter::StartWeaponMelee()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Yellow, TEXT("STARTWEAPONMELEE!!!"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("STARTWEAPONMELEE!!!"));
 	if (!bWantsToMeleeNew)
 	{
 		//bWantsToMeleeNew = true;
@@ -2222,4 +2263,103 @@ void AShooterCharacter::StartGrenadeThrowNew()
 FGrenadeData AShooterCharacter::GetGrenadeConfig()
 {
 	return GrenadeConfig;
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Lag compensation
+
+void AShooterCharacter::SaveHitboxSnapshot()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (HitboxHistory.Num() > 0 && Now - LastHitboxSnapshotTime < LagCompensationSnapshotInterval)
+	{
+		return;
+	}
+
+	LastHitboxSnapshotTime = Now;
+	HitboxHistory.Add(Now, GetComponentsBoundingBox());
+}
+
+FBox AShooterCharacter::GetHitBoxAtTime(float Time) const
+{
+	const float OldestAllowed = GetWorld()->GetTimeSeconds() - LagCompensationMaxRewind;
+
+	FBox HitBox(0);
+	if (!HitboxHistory.GetBoxAtTime(FMath::Max(Time, OldestAllowed), HitBox))
+	{
+		HitBox = GetComponentsBoundingBox();
+	}
+
+	return HitBox;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Replication tuning
+
+bool AShooterCharacter::IsNetAdaptiveRelevancyEnabled()
+{
+	return CVarNetAdaptiveRelevancy.GetValueOnGameThread() != 0;
+}
+
+float AShooterCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, InChannel, Time, bLowBandwidth);
+	return Priority * GetNetPriorityScale(ViewPos, Viewer);
+}
+
+float AShooterCharacter::GetNetPriorityScale(const FVector& ViewPos, APlayerController* Viewer)
+{
+	if (!IsNetAdaptiveRelevancyEnabled() || Viewer == NULL || Viewer->GetPawn() == NULL || Viewer->GetPawn() == this)
+	{
+		return 1.0f;
+	}
+
+	if (NetPriorityFrame == GFrameCounter && NetPriorityViewer == Viewer)
+	{
+		return NetPriorityScale;
+	}
+
+	const float Scale = NetPriorityFalloff.GetScale((GetActorLocation() - ViewPos).SizeSquared());
+
+	NetPriorityViewer = Viewer;
+	NetPriorityFrame = GFrameCounter;
+	NetPriorityScale = Scale;
+	return Scale;
+}
+
+void AShooterCharacter::NotifyNetActivity()
+{
+	if (Role == ROLE_Authority)
+	{
+		LastNetActivityTime = GetWorld()->GetTimeSeconds();
+		UpdateNetUpdateFrequency();
+	}
+}
+
+void AShooterCharacter::UpdateNetUpdateFrequency()
+{
+	const float ActiveFrequency = GetClass()->GetDefaultObject<AShooterCharacter>()->NetUpdateFrequency;
+	if (!IsNetAdaptiveRelevancyEnabled())
+	{
+		NetUpdateFrequency = ActiveFrequency;
+		return;
+	}
+
+	const bool bFiring = CurrentWeapon && CurrentWeapon->GetCurrentState() == EWeaponState::Firing;
+	if (bFiring || !GetVelocity().IsNearlyZero(1.0f))
+	{
+		LastNetActivityTime = GetWorld()->GetTimeSeconds();
+	}
+
+	const bool bActive = GetWorld()->GetTimeSeconds() - LastNetActivityTime < NetActivityHoldTime;
+	const float WantedFrequency = bActive ? ActiveFrequency : FMath::Min(NetIdleUpdateFrequency, ActiveFrequency);
+	if (NetUpdateFrequency != WantedFrequency)
+	{
+		// idle pawns are only looked at a few times a second, send the first active update now
+		if (WantedFrequency > NetUpdateFrequency)
+		{
+			ForceNetUpdate();
+		}
+		NetUpdateFrequency = WantedFrequency;
+	}
+}
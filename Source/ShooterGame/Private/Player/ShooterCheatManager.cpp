@@ -74,4 +74,314 @@ void UShooterCheatManager::SpawnBot()
 		AShooterAIController* AIC = MyGame->CreateBot(CheatBotNum++);
 		MyGame->RestartPlayer(AIC);		
 	}
-}
\ No newline at end of file
+}
+
+void UShooterCheatManager::BenchProjectilePool(int32 NumShots, int32 NumInFlight)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterCharacter* const MyPawn = Cast<AShooterCharacter>(MyPC->GetPawn());
+	AShooterGameMode* const MyGame = MyPC->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyPawn == NULL || MyGame == NULL)
+	{
+		return;
+	}
+
+	TSubclassOf<AShooterProjectile> ProjectileClass = MyPawn->GetGrenadeConfig().GrenadeClass;
+	if (ProjectileClass == NULL)
+	{
+		return;
+	}
+
+	NumShots = FMath::Clamp(NumShots, 1, 10000);
+	NumInFlight = FMath::Clamp(NumInFlight > 0 ? NumInFlight : 64, 1, NumShots);
+
+	// fire straight up, well above the pawn, so nothing is hit while measuring
+	const FVector ShootDir(0.0f, 0.0f, 1.0f);
+	const FTransform SpawnTM(ShootDir.Rotation(), MyPawn->GetActorLocation() + ShootDir * 10000.0f);
+	const bool bWasUsingPool = MyGame->IsUsingProjectilePool();
+
+	double PassTime[2];
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		MyGame->SetUseProjectilePool(Pass == 1);
+
+		// ring of projectiles in flight, each one is released NumInFlight shots after it was fired,
+		// so the pool has to fill up and recycle instead of handing back the same actor every shot
+		TArray<AShooterProjectile*> InFlight;
+		InFlight.AddZeroed(NumInFlight);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumShots; i++)
+		{
+			AShooterProjectile*& Slot = InFlight[i % NumInFlight];
+			if (Slot)
+			{
+				Slot->ReleaseOrDestroy();
+			}
+			Slot = AShooterProjectile::SpawnProjectile(MyPawn, ProjectileClass, SpawnTM, ShootDir);
+		}
+		for (int32 i = 0; i < InFlight.Num(); i++)
+		{
+			if (InFlight[i])
+			{
+				InFlight[i]->ReleaseOrDestroy();
+			}
+		}
+		PassTime[Pass] = FPlatformTime::Seconds() - StartTime;
+	}
+
+	MyGame->SetUseProjectilePool(bWasUsingPool);
+
+	const FString Result = FString::Printf(TEXT("%d projectiles, %d in flight: spawn/destroy %.2f ms, pooled %.2f ms (destroyed actors still wait for GC)"),
+		NumShots, NumInFlight, PassTime[0] * 1000.0, PassTime[1] * 1000.0);
+	UE_LOG(LogShooter, Log, TEXT("BenchProjectilePool: %s"), *Result);
+	MyPC->ClientMessage(Result);
+}
+
+void UShooterCheatManager::BotPerceptionStats()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterGameMode* const MyGame = MyPC->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame == NULL)
+	{
+		return;
+	}
+
+	int32 NumBots = 0;
+	for (FConstControllerIterator It = MyPC->GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		if (Cast<AShooterAIController>(*It))
+		{
+			NumBots++;
+		}
+	}
+
+	UShooterBotPerception* const Perception = MyGame->GetBotPerception();
+	const FString Result = FString::Printf(TEXT("%d bots: %.1f LOS traces/s, %.1f cache hits/s"),
+		NumBots, Perception->GetTracesPerSecond(), Perception->GetCacheHitsPerSecond());
+	UE_LOG(LogShooter, Log, TEXT("BotPerceptionStats: %s"), *Result);
+	MyPC->ClientMessage(Result);
+}
+
+void UShooterCheatManager::BenchRadialDamage(int32 NumExplosions)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	APawn* const MyPawn = MyPC->GetPawn();
+	AShooterGameMode* const MyGame = MyPC->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyPawn == NULL || MyGame == NULL || MyGame->DefaultPawnClass == NULL)
+	{
+		return;
+	}
+
+	NumExplosions = FMath::Clamp(NumExplosions, 1, 10000);
+
+	// blast well above the pawn, so the level doesn't get in the way
+	const FVector Origin = MyPawn->GetActorLocation() + FVector(0.0f, 0.0f, 5000.0f);
+	const float Radius = 600.0f;
+
+	TArray<AActor*> IgnoreActors;
+	IgnoreActors.Add(MyPawn);
+
+	const int32 ActorCounts[] = { 1, 8, 32 };
+	for (int32 Pass = 0; Pass < ARRAY_COUNT(ActorCounts); Pass++)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.bNoCollisionFail = true;
+
+		TArray<APawn*> Dummies;
+		for (int32 i = 0; i < ActorCounts[Pass]; i++)
+		{
+			const float Angle = 2.0f * PI * i / ActorCounts[Pass];
+			const FVector Location = Origin + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius * 0.5f;
+			APawn* Dummy = MyPC->GetWorld()->SpawnActor<APawn>(MyGame->DefaultPawnClass, Location, FRotator::ZeroRotator, SpawnInfo);
+			if (Dummy)
+			{
+				Dummies.Add(Dummy);
+			}
+		}
+
+		const int32 StartQueries = GShooterSceneQueries;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumExplosions; i++)
+		{
+			// no damage, only the cost of finding and tracing the victims
+			UMakeshiftGameplayStatics::ApplyRadialDamageWithFalloffWithShieldDamage(MyPawn, 0.0f, 0.0f, Origin, 0.0f, Radius, 1.0f, NULL, IgnoreActors, NULL, MyPC, ECC_Camera, 0.0f, 0.0f);
+		}
+		const double PassTime = FPlatformTime::Seconds() - StartTime;
+		const int32 NumQueries = GShooterSceneQueries - StartQueries;
+
+		for (int32 i = 0; i < Dummies.Num(); i++)
+		{
+			Dummies[i]->Destroy();
+		}
+
+		const FString Result = FString::Printf(TEXT("%d actors: %.3f ms and %.1f scene queries per explosion"),
+			Dummies.Num(), PassTime * 1000.0 / NumExplosions, (float)NumQueries / NumExplosions);
+		UE_LOG(LogShooter, Log, TEXT("BenchRadialDamage: %s"), *Result);
+		MyPC->ClientMessage(Result);
+	}
+}
+
+/** bits the packed state takes on the wire, -1 if it doesn't read back the same */
+template<typename TState>
+static int32 GetNetStateBits(TState& State)
+{
+	bool bWriteSuccess = false;
+	FBitWriter Writer(0, true);
+	State.NetSerialize(Writer, NULL, bWriteSuccess);
+
+	bool bReadSuccess = false;
+	TState ReadState;
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	ReadState.NetSerialize(Reader, NULL, bReadSuccess);
+
+	return (bWriteSuccess && bReadSuccess && ReadState == State) ? (int32)Writer.GetNumBits() : -1;
+}
+
+/** append the sample's size to Result, false if it is over BudgetBits or doesn't read back the same */
+template<typename TState>
+static bool CheckNetStateBits(const TCHAR* Name, TState& State, int32 BudgetBits, FString& Result)
+{
+	const int32 Bits = GetNetStateBits(State);
+	if (Bits < 0)
+	{
+		UE_LOG(LogShooter, Error, TEXT("WeaponNetStateSize: %s state doesn't read back the same"), Name);
+	}
+
+	Result += FString::Printf(TEXT("%s%s %d/%d"), Result.IsEmpty() ? TEXT("") : TEXT(", "), Name, Bits, BudgetBits);
+	return Bits >= 0 && Bits <= BudgetBits;
+}
+
+void UShooterCheatManager::WeaponNetStateSize()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+
+	// separate properties: three int32 counters, float zoom and charge, reload bit / two int32 ammo counts and float charge
+	const int32 UnpackedBits = (3 * sizeof(int32) + 2 * sizeof(float)) * 8 + 1;
+	const int32 UnpackedOwnerBits = (2 * sizeof(int32) + sizeof(float)) * 8;
+
+	FShooterWeaponNetState Idle;
+
+	FShooterWeaponNetState Firing;
+	Firing.BurstCounter = FShooterWeaponNetState::PackCounter(37);
+	Firing.ZoomLevel = 1;
+
+	FShooterWeaponNetState Busy;
+	Busy.BurstCounter = FShooterWeaponNetState::PackCounter(300);
+	Busy.MeleeCounter = FShooterWeaponNetState::PackCounter(3);
+	Busy.GrenadeCounter = FShooterWeaponNetState::PackCounter(1);
+	Busy.ZoomLevel = 2;
+	Busy.Charge = FShooterWeaponNetState::PackCharge(74.5f);
+	Busy.bPendingReload = true;
+
+	FShooterWeaponOwnerState OwnerFull;
+	OwnerFull.Ammo = 90;
+	OwnerFull.AmmoInClip = 30;
+
+	FShooterWeaponOwnerState OwnerLarge;
+	OwnerLarge.Ammo = 999;
+	OwnerLarge.AmmoInClip = 200;
+	OwnerLarge.Charge = FShooterWeaponNetState::PackCharge(100.0f);
+
+	// budgets: flags byte plus one byte per set field / one byte per ammo count below 128, two below 16384, plus charge
+	FString Result;
+	bool bPassed = CheckNetStateBits(TEXT("idle"), Idle, 8, Result);
+	bPassed = CheckNetStateBits(TEXT("firing"), Firing, 16, Result) && bPassed;
+	bPassed = CheckNetStateBits(TEXT("busy"), Busy, 40, Result) && bPassed;
+	bPassed = CheckNetStateBits(TEXT("owner"), OwnerFull, 24, Result) && bPassed;
+	bPassed = CheckNetStateBits(TEXT("owner large"), OwnerLarge, 40, Result) && bPassed;
+
+	Result += FString::Printf(TEXT(" bits (unpacked remote %d, owner %d): %s"), UnpackedBits, UnpackedOwnerBits, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+	UE_LOG(LogShooter, Log, TEXT("WeaponNetStateSize: %s"), *Result);
+	MyPC->ClientMessage(Result);
+}
+
+void UShooterCheatManager::SpreadPatternChecksum()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+
+	const uint32 Checksum = FShooterSpreadPattern::GetChecksum(1024, 8);
+	const FString Result = FString::Printf(TEXT("spread pattern checksum 0x%08X, reference 0x%08X: %s"),
+		Checksum, FShooterSpreadPattern::ReferenceChecksum, Checksum == FShooterSpreadPattern::ReferenceChecksum ? TEXT("match") : TEXT("MISMATCH"));
+	UE_LOG(LogShooter, Log, TEXT("SpreadPatternChecksum: %s"), *Result);
+	MyPC->ClientMessage(Result);
+}
+
+void UShooterCheatManager::BenchHUDText(int32 NumIterations)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterHUD* const MyHUD = Cast<AShooterHUD>(MyPC->GetHUD());
+	if (MyHUD)
+	{
+		// runs from the next DrawHUD, when there is a canvas to measure with
+		MyHUD->BenchmarkTextDraw(NumIterations);
+	}
+}
+
+void UShooterCheatManager::ReloadWeaponTuning()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	UShooterWeaponTuning* const Tuning = UShooterWeaponTuning::Get(MyPC->GetWorld());
+	if (Tuning == NULL || MyPC->Role < ROLE_Authority)
+	{
+		return;
+	}
+
+	const FString Result = Tuning->ReloadFromSource(MyPC->GetWorld());
+	UE_LOG(LogShooter, Log, TEXT("ReloadWeaponTuning: %s"), *Result);
+	MyPC->ClientMessage(Result);
+}
+
+/** largest allowed distance between a rewound box center and the scripted position, in uu */
+static const float HitboxRewindTolerance = 1.0f;
+
+/** scripted pawn position: runs forward at 600 uu/s while strafing +-100 uu once per second */
+static FVector GetHitboxRewindPathLocation(float Time)
+{
+	return FVector(600.0f * Time, 100.0f * FMath::Sin(2.0f * PI * Time), 0.0f);
+}
+
+void UShooterCheatManager::HitboxRewindAccuracy()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	const AShooterCharacter* const DefaultPawn = GetDefault<AShooterCharacter>();
+	const float Interval = DefaultPawn->LagCompensationSnapshotInterval;
+	if (Interval <= 0.0f)
+	{
+		return;
+	}
+
+	// record the path the same way the server does, starting at an odd time so snapshots don't line up with the rewinds
+	const FVector Extent(34.0f, 34.0f, 88.0f);
+	FShooterHitboxHistory History;
+	History.Init(FMath::CeilToInt(DefaultPawn->LagCompensationMaxRewind / Interval) + 1);
+
+	float Now = 3.017f;
+	for (int32 Idx = 0; Idx < 120; Idx++, Now += Interval)
+	{
+		History.Add(Now, FBox::BuildAABB(GetHitboxRewindPathLocation(Now), Extent));
+	}
+	Now -= Interval;
+
+	const float Rewinds[] = { 0.05f, 0.1f, 0.2f };
+	bool bPassed = true;
+	FString Result;
+	for (int32 Idx = 0; Idx < ARRAY_COUNT(Rewinds); Idx++)
+	{
+		const float Time = Now - Rewinds[Idx];
+		FBox Box(0);
+		float Error = -1.0f;
+		if (History.GetBoxAtTime(Time, Box))
+		{
+			Error = FVector::Dist(Box.GetCenter(), GetHitboxRewindPathLocation(Time));
+		}
+
+		const bool bSamplePassed = Error >= 0.0f && Error <= HitboxRewindTolerance;
+		bPassed = bPassed && bSamplePassed;
+		Result += FString::Printf(TEXT("%s%.0f ms: %.3f uu"), Idx > 0 ? TEXT(", ") : TEXT(""), Rewinds[Idx] * 1000.0f, Error);
+	}
+
+	Result += FString::Printf(TEXT(" (tolerance %.1f uu): %s"), HitboxRewindTolerance, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+	UE_LOG(LogShooter, Log, TEXT("HitboxRewindAccuracy: %s"), *Result);
+	MyPC->ClientMessage(Result);
+}
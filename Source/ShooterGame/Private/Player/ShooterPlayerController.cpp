@@ -261,6 +261,39 @@ void AShooterPlayerController::ClientSetSpectatorCamera_Implementation(FVector C
 	SetViewTarget(this);
 }
 
+void AShooterPlayerController::ClientBeginWeaponTuning_Implementation(bool bFromCooked)
+{
+	UShooterWeaponTuning* Tuning = UShooterWeaponTuning::Get(GetWorld());
+	if (Tuning && Role < ROLE_Authority)
+	{
+		Tuning->BeginServerRows(bFromCooked);
+	}
+}
+
+void AShooterPlayerController::ClientAddWeaponTuningRows_Implementation(const FString& RowsCSV)
+{
+	UShooterWeaponTuning* Tuning = UShooterWeaponTuning::Get(GetWorld());
+	if (Tuning == NULL || Role == ROLE_Authority)
+	{
+		return;
+	}
+
+	TArray<FString> Problems;
+	if (!Tuning->AddServerRows(RowsCSV, Problems))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Weapon tuning rows from server rejected: %s"), Problems.Num() ? *Problems[0] : TEXT("no rows"));
+	}
+}
+
+void AShooterPlayerController::ClientEndWeaponTuning_Implementation()
+{
+	UShooterWeaponTuning* Tuning = UShooterWeaponTuning::Get(GetWorld());
+	if (Tuning && Role < ROLE_Authority)
+	{
+		Tuning->EndServerRows();
+	}
+}
+
 bool AShooterPlayerController::FindDeathCameraSpot(FVector& CameraLocation, FRotator& CameraRotation)
 {
 	const FVector PawnLocation = GetPawn()->GetActorLocation();
@@ -278,6 +311,7 @@ bool AShooterPlayerController::FindDeathCameraSpot(FVector& CameraLocation, FRot
 		CameraDir.Normalize();
 
 		const FVector TestLocation = PawnLocation - CameraDir.Vector() * CameraOffset;
+		SHOOTER_COUNT_SCENE_QUERY();
 		const bool bBlocked = GetWorld()->LineTraceTest(PawnLocation, TestLocation, ECC_Camera, TraceParams);
 
 		if (!bBlocked)
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+
+#if SHOOTER_DEBUG_MESSAGES
+
+static TAutoConsoleVariable<int32> CVarDebugVerbosity(
+	TEXT("Shooter.DebugVerbosity"),
+	0,
+	TEXT("Gameplay debug messages to record.\n")
+	TEXT(" 0: none (default)\n")
+	TEXT(" 1: log\n")
+	TEXT(" 2: verbose"));
+
+static TAutoConsoleVariable<int32> CVarDebugCategories(
+	TEXT("Shooter.DebugCategories"),
+	0xff,
+	TEXT("Bit mask of gameplay debug categories to record.\n")
+	TEXT(" 1: damage, 2: weapon, 4: pickup, 8: movement"));
+
+static TAutoConsoleVariable<int32> CVarDebugOnScreen(
+	TEXT("Shooter.DebugOnScreen"),
+	0,
+	TEXT("Show recorded gameplay debug messages on screen."));
+
+static FAutoConsoleCommand CmdDumpDebugMessages(
+	TEXT("Shooter.DumpDebugMessages"),
+	TEXT("Write recorded gameplay debug messages to the log."),
+	FConsoleCommandDelegate::CreateStatic(&FShooterDebugChannel::DumpToLog)
+	);
+
+static const TCHAR* DebugCategoryNames[] = { TEXT("Damage"), TEXT("Weapon"), TEXT("Pickup"), TEXT("Movement") };
+static_assert(ARRAY_COUNT(DebugCategoryNames) == EShooterDebug::MAX, "Missing debug category name");
+
+FShooterDebugMessage FShooterDebugChannel::Ring[FShooterDebugChannel::RingSize];
+FThreadSafeCounter FShooterDebugChannel::WriteCount;
+uint32 FShooterDebugChannel::ScreenReadCount = 0;
+
+bool FShooterDebugChannel::IsEnabled(EShooterDebug::Type Category, EShooterDebugVerbosity::Type Verbosity)
+{
+	return CVarDebugVerbosity.GetValueOnGameThread() >= Verbosity && (CVarDebugCategories.GetValueOnGameThread() & (1 << Category)) != 0;
+}
+
+void FShooterDebugChannel::Push(EShooterDebug::Type Category, const FColor& Color, const TCHAR* Text)
+{
+	Add(Category, Color, Text, 0.0f, false);
+}
+
+void FShooterDebugChannel::Push(EShooterDebug::Type Category, const FColor& Color, const TCHAR* Text, float Value)
+{
+	Add(Category, Color, Text, Value, true);
+}
+
+void FShooterDebugChannel::Add(EShooterDebug::Type Category, const FColor& Color, const TCHAR* Text, float Value, bool bHasValue)
+{
+	// claim a slot, a reader racing a writer on the same slot can only show a mixed up debug line
+	const uint32 Index = ((uint32)WriteCount.Increment() - 1) & (RingSize - 1);
+
+	FShooterDebugMessage& Message = Ring[Index];
+	Message.Text = Text;
+	Message.Value = Value;
+	Message.Time = FPlatformTime::Seconds();
+	Message.Color = Color;
+	Message.Category = Category;
+	Message.bHasValue = bHasValue;
+}
+
+FString FShooterDebugChannel::Format(const FShooterDebugMessage& Message)
+{
+	if (Message.bHasValue)
+	{
+		return FString::Printf(TEXT("[%s] %s %f"), DebugCategoryNames[Message.Category], Message.Text, Message.Value);
+	}
+
+	return FString::Printf(TEXT("[%s] %s"), DebugCategoryNames[Message.Category], Message.Text);
+}
+
+void FShooterDebugChannel::FlushToScreen()
+{
+	const uint32 Written = (uint32)WriteCount.GetValue();
+	if (CVarDebugOnScreen.GetValueOnGameThread() == 0 || GEngine == NULL)
+	{
+		ScreenReadCount = Written;
+		return;
+	}
+
+	// skip what was overwritten already, unsigned differences stay right when WriteCount wraps
+	const uint32 NumNew = FMath::Min<uint32>(Written - ScreenReadCount, RingSize);
+	for (uint32 i = Written - NumNew; i != Written; i++)
+	{
+		const FShooterDebugMessage& Message = Ring[i & (RingSize - 1)];
+		GEngine->AddOnScreenDebugMessage(-1, 5.0f, Message.Color, Format(Message));
+	}
+
+	ScreenReadCount = Written;
+}
+
+void FShooterDebugChannel::DumpToLog()
+{
+	const uint32 Written = (uint32)WriteCount.GetValue();
+	const double Now = FPlatformTime::Seconds();
+
+	const uint32 NumStored = FMath::Min<uint32>(Written, RingSize);
+	for (uint32 i = Written - NumStored; i != Written; i++)
+	{
+		const FShooterDebugMessage& Message = Ring[i & (RingSize - 1)];
+		UE_LOG(LogShooter, Log, TEXT("%.3fs ago %s"), Now - Message.Time, *Format(Message));
+	}
+}
+
+#endif // SHOOTER_DEBUG_MESSAGES
@@ -82,6 +82,7 @@ UShooterGameInstance::UShooterGameInstance(const FObjectInitializer& ObjectIniti
 	, bIsLicensed(true) // Default to licensed (should have been checked by OS on boot)
 {
 	CurrentState = ShooterGameInstanceState::None;
+	WeaponTuning = NULL;
 }
 
 void UShooterGameInstance::Init()
@@ -91,6 +92,9 @@ void UShooterGameInstance::Init()
 	IgnorePairingChangeForControllerId = -1;
 	CurrentConnectionStatus = EOnlineServerConnectionStatus::Connected;
 
+	WeaponTuning = ConstructObject<UShooterWeaponTuning>(UShooterWeaponTuning::StaticClass(), this);
+	WeaponTuning->LoadTable();
+
 	// game requires the ability to ID users.
 	const auto OnlineSub = IOnlineSubsystem::Get();
 	check(OnlineSub);
@@ -632,6 +636,12 @@ void UShooterGameInstance::BeginMainMenuState()
 
 	SetIsOnline(false);
 
+	// drop weapon stats a server sent us
+	if (WeaponTuning)
+	{
+		WeaponTuning->RevertToCooked();
+	}
+
 	// Disallow splitscreen
 	GetGameViewportClient()->SetDisableSplitscreenOverride( true );
 
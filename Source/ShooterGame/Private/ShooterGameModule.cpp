@@ -39,3 +39,8 @@ IMPLEMENT_PRIMARY_GAME_MODULE(FShooterGameModule, ShooterGame, "Makeshift2");
 
 DEFINE_LOG_CATEGORY(LogShooter)
 DEFINE_LOG_CATEGORY(LogShooterWeapon)
+
+int32 GShooterSceneQueries = 0;
+
+DEFINE_STAT(STAT_ShooterSceneQueries);
+DEFINE_STAT(STAT_ShooterShotsFired);
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/ShooterTraceQueue.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async traces"), STAT_ShooterAsyncTraces, STATGROUP_ShooterGame);
+
+static TAutoConsoleVariable<int32> CVarAsyncTraces(
+	TEXT("Shooter.AsyncTraces"),
+	1,
+	TEXT("Run non critical gameplay traces (bot line of sight, client explosion surfaces) on the async trace queue.\n")
+	TEXT(" 0: off, trace right away on the game thread\n")
+	TEXT(" 1: on, results arrive next frame (default)"));
+
+UShooterTraceQueue::UShooterTraceQueue(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	TraceDoneDelegate.BindUObject(this, &UShooterTraceQueue::OnTraceDone);
+	NextRequestId = 1;
+}
+
+UShooterTraceQueue* UShooterTraceQueue::Get(UWorld* World)
+{
+	AShooterGameState* const MyGameState = World ? Cast<AShooterGameState>(World->GameState) : NULL;
+	if (MyGameState == NULL)
+	{
+		return NULL;
+	}
+
+	if (MyGameState->TraceQueue == NULL)
+	{
+		MyGameState->TraceQueue = ConstructObject<UShooterTraceQueue>(UShooterTraceQueue::StaticClass(), MyGameState);
+	}
+
+	return MyGameState->TraceQueue;
+}
+
+void UShooterTraceQueue::LineTrace(UWorld* World, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FShooterTraceResult& OnResult)
+{
+	if (World == NULL)
+	{
+		return;
+	}
+
+	UShooterTraceQueue* Queue = CVarAsyncTraces.GetValueOnGameThread() ? Get(World) : NULL;
+	if (Queue)
+	{
+		Queue->QueueLineTrace(World, Start, End, TraceChannel, Params, OnResult);
+		return;
+	}
+
+	FHitResult Hit(ForceInit);
+	SHOOTER_COUNT_SCENE_QUERY();
+	World->LineTraceSingle(Hit, Start, End, TraceChannel, Params);
+	OnResult.ExecuteIfBound(Hit);
+}
+
+void UShooterTraceQueue::QueueLineTrace(UWorld* World, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, const FShooterTraceResult& OnResult)
+{
+	const uint32 RequestId = NextRequestId++;
+	if (NextRequestId == 0)
+	{
+		// zero is the engine's "no user data"
+		NextRequestId = 1;
+	}
+
+	PendingResults.Add(RequestId, OnResult);
+	World->AsyncLineTrace(Start, End, TraceChannel, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDoneDelegate, RequestId);
+	INC_DWORD_STAT(STAT_ShooterAsyncTraces);
+}
+
+void UShooterTraceQueue::OnTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FShooterTraceResult OnResult;
+	if (!PendingResults.RemoveAndCopyValue(TraceDatum.UserData, OnResult))
+	{
+		return;
+	}
+
+	FHitResult Hit(ForceInit);
+	for (int32 i = 0; i < TraceDatum.OutHits.Num(); i++)
+	{
+		if (TraceDatum.OutHits[i].bBlockingHit)
+		{
+			Hit = TraceDatum.OutHits[i];
+			break;
+		}
+	}
+
+	OnResult.ExecuteIfBound(Hit);
+}
+
+int32 UShooterTraceQueue::GetNumPending() const
+{
+	return PendingResults.Num();
+}
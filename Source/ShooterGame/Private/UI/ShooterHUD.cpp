@@ -5,9 +5,12 @@
 #include "SChatWidget.h"
 #include "Engine/ViewportSplitScreen.h"
 
+DECLARE_CYCLE_STAT(TEXT("HUD draw"), STAT_ShooterDrawHUD, STATGROUP_ShooterGame);
+
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
 const float AShooterHUD::MinHudScale = 0.5f;
+const int32 AShooterHUD::MaxDeathMessages = 5;
 
 AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -18,6 +21,7 @@ AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(Ob
 	NoAmmoNotifyTime = -NoAmmoFadeOutTime;
 	LastKillTime = - KillFadeOutTime;
 	LastEnemyHitTime = -LastEnemyHitDisplayTime;
+	PendingTextBenchmark = 0;
 
 	OnPlayerTalkingStateChangedDelegate = FOnPlayerTalkingStateChangedDelegate::CreateUObject(this, &AShooterHUD::OnPlayerTalkingStateChanged);
 
@@ -337,43 +341,50 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 	{
 		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 		TextItem.EnableShadow( FLinearColor::Black );
-		float SizeX, SizeY;
 		float TextScale = 0.57f;
-		FString Text;
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.Scale = FVector2D( TextScale*ScaleUI, TextScale*ScaleUI );
 		if (MyGameState->GetMatchState() == MatchState::WaitingToStart)
 		{
+			// strings only change when the second rolls over
+			if (WarmupText.IsStale(MyGameState->RemainingTime))
+			{
+				WarmupText.SetString(LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime));
+			}
+
 			TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-			Text = LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime);
 			TextItem.SetColor( HUDLight );
-			TextItem.Text = FText::FromString( Text );			
+			TextItem.Text = WarmupText.GetText();
 			AddMatchInfoString(TextItem);
 		}
 		else if (MyGameState->GetMatchState() == MatchState::InProgress)
 		{
-			Text = GetTimeString(MyGameState->RemainingTime);
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			if (TimerText.IsStale(MyGameState->RemainingTime))
+			{
+				TimerText.SetString(GetTimeString(MyGameState->RemainingTime));
+			}
+			const FVector2D& TimerSize = TimerText.GetSize(Canvas, BigFont);
 
 			TextItem.SetColor( HUDDark );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = TimerText.GetText();
 			TextItem.Position = FVector2D( TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
-				TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				TimerPosY + (TimePlaceBg.VL * ScaleUI - TimerSize.Y * TextScale * ScaleUI) / 2 );
 			Canvas->DrawItem(TextItem);
 		}
 
 		float BoxWidth = 45.0f * ScaleUI;
-		Text = FString();
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
 		if (MyPC && MyGameState && MatchState == EShooterMatchState::Playing)
 		{
 			AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyPC->PlayerState);
 			if (MyPlayerState)
 			{
+				int32 MyPos = 0;
+				int32 NumPlaces = 0;
 				if (MyGameState->NumTeams > 1) // team based game
 				{
 					int32 MyTeam = MyPlayerState->GetTeamNum();
-					int32 MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
+					MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
 					for (int32 i=0; i < MyGameState->TeamScores.Num(); i++)
 					{
 						if (MyGameState->TeamScores.Num() > MyTeam &&
@@ -382,36 +393,40 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 							MyPos--;
 						}
 					}
-					int32 NumTeams = 0;
 					for (int32 i=0; i < MyGameState->NumTeams; i++)
 					{
 						RankedPlayerMap PlayerStateMap;
 						MyGameState->GetRankedMap(i,PlayerStateMap);
 						if(PlayerStateMap.Num() > 0)
 						{
-							NumTeams++;
+							NumPlaces++;
 						}
 					}
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, NumTeams);
 				}
 				else // free for all
 				{
 					RankedPlayerMap PlayerStateMap;
 					MyGameState->GetRankedMap(0,PlayerStateMap);
 					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					MyPos = MyRank ? *MyRank + 1 : 0;
+					NumPlaces = PlayerStateMap.Num();
+				}
+
+				if (PlaceText.IsStale((MyPos << 16) | NumPlaces))
+				{
+					PlaceText.SetString(FString::Printf(TEXT("%d/%d"), MyPos, NumPlaces));
 				}
-				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+				const FVector2D& PlaceSize = PlaceText.GetSize(Canvas, BigFont);
+
 				Canvas->DrawIcon(PlaceIcon,
-					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (SizeX * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
+					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (PlaceSize.X * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
 					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI);
 
-				TextItem.Text = FText::FromString( Text);
+				TextItem.Text = PlaceText.GetText();
 				TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 				TextItem.FontRenderInfo = ShadowedFont;
-				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + SizeX * TextScale * ScaleUI),
-					TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + PlaceSize.X * TextScale * ScaleUI),
+					TimerPosY + (TimePlaceBg.VL * ScaleUI - PlaceSize.Y * TextScale * ScaleUI) / 2 );
 			}
 		}
 	}
@@ -476,7 +491,8 @@ void AShooterHUD::NotifyEnemyHit()
 
 void AShooterHUD::DrawHUD()
 {
-	
+	SCOPE_CYCLE_COUNTER(STAT_ShooterDrawHUD);
+
 	Super::DrawHUD();
 	if (Canvas == nullptr)
 	{
@@ -484,6 +500,10 @@ void AShooterHUD::DrawHUD()
 	}
 	ScaleUI = Canvas->ClipY / 1080.0f;
 
+#if SHOOTER_DEBUG_MESSAGES
+	FShooterDebugChannel::FlushToScreen();
+#endif
+
 	// make any adjustments for splitscreen
 	int32 SSPlayerIndex = 0;
 	if ( PlayerOwner && PlayerOwner->IsSplitscreenPlayer(&SSPlayerIndex) )
@@ -617,6 +637,77 @@ void AShooterHUD::DrawHUD()
 	DrawDeathMessages();
 	DrawHitIndicator();
 	DrawMatchTimerAndPosition();
+
+	if (PendingTextBenchmark > 0)
+	{
+		RunTextBenchmark();
+	}
+}
+
+void AShooterHUD::BenchmarkTextDraw(int32 NumIterations)
+{
+	PendingTextBenchmark = FMath::Clamp(NumIterations, 1, 10000);
+}
+
+void AShooterHUD::InvalidateTextCache()
+{
+	KilledText.Invalidate();
+	TimerText.Invalidate();
+	WarmupText.Invalidate();
+	PlaceText.Invalidate();
+	for (int32 i = 0; i < DeathMessages.Num(); i++)
+	{
+		DeathMessages[i].KillerText.Invalidate();
+		DeathMessages[i].VictimText.Invalidate();
+	}
+}
+
+void AShooterHUD::RunTextBenchmark()
+{
+	const int32 NumIterations = PendingTextBenchmark;
+	PendingTextBenchmark = 0;
+
+	// full feed of long names
+	TArray<FDeathMessage> SavedMessages = DeathMessages;
+	DeathMessages.Reset();
+	for (int32 i = 0; i < MaxDeathMessages; i++)
+	{
+		FDeathMessage Message;
+		Message.KillerDesc = FString::Printf(TEXT("WWWWWWWWWWWWWWW%d"), i);
+		Message.VictimDesc = FString::Printf(TEXT("MMMMMMMMMMMMMMM%d"), i);
+		Message.KillerTeamNum = i % 2;
+		Message.VictimTeamNum = (i + 1) % 2;
+		DeathMessages.Add(Message);
+	}
+
+	// uncached redoes every string each draw, like the HUD did before the text cache
+	double PassTime[2];
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		InvalidateTextCache();
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; i++)
+		{
+			if (Pass == 0)
+			{
+				InvalidateTextCache();
+			}
+			DrawDeathMessages();
+			DrawMatchTimerAndPosition();
+		}
+		PassTime[Pass] = FPlatformTime::Seconds() - StartTime;
+	}
+
+	DeathMessages = SavedMessages;
+
+	const FString Result = FString::Printf(TEXT("%d draws of %d death messages and timer: uncached %.3f us, cached %.3f us per draw"),
+		NumIterations, MaxDeathMessages, PassTime[0] * 1000000.0 / NumIterations, PassTime[1] * 1000000.0 / NumIterations);
+	UE_LOG(LogShooter, Log, TEXT("BenchHUDText: %s"), *Result);
+	if (PlayerOwner)
+	{
+		PlayerOwner->ClientMessage(Result);
+	}
 }
 
 void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
@@ -758,8 +849,10 @@ void AShooterHUD::DrawDeathMessages()
 	const FColor RedTeamColor = FColor(152, 70, 70, 255);
 	const FColor OwnerColor = HUDLight;
 
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
+	if (!KilledText.IsSet())
+	{
+		KilledText.SetString(LOCTEXT("killed"," killed ").ToString());
+	}
 
 	const float GameTime = GetWorld()->GetTimeSeconds();
 	const float LinePadding = 6.0f;
@@ -771,23 +864,26 @@ void AShooterHUD::DrawDeathMessages()
 	// draw messages
 	float CurrentY = InitialY;
 
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
+	const FVector2D KilledTextSize = KilledText.GetSize(Canvas, NormalFont);
 
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
 	{
-		const FDeathMessage& Message = DeathMessages[i];
+		FDeathMessage& Message = DeathMessages[i];
 		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
 		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
+
+		// text is converted and measured once per message
+		Message.KillerText.SetString(Message.KillerDesc);
+		Message.VictimText.SetString(Message.VictimDesc);
+		const FVector2D& KillerSize = Message.KillerText.GetSize(Canvas, NormalFont);
+
 		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
 
-		TextItem.Text = FText::FromString( Message.KillerDesc );
+		TextItem.Text = Message.KillerText.GetText();
 		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
 		CurrentX += KillerSize.X * TextScale * ScaleUI;
 		
@@ -802,7 +898,7 @@ void AShooterHUD::DrawDeathMessages()
 		}
 		else
 		{
-			TextItem.Text = FText::FromString( KilledText );
+			TextItem.Text = KilledText.GetText();
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDDark);
@@ -813,8 +909,7 @@ void AShooterHUD::DrawDeathMessages()
 			
 		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
 
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
+		TextItem.Text = Message.VictimText.GetText();
 		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
 		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 	}
@@ -822,7 +917,6 @@ void AShooterHUD::DrawDeathMessages()
 
 void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType)
 {
-	const int32 MaxDeathMessages = 5;
 	const float MessageDuration = 10.0f;
 
 	if (GetWorld()->GameState && GetWorld()->GameState->GameModeClass)
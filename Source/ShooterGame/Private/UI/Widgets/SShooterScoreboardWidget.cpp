@@ -26,6 +26,7 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
+	LastRankingVersion = 0;
 
 	UpdatePlayerStateMaps();
 	
@@ -263,10 +264,12 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 	if (PCOwner.IsValid())
 	{
 		AShooterGameState* const GameState = Cast<AShooterGameState>(PCOwner->GetWorld()->GameState);
-		if (GameState)
+		const int32 NumTeams = GameState ? FMath::Max(GameState->NumTeams, 1) : 0;
+		if (GameState && (GameState->GetRankingVersion() != LastRankingVersion || PlayerStateMaps.Num() != NumTeams))
 		{
+			LastRankingVersion = GameState->GetRankingVersion();
+
 			bool bRequiresWidgetUpdate = false;
-			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
 			LastTeamPlayerCount.Reset();
 			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
 			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
@@ -216,12 +216,15 @@ protected:
 	/** the player currently selected in the scoreboard */
 	FTeamPlayer SelectedPlayer;
 
-	/** the Ranked PlayerState map...cleared every frame */
+	/** the Ranked PlayerState map...rebuilt when the ranking changes */
 	TArray<RankedPlayerMap> PlayerStateMaps;
 
 	/** player count in each team in the last tick */
 	TArray<int32> LastTeamPlayerCount;
 
+	/** game state ranking version PlayerStateMaps were built from */
+	uint32 LastRankingVersion;
+
 	/** holds talking player data */
 	TArray<TPair<FString, bool>> PlayersTalkingThisFrame;
 
@@ -38,6 +38,7 @@ AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializ
 	bReplicateMovement = true;
 
 	bHasBounced = false;
+	RecycleCount = 0;
 }
 
 void AShooterProjectile::PostInitializeComponents()
@@ -53,6 +54,23 @@ void AShooterProjectile::PostInitializeComponents()
 		MovementComp->OnProjectileStop.AddDynamic(this, &AShooterProjectile::OnImpact);
 	}
 
+	InitShotState();
+}
+
+float AShooterProjectile::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, InChannel, Time, bLowBandwidth);
+	if (!AShooterCharacter::IsNetAdaptiveRelevancyEnabled())
+	{
+		return Priority;
+	}
+
+	return Priority * NetPriorityFalloff.GetScale((GetActorLocation() - ViewPos).SizeSquared());
+}
+
+void AShooterProjectile::InitShotState()
+{
+	CollisionComp->MoveIgnoreActors.Reset();
 	CollisionComp->MoveIgnoreActors.Add(Instigator);
 
 	AShooterWeapon_Projectile* OwnerWeapon = Cast<AShooterWeapon_Projectile>(GetOwner());
@@ -60,15 +78,23 @@ void AShooterProjectile::PostInitializeComponents()
 	{
 		OwnerWeapon->ApplyWeaponConfig(WeaponConfig);
 	}
+	else
+	{
+		// a pooled projectile may still hold the config of the weapon that fired it last
+		WeaponConfig = GetClass()->GetDefaultObject<AShooterProjectile>()->WeaponConfig;
+	}
 
-	SetLifeSpan(WeaponConfig.ProjectileLife);
+	// lifespan would destroy the actor, a timer lets it go back to the pool instead
+	if (Role == ROLE_Authority && WeaponConfig.ProjectileLife > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(this, &AShooterProjectile::ReleaseOrDestroy, WeaponConfig.ProjectileLife, false);
+	}
 	MyController = GetInstigatorController();
 
 	if (bUseSafety)
 	{
 		GetWorldTimerManager().SetTimer(this, &AShooterProjectile::ExpireSafety, SafetyTimer, false);
 	}
-
 }
 
 void AShooterProjectile::InitVelocity(FVector& ShootDirection)
@@ -79,6 +105,109 @@ void AShooterProjectile::InitVelocity(FVector& ShootDirection)
 	}
 }
 
+AShooterProjectile* AShooterProjectile::SpawnProjectile(AActor* SpawnOwner, TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTM, FVector ShootDirection)
+{
+	if (SpawnOwner == NULL || ProjectileClass == NULL)
+	{
+		return NULL;
+	}
+
+	AShooterGameMode* MyGame = SpawnOwner->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	AShooterProjectile* Projectile = MyGame ? MyGame->AcquirePooledProjectile(ProjectileClass) : NULL;
+	if (Projectile)
+	{
+		Projectile->ActivateFromPool(SpawnOwner, SpawnOwner->Instigator, SpawnTM);
+		Projectile->InitVelocity(ShootDirection);
+		return Projectile;
+	}
+
+	Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(SpawnOwner, ProjectileClass, SpawnTM));
+	if (Projectile)
+	{
+		Projectile->Instigator = SpawnOwner->Instigator;
+		Projectile->SetOwner(SpawnOwner);
+		Projectile->InitVelocity(ShootDirection);
+
+		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+	}
+
+	return Projectile;
+}
+
+void AShooterProjectile::ActivateFromPool(AActor* NewOwner, APawn* NewInstigator, const FTransform& SpawnTM)
+{
+	SetNetDormancy(DORM_Awake);
+
+	Instigator = NewInstigator;
+	SetOwner(NewOwner);
+	SetActorLocationAndRotation(SpawnTM.GetLocation(), SpawnTM.Rotator());
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	bExploded = false;
+	bHasBounced = false;
+	bSafetyExpired = false;
+	bWantsToExplode = false;
+	MyImpact = FHitResult();
+
+	// let clients know they have to reset their copy too
+	RecycleCount++;
+
+	ResetSimulation();
+	InitShotState();
+}
+
+void AShooterProjectile::ParkInPool()
+{
+	AShooterWeapon* OwnerWeapon = Cast<AShooterWeapon>(GetOwner());
+	if (OwnerWeapon && OwnerWeapon->ActiveProjectile == this)
+	{
+		OwnerWeapon->ActiveProjectile = NULL;
+	}
+
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	MovementComp->StopMovementImmediately();
+
+	SetOwner(NULL);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	// hidden state goes out with the last update before the channel sleeps
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AShooterProjectile::ReleaseOrDestroy()
+{
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame == NULL || !MyGame->ReleasePooledProjectile(this))
+	{
+		Destroy();
+	}
+}
+
+void AShooterProjectile::ResetSimulation()
+{
+	// projectile movement lets go of its updated component when it stops
+	MovementComp->SetUpdatedComponent(CollisionComp);
+	MovementComp->Velocity = FVector::ZeroVector;
+
+	if (ParticleComp->bAutoActivate)
+	{
+		ParticleComp->Activate(true);
+	}
+
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp && ProjAudioComp->bAutoActivate)
+	{
+		ProjAudioComp->Play();
+	}
+}
+
+void AShooterProjectile::OnRep_RecycleCount()
+{
+	ResetSimulation();
+}
+
 void AShooterProjectile::OnImpact(const FHitResult& HitResult)
 {
 	if (bOnlyExplodeFromWeaponCall)
@@ -142,7 +271,7 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 	//GEngine->AddOnScreenDebugMessage(-1, 5.0, FColor::Magenta, BoneString);
 	if (Impact.BoneName == "b_head" || Impact.BoneName == "Head")
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Yellow, TEXT("PROJECTILE HEADSHOT"));
+		SHOOTER_DEBUG(Damage, Log, FColor::Yellow, TEXT("PROJECTILE HEADSHOT"));
 		FPointDamageEvent PDMG;
 		PDMG.DamageTypeClass = DamageType;
 		PDMG.HitInfo = Impact;
@@ -199,16 +328,10 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 			}
 		}
 	}
-	if (ExplosionTemplate)
+	AShooterEffectManager* EffectManager = AShooterEffectManager::Get(GetWorld());
+	if (EffectManager && ExplosionTemplate)
 	{
-
-		AShooterExplosionEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterExplosionEffect>(ExplosionTemplate, MyLocation, MyRotation, this, Instigator, false);
-
-		if (EffectActor)
-		{
-			UGameplayStatics::FinishSpawningActor(EffectActor, FTransform(MyRotation, MyLocation));
-			FVector VecToLog = EffectActor->GetActorLocation();
-		}
+		EffectManager->PlayExplosion(ExplosionTemplate, MyLocation, MyRotation, Impact);
 	}
 
 	bExploded = true;
@@ -225,22 +348,41 @@ void AShooterProjectile::DisableAndDestroy()
 	MovementComp->StopMovementImmediately();
 
 	// give clients some time to show explosion
-	SetLifeSpan( 2.0f );
+	GetWorldTimerManager().SetTimer(this, &AShooterProjectile::ReleaseOrDestroy, 2.0f, false);
 }
 
 void AShooterProjectile::OnRep_Exploded()
 {
-	FVector ProjDirection = GetActorRotation().Vector();
+	// cleared when reused from the pool
+	if (!bExploded)
+	{
+		return;
+	}
+
+	const FVector ProjDirection = GetActorRotation().Vector();
 
 	const FVector StartTrace = GetActorLocation() - ProjDirection * 200;
 	const FVector EndTrace = GetActorLocation() + ProjDirection * 150;
-	FHitResult Impact;
-	
-	if (!GetWorld()->LineTraceSingle(Impact, StartTrace, EndTrace, COLLISION_PROJECTILE, FCollisionQueryParams(TEXT("ProjClient"), true, Instigator)))
+
+	// only picks the surface for effects, can wait a frame
+	UShooterTraceQueue::LineTrace(GetWorld(), StartTrace, EndTrace, COLLISION_PROJECTILE, FCollisionQueryParams(TEXT("ProjClient"), true, Instigator),
+		FShooterTraceResult::CreateUObject(this, &AShooterProjectile::OnExplosionTrace, RecycleCount));
+}
+
+void AShooterProjectile::OnExplosionTrace(const FHitResult& Hit, uint8 ShotRecycleCount)
+{
+	// reused from the pool while the trace was queued
+	if (!bExploded || RecycleCount != ShotRecycleCount)
+	{
+		return;
+	}
+
+	FHitResult Impact = Hit;
+	if (!Impact.bBlockingHit)
 	{
 		// failsafe
 		Impact.ImpactPoint = GetActorLocation();
-		Impact.ImpactNormal = -ProjDirection;
+		Impact.ImpactNormal = -GetActorRotation().Vector();
 	}
 
 	Explode(Impact);
@@ -259,6 +401,7 @@ void AShooterProjectile::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
 	
 	DOREPLIFETIME( AShooterProjectile, bExploded );
+	DOREPLIFETIME( AShooterProjectile, RecycleCount );
 	DOREPLIFETIME(AShooterProjectile, bSafetyExpired);
 	DOREPLIFETIME(AShooterProjectile, bWantsToExplode);
 }
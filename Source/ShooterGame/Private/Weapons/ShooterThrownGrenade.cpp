@@ -90,14 +90,10 @@ void AShooterThrownGrenade::Explode(const FHitResult& Impact)
 		//UGameplayStatics::ApplyRadialDamageWithFalloff(this, GrenadeDamage, MinimumGrenadeDamage, MyLocation, MaxDamageRadius, ExplosionRadius, 1, GrenadeDamageType, TArray<AActor*>(), this, MyController.Get());
 		UGameplayStatics::ApplyRadialDamage(this, GrenadeDamage, MyLocation, ExplosionRadius, GrenadeDamageType, TArray<AActor*>(), this, MyController.Get());
 	}
-	if (ExplosionTemplate)
+	AShooterEffectManager* EffectManager = AShooterEffectManager::Get(GetWorld());
+	if (EffectManager && ExplosionTemplate)
 	{
-		AShooterExplosionEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterExplosionEffect>(ExplosionTemplate, MyLocation, MyRotation);
-
-		if (EffectActor)
-		{
-			UGameplayStatics::FinishSpawningActor(EffectActor, FTransform(MyRotation, MyLocation));
-		}
+		EffectManager->PlayExplosion(ExplosionTemplate, MyLocation, MyRotation, Impact);
 	}
 
 	bExploded = true;
@@ -2,6 +2,106 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon HandleFiring"), STAT_ShooterWeaponHandleFiring, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Weapon trace"), STAT_ShooterWeaponTrace, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Weapon magnetism"), STAT_ShooterWeaponMagnetism, STATGROUP_ShooterGame);
+
+namespace EWeaponNetStateFlags
+{
+	enum Type
+	{
+		PendingReload	= 1 << 0,
+		Burst			= 1 << 1,
+		Melee			= 1 << 2,
+		Grenade			= 1 << 3,
+		Charge			= 1 << 4,
+		// bits 5-7 hold the zoom level
+		ZoomShift		= 5,
+	};
+}
+
+uint8 FShooterWeaponNetState::PackCounter(int32 Counter)
+{
+	return Counter > 0 ? (uint8)((Counter - 1) % 255 + 1) : 0;
+}
+
+uint8 FShooterWeaponNetState::PackCharge(float Charge)
+{
+	return (uint8)FMath::Clamp(FMath::FloorToInt(Charge * 2.0f), 0, 255);
+}
+
+float FShooterWeaponNetState::UnpackCharge(uint8 PackedCharge)
+{
+	return PackedCharge * 0.5f;
+}
+
+bool FShooterWeaponNetState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
+	{
+		const uint8 PackedZoom = ZoomLevel < MaxZoomLevel ? ZoomLevel : MaxZoomLevel;
+		Flags = (uint8)((bPendingReload ? EWeaponNetStateFlags::PendingReload : 0)
+			| (BurstCounter ? EWeaponNetStateFlags::Burst : 0)
+			| (MeleeCounter ? EWeaponNetStateFlags::Melee : 0)
+			| (GrenadeCounter ? EWeaponNetStateFlags::Grenade : 0)
+			| (Charge ? EWeaponNetStateFlags::Charge : 0)
+			| (PackedZoom << EWeaponNetStateFlags::ZoomShift));
+	}
+
+	Ar << Flags;
+
+	if (Ar.IsLoading())
+	{
+		bPendingReload = (Flags & EWeaponNetStateFlags::PendingReload) != 0;
+		ZoomLevel = Flags >> EWeaponNetStateFlags::ZoomShift;
+		BurstCounter = 0;
+		MeleeCounter = 0;
+		GrenadeCounter = 0;
+		Charge = 0;
+	}
+
+	if (Flags & EWeaponNetStateFlags::Burst)
+	{
+		Ar << BurstCounter;
+	}
+	if (Flags & EWeaponNetStateFlags::Melee)
+	{
+		Ar << MeleeCounter;
+	}
+	if (Flags & EWeaponNetStateFlags::Grenade)
+	{
+		Ar << GrenadeCounter;
+	}
+	if (Flags & EWeaponNetStateFlags::Charge)
+	{
+		Ar << Charge;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FShooterWeaponOwnerState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedAmmo = FMath::Max(Ammo, 0);
+	uint32 PackedAmmoInClip = FMath::Max(AmmoInClip, 0);
+
+	Ar.SerializeIntPacked(PackedAmmo);
+	Ar.SerializeIntPacked(PackedAmmoInClip);
+	Ar << Charge;
+
+	if (Ar.IsLoading())
+	{
+		Ammo = (int32)PackedAmmo;
+		AmmoInClip = (int32)PackedAmmoInClip;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
 //changed stuff
 AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -32,8 +132,11 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	MeleeBoxNew->SetIsReplicated(true);
 	MeleeBoxNew->AttachParent = Mesh1P;
 	MeleeBoxNew->SetCollisionObjectType(ECC_WorldDynamic);
-	MeleeBoxNew->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	MeleeBoxNew->SetCollisionResponseToAllChannels(ECR_Overlap);
+	// only its shape and transform are used, melee hits are tested against pawn capsules directly
+	MeleeBoxNew->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeleeBoxNew->bGenerateOverlapEvents = false;
+
+	HeatComp = ObjectInitializer.CreateDefaultSubobject<UShooterWeaponHeatComponent>(this, TEXT("HeatComp"));
 
 	bLoopedMuzzleFX = false;
 	bLoopedFireAnim = false;
@@ -50,6 +153,12 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	LastFireTime = 0.0f;
 	MeleeCounter = 0;
 	GrenadeCounter = 0;
+	LastMeleeHitTime = 0.0f;
+	bMeleeSwingOpen = false;
+	MeleeHitTolerance = 20.0f;
+	MeleeRewindTolerance = 0.1f;
+	CachedTuning = NULL;
+	CachedTuningVersion = INDEX_NONE;
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
@@ -57,6 +166,7 @@ AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Su
 	bReplicates = true;
 	bReplicateInstigator = true;
 	bNetUseOwnerRelevancy = true;
+	NetIdleUpdateFrequency = 10.0f;
 
 	bMyCanFire = true;
 	bMyCanMelee = true;
@@ -69,12 +179,15 @@ void AShooterWeapon::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	if (WeaponConfig.InitialClips > 0)
+	const FWeaponData& Config = GetWeaponConfig();
+	if (Config.InitialClips > 0)
 	{
-		CurrentAmmoInClip = WeaponConfig.AmmoPerClip;
-		CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
+		CurrentAmmoInClip = Config.AmmoPerClip;
+		CurrentAmmo = Config.AmmoPerClip * Config.InitialClips;
 	}
 
+	HeatComp->SetCooldownRate(CooldownRate);
+
 	DetachMeshFromPawn();
 }
 
@@ -265,7 +378,7 @@ void AShooterWeapon::StartReload(bool bFromReplication)
 		float AnimDuration = PlayWeaponAnimation(ReloadAnim);		
 		if (AnimDuration <= 0.0f)
 		{
-			AnimDuration = WeaponConfig.NoAnimReloadDuration;
+			AnimDuration = GetWeaponConfig().NoAnimReloadDuration;
 		}
 
 		GetWorldTimerManager().SetTimer(this, &AShooterWeapon::StopReload, AnimDuration, false);
@@ -285,7 +398,7 @@ void AShooterWeapon::StopReload()
 {
 	if (CurrentState == EWeaponState::Reloading)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("StopReloadActuallyDidStuff"));
+		SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("StopReloadActuallyDidStuff"));
 		bPendingReload = false;
 		DetermineWeaponState();
 		StopWeaponAnimation(ReloadAnim);
@@ -350,9 +463,28 @@ bool AShooterWeapon::CanFire() const
 bool AShooterWeapon::CanReload() const
 {
 	bool bCanReload = (!MyPawn || MyPawn->CanReload());
-	bool bGotAmmo = ( CurrentAmmoInClip < WeaponConfig.AmmoPerClip) && (CurrentAmmo - CurrentAmmoInClip > 0 || HasInfiniteClip());
+	bool bGotAmmo = ( CurrentAmmoInClip < GetWeaponConfig().AmmoPerClip) && (CurrentAmmo - CurrentAmmoInClip > 0 || HasInfiniteClip());
 	bool bStateOKToReload = ( ( CurrentState ==  EWeaponState::Idle ) || ( CurrentState == EWeaponState::Firing) );
-	return ((bCanReload == true) && (bGotAmmo == true) && (bStateOKToReload == true) && (bIsOverheated == false));
+	return ((bCanReload == true) && (bGotAmmo == true) && (bStateOKToReload == true) && (IsOverheated() == false));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Overheat
+
+void AShooterWeapon::AddShotHeat(float Amount)
+{
+	HeatComp->AddHeat(Amount);
+}
+
+bool AShooterWeapon::IsOverheated() const
+{
+	return HeatComp->IsOverheated();
+}
+
+float AShooterWeapon::GetCurrentHeat() const
+{
+	return HeatComp->GetHeat();
 }
 
 
@@ -361,7 +493,7 @@ bool AShooterWeapon::CanReload() const
 
 void AShooterWeapon::GiveAmmo(int AddAmount)
 {
-	const int32 MissingAmmo = FMath::Max(0, WeaponConfig.MaxAmmo - CurrentAmmo);
+	const int32 MissingAmmo = FMath::Max(0, GetWeaponConfig().MaxAmmo - CurrentAmmo);
 	AddAmount = FMath::Min(AddAmount, MissingAmmo);
 	CurrentAmmo += AddAmount;
 
@@ -422,9 +554,11 @@ void AShooterWeapon::UseAmmo()
 // CHANGED STUFF IN HERE
 void AShooterWeapon::HandleFiring()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterWeaponHandleFiring);
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("We Are In HanleFiring and can fire"));
+		SHOOTER_DEBUG(Weapon, Verbose, FColor::Yellow, TEXT("We Are In HanleFiring and can fire"));
 		if (GetNetMode() != NM_DedicatedServer)
 		{
 			SimulateWeaponFire();
@@ -432,6 +566,7 @@ void AShooterWeapon::HandleFiring()
 
 		if (MyPawn && MyPawn->IsLocallyControlled())
 		{
+			INC_DWORD_STAT(STAT_ShooterShotsFired);
 			FireWeapon();
 
 			if (bControlsProjectileExplosion)
@@ -517,10 +652,10 @@ void AShooterWeapon::HandleFiring()
 		}
 
 		// setup refire timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f && bIsAutomatic);
+		bRefiring = (CurrentState == EWeaponState::Firing && GetWeaponConfig().TimeBetweenShots > 0.0f && bIsAutomatic);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(this, &AShooterWeapon::HandleFiring, WeaponConfig.TimeBetweenShots, false);
+			GetWorldTimerManager().SetTimer(this, &AShooterWeapon::HandleFiring, GetWeaponConfig().TimeBetweenShots, false);
 		}
 		else
 		{
@@ -557,6 +692,11 @@ void AShooterWeapon::ServerHandleFiring_Implementation()
 		}
 		
 
+		if (bIsOverheat)
+		{
+			AddShotHeat(HeatIncrease);
+		}
+
 		// update firing FX on remote clients
 		BurstCounter++;
 	}
@@ -564,11 +704,11 @@ void AShooterWeapon::ServerHandleFiring_Implementation()
 
 void AShooterWeapon::ReloadWeapon()
 {
-	int32 ClipDelta = FMath::Min(WeaponConfig.AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
+	int32 ClipDelta = FMath::Min(GetWeaponConfig().AmmoPerClip - CurrentAmmoInClip, CurrentAmmo - CurrentAmmoInClip);
 
 	if (HasInfiniteClip())
 	{
-		ClipDelta = WeaponConfig.AmmoPerClip - CurrentAmmoInClip;
+		ClipDelta = GetWeaponConfig().AmmoPerClip - CurrentAmmoInClip;
 	}
 
 	if (ClipDelta > 0)
@@ -609,6 +749,25 @@ void AShooterWeapon::SetWeaponState(EWeaponState::Type NewState)
 	{
 		OnGrenadeStarted();
 	}
+
+	// idle weapons have little to send, the pawn's ammo and equip changes can wait a few frames
+	if (Role == ROLE_Authority)
+	{
+		const float ActiveFrequency = GetClass()->GetDefaultObject<AShooterWeapon>()->NetUpdateFrequency;
+		const bool bIdle = (NewState == EWeaponState::Idle) && AShooterCharacter::IsNetAdaptiveRelevancyEnabled();
+		const float WantedFrequency = bIdle ? FMath::Min(NetIdleUpdateFrequency, ActiveFrequency) : ActiveFrequency;
+		if (WantedFrequency > NetUpdateFrequency)
+		{
+			ForceNetUpdate();
+		}
+		NetUpdateFrequency = WantedFrequency;
+	}
+}
+
+float AShooterWeapon::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, InChannel, Time, bLowBandwidth);
+	return MyPawn ? Priority * MyPawn->GetNetPriorityScale(ViewPos, Viewer) : Priority;
 }
 
 // CHANGED STUFF IN THIS
@@ -661,10 +820,10 @@ void AShooterWeapon::OnBurstStarted()
 {
 	// start firing, can be delayed to satisfy TimeBetweenShots
 	const float GameTime = GetWorld()->GetTimeSeconds();
-	if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
-		LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
+	if (LastFireTime > 0 && GetWeaponConfig().TimeBetweenShots > 0.0f &&
+		LastFireTime + GetWeaponConfig().TimeBetweenShots > GameTime)
 	{
-		GetWorldTimerManager().SetTimer(this, &AShooterWeapon::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+		GetWorldTimerManager().SetTimer(this, &AShooterWeapon::HandleFiring, LastFireTime + GetWeaponConfig().TimeBetweenShots - GameTime, false);
 	}
 	else
 	{
@@ -819,7 +978,8 @@ FVector AShooterWeapon::GetMuzzleDirection() const
 // CHANGED STUFF IN THIS
 FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace) const
 {
-	/*
+	SCOPE_CYCLE_COUNTER(STAT_ShooterWeaponTrace);
+
 	static FName WeaponFireTag = FName(TEXT("WeaponTrace"));
 
 	// Perform trace to retrieve hit info
@@ -827,212 +987,134 @@ FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector&
 	TraceParams.bTraceAsyncScene = true;
 	TraceParams.bReturnPhysicalMaterial = true;
 
-	FHitResult Hit(ForceInit);
-	GetWorld()->LineTraceSingle(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
-
-	return Hit;
-	*/
-
-	static FName WeaponFireTag = FName(TEXT("WeaponTrace"));
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	// only touch the world's debug tag when it actually changes
+	if (bDrawWeaponTrace)
+	{
+		GetWorld()->DebugDrawTraceTag = WeaponFireTag;
+	}
+	else if (GetWorld()->DebugDrawTraceTag == WeaponFireTag)
+	{
+		GetWorld()->DebugDrawTraceTag = NAME_None;
+	}
+#endif
 
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(WeaponFireTag, true, Instigator);
-	TraceParams.bTraceAsyncScene = true;
-	TraceParams.bReturnPhysicalMaterial = true;
-	//TraceParams.TraceTag = WeaponFireTag;
+	if (GetWeaponConfig().Magnetism == EWeaponMagnetism::Sweep)
+	{
+		return WeaponTraceSweep(StartTrace, EndTrace, TraceParams);
+	}
 
-	FHitResult Hit(ForceInit);
+	FVector TraceTo = EndTrace;
 
-	if (GetWorld()->LineTraceSingle(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams))
+	FVector AimPoint;
+	if (GetWeaponConfig().Magnetism == EWeaponMagnetism::Analytic && FindMagnetismTarget(StartTrace, EndTrace, AimPoint))
 	{
+		// bend the shot towards the pawn, the trace still makes sure it isn't behind geometry
+		TraceTo = StartTrace + (AimPoint - StartTrace).SafeNormal() * (EndTrace - StartTrace).Size();
+	}
 
+	FHitResult Hit(ForceInit);
+	SHOOTER_COUNT_SCENE_QUERY();
+	GetWorld()->LineTraceSingle(Hit, StartTrace, TraceTo, COLLISION_WEAPON, TraceParams);
 
-		FVector NewEnd;
+	return Hit;
+}
 
-		AActor* ActorThatWasHit;
+FHitResult AShooterWeapon::WeaponTraceSweep(const FVector& StartTrace, const FVector& EndTrace, const FCollisionQueryParams& TraceParams) const
+{
+	FHitResult Hit(ForceInit);
 
-		bool bHitShooterCharacter = false;
+	SHOOTER_COUNT_SCENE_QUERY();
+	if (!GetWorld()->LineTraceSingle(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams))
+	{
+		return Hit;
+	}
 
-		ActorThatWasHit = Hit.GetActor();
+	// if the hit actor was a player, we dont need to do anything else.
+	if (Cast<AShooterCharacter>(Hit.GetActor()))
+	{
+		return Hit;
+	}
 
-		//	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("TraceExtemt:"));
-		//GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TraceExtent.ToString());
+	//otherwise we need to do a box trace that only searches for players.
+	TArray<FHitResult> ListOfHits;
+	FCollisionShape shape = FCollisionShape::MakeBox(TraceExtent);
+	FCollisionResponseParams ResponseParam(ECollisionResponse::ECR_Ignore);
+	ResponseParam.CollisionResponse.Pawn = 1;
 
-		if (Hit.GetActor())
+	SHOOTER_COUNT_SCENE_QUERY();
+	if (GetWorld()->SweepMulti(ListOfHits, StartTrace, EndTrace, FQuat(), COLLISION_WEAPON, shape, TraceParams, ResponseParam))
+	{
+		for (int32 i = 0; i < ListOfHits.Num(); i++)
 		{
-			// if the hit actor was a player, we dont need to do anything else.
-			if (Cast<AShooterCharacter>(Hit.GetActor()))
+			if (Cast<AShooterCharacter>(ListOfHits[i].GetActor()))
 			{
-				return Hit;
-
-			}
+				// do a normal line trace for where we hit the player to ensure that it wasnt through geometry.
+				const FVector NewEnd = StartTrace + (ListOfHits[i].ImpactPoint - StartTrace).SafeNormal() * 10000;
 
-			//otherwise we need to do a box trace that only searches for players.
-			else
-			{
-				TArray<FHitResult> ListOfHits;
-				FCollisionShape shape = FCollisionShape::MakeBox(TraceExtent);
-				FCollisionResponseParams ResponseParam(ECollisionResponse::ECR_Ignore);
-				ResponseParam.CollisionResponse.Pawn = 1;
-				
-				if (GetWorld()->SweepMulti(ListOfHits, StartTrace, EndTrace, FQuat(), COLLISION_WEAPON, shape, TraceParams, ResponseParam))
+				FHitResult FinalHitResult(ForceInit);
+				SHOOTER_COUNT_SCENE_QUERY();
+				if (GetWorld()->LineTraceSingle(FinalHitResult, StartTrace, NewEnd, COLLISION_WEAPON, TraceParams))
 				{
-
-
-
-					//if we hit something  we do some stuff to get where the new line trace should trace to.
-					if (ListOfHits.Num() > 0)
-					{
-						int32 numbertoprint;
-						numbertoprint = ListOfHits.Num();
-						//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(numbertoprint));
-
-						for (int32 i = 0; i < ListOfHits.Num(); i++)
-						{
-							//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(i + 1));
-							if (ListOfHits[i].GetActor())
-							{
-								if (Cast<AShooterCharacter>(ListOfHits[i].GetActor()))
-								{
-									//GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("I HIT A SHOOTERCHARACTER"));
-
-									//FHitResult NewHitResult(ForceInit);
-									//GetWorld()->LineTraceSingle(NewHitResult, StartTrace, ListOfHits[i].ImpactPoint, COLLISION_WEAPON, TraceParams);
-
-									//return NewHitResult;
-
-									NewEnd = ListOfHits[i].ImpactPoint;
-
-									FVector Test;
-
-									const int32 RandomSeed = FMath::Rand();
-									FRandomStream WeaponRandomStream(RandomSeed);
-
-									Test = ListOfHits[i].ImpactPoint - StartTrace;
-
-									FVector Cone = WeaponRandomStream.VRandCone(Test, 0, 0);
-
-									NewEnd = StartTrace + Cone * 10000;
-
-									ActorThatWasHit = ListOfHits[i].GetActor();
-									bHitShooterCharacter = true;
-
-									//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, NewEnd.ToString());
-
-									break;
-
-									//return ListOfHits[i];
-								}
-
-							}
-
-						}
-					}
+					return FinalHitResult;
 				}
+
+				break;
 			}
 		}
-		// we didnt hit anything so we do the same as above
-		else
-		{
-			//GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Cyan, TEXT("Hit a BSP"));
-
-			TArray<FHitResult> ListOfHits;
-			FCollisionShape shape = FCollisionShape::MakeBox(TraceExtent);
-			FCollisionResponseParams ResponseParam(ECollisionResponse::ECR_Ignore);
-			ResponseParam.CollisionResponse.Pawn = 1;
-			
-			if (GetWorld()->SweepMulti(ListOfHits, StartTrace, EndTrace, FQuat(), COLLISION_WEAPON, shape, TraceParams, ResponseParam))
-			{
-
-				if (ListOfHits.Num() > 0)
-				{
-					int32 numbertoprint;
-					numbertoprint = ListOfHits.Num();
-					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(numbertoprint));
-
-					for (int32 i = 0; i < ListOfHits.Num(); i++)
-					{
-						//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(i + 1));
-						if (ListOfHits[i].GetActor())
-						{
-							if (Cast<AShooterCharacter>(ListOfHits[i].GetActor()))
-							{
-								//	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("I HIT A SHOOTERCHARACTER"));
-
-								//FHitResult NewHitResult(ForceInit);
-								//GetWorld()->LineTraceSingle(NewHitResult, StartTrace, ListOfHits[i].ImpactPoint, COLLISION_WEAPON, TraceParams);
-
-								//return NewHitResult;
-
-								NewEnd = ListOfHits[i].ImpactPoint;
-
-								FVector Test;
-
-								const int32 RandomSeed = FMath::Rand();
-								FRandomStream WeaponRandomStream(RandomSeed);
-
-								Test = ListOfHits[i].ImpactPoint - StartTrace;
-
-								FVector Cone = WeaponRandomStream.VRandCone(Test, 0, 0);
-
-								NewEnd = StartTrace + Cone * 10000;
-
-								ActorThatWasHit = ListOfHits[i].GetActor();
-								bHitShooterCharacter = true;
-
-								//	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, NewEnd.ToString());
+	}
 
-								break;
+	return Hit;
+}
 
-								//return ListOfHits[i];
-							}
+AShooterCharacter* AShooterWeapon::FindMagnetismTarget(const FVector& StartTrace, const FVector& EndTrace, FVector& OutAimPoint) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterWeaponMagnetism);
 
-						}
+	const float MagnetismRadius = TraceExtent.GetAbsMax();
+	const float MagnetismConeTan = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(GetWeaponConfig().MagnetismConeAngle, 0.0f, 45.0f)));
 
-					}
-				}
-			}
-		}
+	if (MagnetismRadius <= 0.0f && MagnetismConeTan <= 0.0f)
+	{
+		return NULL;
+	}
 
-		if (bDrawWeaponTrace)
-		{
-			GetWorld()->DebugDrawTraceTag = WeaponFireTag;
-		}
-		else
-		{
-			GetWorld()->DebugDrawTraceTag = FName(TEXT(""));
-		}
+	AShooterCharacter* BestTarget = NULL;
+	float BestDistAlongShot = MAX_FLT;
+	bool bBestIsDirectHit = false;
 
-		// do a normal line trace for where we hit the player to ensure that it wasnt through geometry.
-		if (ActorThatWasHit && bHitShooterCharacter)
+	for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
+		if (TestPawn == NULL || TestPawn == Instigator || !TestPawn->IsAlive())
 		{
-			FHitResult FinalHitResult(ForceInit);
-			//	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, NewEnd.ToString());
-			
-			if (GetWorld()->LineTraceSingle(FinalHitResult, StartTrace, NewEnd, COLLISION_WEAPON, TraceParams))
-			{
-				return FinalHitResult;
-			}
-			
-
-			
+			continue;
 		}
 
-		FString stringtoprint;
+		// closest points between the shot and the capsule's axis
+		const UCapsuleComponent* Capsule = TestPawn->GetCapsuleComponent();
+		const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+		const FVector AxisOffset(0.0f, 0.0f, FMath::Max(0.0f, Capsule->GetScaledCapsuleHalfHeight() - CapsuleRadius));
+		const FVector CapsuleCenter = Capsule->GetComponentLocation();
 
-		Hit.BoneName.ToString(stringtoprint);
-		//	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, stringtoprint);
+		FVector PointOnShot, PointOnAxis;
+		FMath::SegmentDistToSegmentSafe(StartTrace, EndTrace, CapsuleCenter - AxisOffset, CapsuleCenter + AxisOffset, PointOnShot, PointOnAxis);
 
-		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("Charge amount, server: %f"), CurrentChargeAmount));
+		const float DistAlongShot = (PointOnShot - StartTrace).Size();
+		const float DistToCapsule = (PointOnAxis - PointOnShot).Size() - CapsuleRadius;
+		const float AllowedDist = MagnetismRadius + DistAlongShot * MagnetismConeTan;
 
-		return Hit;
-	}
-	else
-	{
-		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red,  TEXT("CRASH ALERT!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!"));
-		FHitResult TestHitResult(ForceInit);
-		return TestHitResult;
+		if (DistToCapsule <= AllowedDist && DistAlongShot < BestDistAlongShot)
+		{
+			BestTarget = TestPawn;
+			BestDistAlongShot = DistAlongShot;
+			bBestIsDirectHit = (DistToCapsule <= 0.0f);
+			OutAimPoint = PointOnAxis;
+		}
 	}
+
+	// the shot already goes through the closest pawn, leave it alone
+	return bBestIsDirectHit ? NULL : BestTarget;
 }
 
 void AShooterWeapon::SetOwningPawn(AShooterCharacter* NewOwner)
@@ -1061,6 +1143,88 @@ void AShooterWeapon::OnRep_MyPawn()
 	}
 }
 
+void AShooterWeapon::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// packed once per update, connections only get them when the packed bytes changed
+	const uint8 PackedCharge = FShooterWeaponNetState::PackCharge(GetReplicatedCharge());
+
+	NetState.BurstCounter = FShooterWeaponNetState::PackCounter(BurstCounter);
+	NetState.MeleeCounter = FShooterWeaponNetState::PackCounter(MeleeCounter);
+	NetState.GrenadeCounter = FShooterWeaponNetState::PackCounter(GrenadeCounter);
+	NetState.ZoomLevel = (uint8)FMath::Clamp(FMath::RoundToInt(CurrentZoomLevel), 0, (int32)FShooterWeaponNetState::MaxZoomLevel);
+	NetState.Charge = PackedCharge;
+	NetState.bPendingReload = bPendingReload;
+
+	OwnerState.Ammo = CurrentAmmo;
+	OwnerState.AmmoInClip = CurrentAmmoInClip;
+	OwnerState.Charge = PackedCharge;
+}
+
+void AShooterWeapon::OnRep_NetState()
+{
+	const FShooterWeaponNetState PrevState = LastNetState;
+	LastNetState = NetState;
+
+	if (NetState.ZoomLevel != PrevState.ZoomLevel)
+	{
+		CurrentZoomLevel = NetState.ZoomLevel;
+	}
+	if (NetState.Charge != PrevState.Charge)
+	{
+		SetReplicatedCharge(FShooterWeaponNetState::UnpackCharge(NetState.Charge));
+	}
+	if (NetState.bPendingReload != PrevState.bPendingReload)
+	{
+		bPendingReload = NetState.bPendingReload;
+		OnRep_Reload();
+	}
+	if (NetState.BurstCounter != PrevState.BurstCounter)
+	{
+		BurstCounter = NetState.BurstCounter;
+		OnRep_BurstCounter();
+	}
+	if (NetState.MeleeCounter != PrevState.MeleeCounter)
+	{
+		MeleeCounter = NetState.MeleeCounter;
+		OnRep_MeleeCounter();
+	}
+	if (NetState.GrenadeCounter != PrevState.GrenadeCounter)
+	{
+		GrenadeCounter = NetState.GrenadeCounter;
+		OnRep_GrenadeCounter();
+	}
+}
+
+void AShooterWeapon::OnRep_OwnerState()
+{
+	const FShooterWeaponOwnerState PrevState = LastOwnerState;
+	LastOwnerState = OwnerState;
+
+	if (OwnerState.Ammo != PrevState.Ammo)
+	{
+		CurrentAmmo = OwnerState.Ammo;
+	}
+	if (OwnerState.AmmoInClip != PrevState.AmmoInClip)
+	{
+		CurrentAmmoInClip = OwnerState.AmmoInClip;
+	}
+	if (OwnerState.Charge != PrevState.Charge)
+	{
+		SetReplicatedCharge(FShooterWeaponNetState::UnpackCharge(OwnerState.Charge));
+	}
+}
+
+float AShooterWeapon::GetReplicatedCharge() const
+{
+	return 0.0f;
+}
+
+void AShooterWeapon::SetReplicatedCharge(float NewCharge)
+{
+}
+
 void AShooterWeapon::OnRep_BurstCounter()
 {
 	if (BurstCounter > 0)
@@ -1195,16 +1359,8 @@ void AShooterWeapon::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & O
 
 	DOREPLIFETIME( AShooterWeapon, MyPawn );
 
-	DOREPLIFETIME_CONDITION( AShooterWeapon, CurrentAmmo,		COND_OwnerOnly );
-	DOREPLIFETIME_CONDITION( AShooterWeapon, CurrentAmmoInClip, COND_OwnerOnly );
-
-	DOREPLIFETIME_CONDITION( AShooterWeapon, BurstCounter,		COND_SkipOwner );
-	DOREPLIFETIME_CONDITION( AShooterWeapon, bPendingReload,	COND_SkipOwner );
-
-	DOREPLIFETIME_CONDITION(AShooterWeapon, MeleeCounter, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AShooterWeapon, GrenadeCounter, COND_SkipOwner);
-
-	DOREPLIFETIME(AShooterWeapon, bIsOverheated);
+	DOREPLIFETIME_CONDITION( AShooterWeapon, OwnerState,		COND_OwnerOnly );
+	DOREPLIFETIME_CONDITION( AShooterWeapon, NetState,			COND_SkipOwner );
 
 	DOREPLIFETIME(AShooterWeapon, ActiveProjectile);
 }
@@ -1244,26 +1400,50 @@ int32 AShooterWeapon::GetCurrentAmmoInClip() const
 	return CurrentAmmoInClip;
 }
 
+const FShooterWeaponTuningRow* AShooterWeapon::GetTuning() const
+{
+	if (TuningRow == NAME_None)
+	{
+		return NULL;
+	}
+
+	const int32 Version = UShooterWeaponTuning::GetVersion();
+	if (CachedTuningVersion != Version)
+	{
+		UShooterWeaponTuning* Tuning = UShooterWeaponTuning::Get(GetWorld());
+		CachedTuning = Tuning ? Tuning->FindRow(TuningRow) : NULL;
+		CachedTuningVersion = Version;
+	}
+
+	return CachedTuning;
+}
+
+const FWeaponData& AShooterWeapon::GetWeaponConfig() const
+{
+	const FShooterWeaponTuningRow* Tuning = GetTuning();
+	return Tuning ? Tuning->Weapon : WeaponConfig;
+}
+
 int32 AShooterWeapon::GetAmmoPerClip() const
 {
-	return WeaponConfig.AmmoPerClip;
+	return GetWeaponConfig().AmmoPerClip;
 }
 
 int32 AShooterWeapon::GetMaxAmmo() const
 {
-	return WeaponConfig.MaxAmmo;
+	return GetWeaponConfig().MaxAmmo;
 }
 
 bool AShooterWeapon::HasInfiniteAmmo() const
 {
 	const AShooterPlayerController* MyPC = (MyPawn != NULL) ? Cast<const AShooterPlayerController>(MyPawn->Controller) : NULL;
-	return WeaponConfig.bInfiniteAmmo || (MyPC && MyPC->HasInfiniteAmmo());
+	return GetWeaponConfig().bInfiniteAmmo || (MyPC && MyPC->HasInfiniteAmmo());
 }
 
 bool AShooterWeapon::HasInfiniteClip() const
 {
 	const AShooterPlayerController* MyPC = (MyPawn != NULL) ? Cast<const AShooterPlayerController>(MyPawn->Controller) : NULL;
-	return WeaponConfig.bInfiniteClip || (MyPC && MyPC->HasInfiniteClip());
+	return GetWeaponConfig().bInfiniteClip || (MyPC && MyPC->HasInfiniteClip());
 }
 
 float AShooterWeapon::GetEquipStartedTime() const
@@ -1284,11 +1464,10 @@ void AShooterWeapon::PickedUp(int32 Clips)
 
 	CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
 	*/
-	WeaponConfig.InitialClips = 0;
 
 	/*if (Clips < WeaponConfig.AmmoPerClip)
 	{
-	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("first if"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("first if"));
 	CurrentAmmoInClip = Clips;
 	CurrentAmmo = Clips;
 	//CurrentAmmo = WeaponConfig.AmmoPerClip;
@@ -1296,25 +1475,19 @@ void AShooterWeapon::PickedUp(int32 Clips)
 	}
 	else if (Clips >= (WeaponConfig.MaxAmmo - CurrentAmmo))
 	{
-	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("second if"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("second if"));
 	CurrentAmmo = WeaponConfig.MaxAmmo;
 	}
 	else
 	{
-	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("third if"));
+	SHOOTER_DEBUG(Weapon, Log, FColor::Yellow, TEXT("third if"));
 	CurrentAmmo = Clips;
 	}*/
 
 	// this should only get called when picking up a weapon, not ammo for a weapon
-	if (Clips < WeaponConfig.AmmoPerClip)
-	{
-		CurrentAmmoInClip = Clips;
-		CurrentAmmo = Clips;
-	}
-	else
-	{
-		CurrentAmmo = Clips;
-	}
+	// the clip is always set, a pooled weapon may still hold the last owner's clip
+	CurrentAmmo = Clips;
+	CurrentAmmoInClip = FMath::Min(Clips, GetWeaponConfig().AmmoPerClip);
 }
 
 ////////// GRENADES
@@ -1384,16 +1557,7 @@ bool AShooterWeapon::ServerGrenadeThrow_Validate(FVector Origin, FVector_NetQuan
 void AShooterWeapon::ServerGrenadeThrow_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir, FGrenadeData GrenadeData)
 {
 	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Grenade = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, GrenadeData.GrenadeClass, SpawnTM));
-	
-	if (Grenade)
-	{
-		Grenade->Instigator = Instigator;
-		Grenade->SetOwner(this);
-		Grenade->InitVelocity(ShootDir);
-
-		UGameplayStatics::FinishSpawningActor(Grenade, SpawnTM);
-	}
+	AShooterProjectile::SpawnProjectile(this, GrenadeData.GrenadeClass, SpawnTM, ShootDir);
 }
 
 void AShooterWeapon::AddAmmoFromPickup(int32 Bullets)
@@ -1401,6 +1565,57 @@ void AShooterWeapon::AddAmmoFromPickup(int32 Bullets)
 	GiveAmmo(Bullets);
 }
 
+void AShooterWeapon::Park()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	// nobody holds it, so nothing is in progress. Timers that would have finished these are gone too
+	bWantsToFire = false;
+	bWantsToMeleeNew = false;
+	bWantsToGrenadeNew = false;
+	bPendingReload = false;
+	bPendingEquip = false;
+	CurrentState = EWeaponState::Idle;
+	BurstCounter = 0;
+	MeleeCounter = 0;
+	GrenadeCounter = 0;
+
+	// meshes were hidden when it left the inventory, keep the channel open but stop updating it
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AShooterWeapon::Unpark()
+{
+	SetNetDormancy(DORM_Awake);
+}
+
+void AShooterWeapon::ReleaseOrDestroy()
+{
+	// pooled weapons come back like new, ammo is set by whoever picks it up
+	ResetPooledState();
+
+	AShooterGameMode* MyGame = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyGame == NULL || !MyGame->ReleasePooledWeapon(this))
+	{
+		Destroy();
+	}
+}
+
+void AShooterWeapon::ResetPooledState()
+{
+	// same ammo as a freshly spawned weapon, see PostInitializeComponents
+	const FWeaponData& Config = GetWeaponConfig();
+	CurrentAmmoInClip = Config.InitialClips > 0 ? Config.AmmoPerClip : 0;
+	CurrentAmmo = Config.InitialClips > 0 ? Config.AmmoPerClip * Config.InitialClips : 0;
+
+	CurrentZoomLevel = 0.0f;
+	HeatComp->SetHeat(0.0f, false);
+	LastFireTime = 0.0f;
+	LastMeleeTimeNew = 0.0f;
+	LastMeleeHitTime = 0.0f;
+	bMeleeSwingOpen = false;
+}
+
 void AShooterWeapon::ActivateRecoil()
 {
 	bShouldRecoil = true;
@@ -1410,6 +1625,7 @@ FHitResult AShooterWeapon::MyLineTrace(const FVector& Start, const FVector& End,
 {
 	FHitResult HitResult(ForceInit);
 
+	SHOOTER_COUNT_SCENE_QUERY();
 	GetWorld()->LineTraceSingle(HitResult, Start, End, TraceChannel, Params);
 
 	//GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan, TEXT("MYLINETRACE IS GETTINC ACALLLED"));
@@ -1619,16 +1835,7 @@ void AShooterWeapon::ServerWeaponGrenade_Implementation(FVector Origin, FVector_
 	if (GrenadeData.GrenadeClass != NULL)
 	{
 
-		AShooterProjectile* Grenade = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, GrenadeData.GrenadeClass, SpawnTM));
-
-		if (Grenade)
-		{
-			Grenade->Instigator = Instigator;
-			Grenade->SetOwner(this);
-			Grenade->InitVelocity(ShootDir);
-
-			UGameplayStatics::FinishSpawningActor(Grenade, SpawnTM);
-		}
+		AShooterProjectile::SpawnProjectile(this, GrenadeData.GrenadeClass, SpawnTM, ShootDir);
 	}
 }
 
@@ -1790,6 +1997,14 @@ void AShooterWeapon::OnMeleeStarted()
 
 void AShooterWeapon::HandleMeleeingNew()
 {
+	// local client notifies server first, hits are only accepted inside a swing the server knows about
+	if (MyPawn && MyPawn->IsLocallyControlled() && Role < ROLE_Authority)
+	{
+		ServerHandleMeleeingNew();
+	}
+
+	LastMeleeTimeNew = GetWorld()->GetTimeSeconds();
+
 	if ((CanMelee()))
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -1798,6 +2013,11 @@ void AShooterWeapon::HandleMeleeingNew()
 			SimulateWeaponMelee();
 		}
 
+		if (Role == ROLE_Authority)
+		{
+			bMeleeSwingOpen = true;
+		}
+
 		if (MyPawn && MyPawn->IsLocallyControlled())
 		{
 			/*FireWeapon();
@@ -1814,17 +2034,6 @@ void AShooterWeapon::HandleMeleeingNew()
 			MeleeCounter++;
 		}
 	}
-
-	if (MyPawn && MyPawn->IsLocallyControlled())
-	{
-		// local client will notify server
-		if (Role < ROLE_Authority)
-		{
-			ServerHandleMeleeingNew();
-		}
-	}
-
-	LastMeleeTimeNew = GetWorld()->GetTimeSeconds();
 }
 
 bool AShooterWeapon::ServerHandleMeleeingNew_Validate()
@@ -1834,9 +2043,15 @@ bool AShooterWeapon::ServerHandleMeleeingNew_Validate()
 
 void AShooterWeapon::ServerHandleMeleeingNew_Implementation()
 {
+	// swings can't come faster than the weapon allows, MeleeRewindTolerance covers jitter in their arrival
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (LastMeleeTimeNew > 0.0f && Now - LastMeleeTimeNew < TimeBetweenMeleesNew - MeleeRewindTolerance)
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client melee swing (too soon after the last one)"), *GetNameSafe(this));
+		return;
+	}
 
 	HandleMeleeingNew();
-
 }
 
 FVector AShooterWeapon::GetShootDir()
@@ -1854,147 +2069,159 @@ FVector AShooterWeapon::GetShootDir()
 
 void AShooterWeapon::WeaponMelee()
 {
-	/*
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("WeaponMelee!!!"));
-	
-	if (Role < ROLE_Authority)
+	AShooterCharacter* const MeleeTarget = FindMeleeTarget();
+	if (MeleeTarget)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("Client: Weapon Melee!!!"));
-		ServerWeaponMelee();
-	}
-
-	TArray<AActor*> ActorsOverlapping;
-	MeleeBoxNew->GetOverlappingActors(ActorsOverlapping);
-
-	if (ActorsOverlapping.Num() <= 0)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("THE ARRAY IS LESS THAN OR EQUAL TO 0"));
-	}
-
-	for (int32 i = 0; i < ActorsOverlapping.Num(); i++)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Blue, TEXT("WE HAVE ENTERED THE FOR LOOP"));
-		//Cast<AShooterCharacter>(Impact.GetActor())->EndZoom();
-
-		if (ActorsOverlapping[i] == MyPawn)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Blue, TEXT("THIS IS US, GO TO NEXT OVERLAPPING ACTOR"));
-			// WE ARE OVERLAPPING SELF, WHAT KINDA MORON WOULD HIT HIMSELF!!!!!
-		}
-		else if (Cast<AShooterCharacter>(ActorsOverlapping[i]))
+		if (Role < ROLE_Authority)
 		{
-			// its a shootercharacter
-
-			GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Blue, TEXT("Cast is good, we should be doing damage"));
-
-			AShooterCharacter* MeleeTarget = Cast<AShooterCharacter>(ActorsOverlapping[i]);
-
-			FPointDamageEvent PointDmg;
-			PointDmg.DamageTypeClass = MeleeDamageType;
-			PointDmg.ShotDirection = GetShootDir();
-
-			static FName WeaponFireTag = FName(TEXT("WeaponTrace"));
-			FCollisionQueryParams TraceParams(WeaponFireTag, true, Instigator);
-			TraceParams.bTraceAsyncScene = true;
-			TraceParams.bReturnPhysicalMaterial = true;
-
-			const FVector StartTrace = GetActorLocation();
-			const FVector EndTrace = MeleeTarget->GetActorLocation();
-
-			GetWorld()->LineTraceSingle(PointDmg.HitInfo, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
-
-			PointDmg.Damage = MeleeTarget->CalculateDamageToUse(MeleeDamage, PointDmg, MyPawn->Controller, this, 0.0f, MeleeShieldDamage);
-
-			MeleeTarget->TakeDamage(PointDmg.Damage, PointDmg, MyPawn->Controller, this);
-
-			break;
-
-
+			// predict the hit feedback, damage is done once the server has validated the hit
+			AShooterPlayerController* const MyPC = Cast<AShooterPlayerController>(MyPawn->Controller);
+			AShooterHUD* const MyHUD = MyPC ? Cast<AShooterHUD>(MyPC->GetHUD()) : NULL;
+			if (MyHUD)
+			{
+				MyHUD->NotifyEnemyHit();
+			}
 		}
-		else
-		{
-			// isnt a shooter character, do nothing
 
-			GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Blue, TEXT("IS NOT A SHOOTER CHARACTER SAD FACE"));
-		}
+		// remote pawns are seen about a ping behind
+		const uint8 ClientRewind = (Role < ROLE_Authority && MyPawn->PlayerState) ? MyPawn->PlayerState->Ping : 0;
+		ServerWeaponMelee(MeleeTarget, ClientRewind);
 	}
 
 	GetWorldTimerManager().SetTimer(this, &AShooterWeapon::StopMeleeNew, TimeBetweenMeleesNew, false);
+}
 
-	*/
-
-	TArray<AActor*> ActorsOverlapping;
-	MeleeBoxNew->GetOverlappingActors(ActorsOverlapping);
-
-	if (ActorsOverlapping.Num() <= 0)
-	{
+FTransform AShooterWeapon::GetMeleeBoxTransform() const
+{
+	// MeleeBoxNew hangs off Mesh1P, which is only attached to the pawn on the owning client
+	const FTransform ViewTransform(MyPawn->GetViewRotation(), MyPawn->GetPawnViewLocation());
+	const FTransform BoxRelative(MeleeBoxNew->RelativeRotation, MeleeBoxNew->RelativeLocation, MeleeBoxNew->RelativeScale3D);
+	return BoxRelative * ViewTransform;
+}
 
-	}
+AShooterCharacter* AShooterWeapon::FindMeleeTarget() const
+{
+	const FVector BoxCenter = GetMeleeBoxTransform().GetLocation();
 
-	for (int32 i = 0; i < ActorsOverlapping.Num(); i++)
+	AShooterCharacter* BestTarget = NULL;
+	float BestDistSq = MAX_FLT;
+	for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
 	{
-
-		//Cast<AShooterCharacter>(Impact.GetActor())->EndZoom();
-
-		if (ActorsOverlapping[i] == MyPawn)
+		AShooterCharacter* const TestChar = Cast<AShooterCharacter>(*It);
+		if (TestChar == NULL || TestChar == MyPawn || !TestChar->IsAlive())
 		{
-
-			// WE ARE OVERLAPPING SELF, WHAT KINDA MORON WOULD HIT HIMSELF!!!!!
+			continue;
 		}
-		else if (Cast<AShooterCharacter>(ActorsOverlapping[i]))
-		{
-			// its a shootercharacter
-
 
+		FVector ImpactPoint;
+		const float DistSq = FVector::DistSquared(TestChar->GetActorLocation(), BoxCenter);
+		if (DistSq < BestDistSq && IsInMeleeBox(TestChar, TestChar->GetActorLocation(), 0.0f, ImpactPoint))
+		{
+			BestTarget = TestChar;
+			BestDistSq = DistSq;
+		}
+	}
 
-			ServerWeaponMelee(Cast<AShooterCharacter>(ActorsOverlapping[i]));
+	return BestTarget;
+}
 
-			break;
+bool AShooterWeapon::IsInMeleeBox(const AShooterCharacter* Target, const FVector& TargetCenter, float Tolerance, FVector& OutImpactPoint) const
+{
+	const UCapsuleComponent* const Capsule = Target->GetCapsuleComponent();
+	const float Radius = Capsule->GetScaledCapsuleRadius();
+	const float SegmentHalfLength = FMath::Max(0.0f, Capsule->GetScaledCapsuleHalfHeight() - Radius);
+	const FTransform MeleeBoxTransform = GetMeleeBoxTransform();
+	const FVector BoxExtent = MeleeBoxNew->GetUnscaledBoxExtent() * MeleeBoxTransform.GetScale3D();
 
+	// cheap sphere reject before the exact test
+	const FVector BoxCenter = MeleeBoxTransform.GetLocation();
+	const float MaxDist = BoxExtent.Size() + SegmentHalfLength + Radius + Tolerance;
+	if (FVector::DistSquared(TargetCenter, BoxCenter) > FMath::Square(MaxDist))
+	{
+		return false;
+	}
 
-		}
-		else
-		{
-			// isnt a shooter character, do nothing
+	// capsule axis in box space, where the box is axis aligned around the origin
+	const FTransform BoxTransform(MeleeBoxTransform.GetRotation(), BoxCenter);
+	const FVector SegmentStart = BoxTransform.InverseTransformPosition(TargetCenter - FVector(0.0f, 0.0f, SegmentHalfLength));
+	const FVector SegmentEnd = BoxTransform.InverseTransformPosition(TargetCenter + FVector(0.0f, 0.0f, SegmentHalfLength));
 
-	
-		}
+	// closest points by alternating projection, the segment and the box are both convex
+	FVector SegmentPoint = (SegmentStart + SegmentEnd) * 0.5f;
+	FVector BoxPoint = FVector::ZeroVector;
+	for (int32 Iteration = 0; Iteration < 4; Iteration++)
+	{
+		BoxPoint = FVector(FMath::Clamp(SegmentPoint.X, -BoxExtent.X, BoxExtent.X),
+			FMath::Clamp(SegmentPoint.Y, -BoxExtent.Y, BoxExtent.Y),
+			FMath::Clamp(SegmentPoint.Z, -BoxExtent.Z, BoxExtent.Z));
+		SegmentPoint = FMath::ClosestPointOnSegment(BoxPoint, SegmentStart, SegmentEnd);
 	}
 
-	GetWorldTimerManager().SetTimer(this, &AShooterWeapon::StopMeleeNew, TimeBetweenMeleesNew, false);
+	OutImpactPoint = BoxTransform.TransformPosition(BoxPoint);
+	return FVector::DistSquared(SegmentPoint, BoxPoint) <= FMath::Square(Radius + Tolerance);
 }
 
-bool AShooterWeapon::ServerWeaponMelee_Validate(AShooterCharacter* TargetChar)
+bool AShooterWeapon::ServerWeaponMelee_Validate(AShooterCharacter* TargetChar, uint8 ClientRewind)
 {
 	return true;
 }
 
-void AShooterWeapon::ServerWeaponMelee_Implementation(AShooterCharacter* TargetChar)
-{	
-	// the damagy stuff happens here.
+void AShooterWeapon::ServerWeaponMelee_Implementation(AShooterCharacter* TargetChar, uint8 ClientRewind)
+{
+	if (TargetChar == NULL || TargetChar == MyPawn || !TargetChar->IsAlive() || MyPawn == NULL || MyPawn->Controller == NULL)
+	{
+		return;
+	}
+
+	// one hit per swing the server has accepted, and at most one per TimeBetweenMeleesNew
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (!bMeleeSwingOpen || Now - LastMeleeTimeNew > TimeBetweenMeleesNew)
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side melee hit of %s (no swing)"), *GetNameSafe(this), *GetNameSafe(TargetChar));
+		return;
+	}
 
-	//WeaponMelee();
+	if (LastMeleeHitTime > 0.0f && Now - LastMeleeHitTime < TimeBetweenMeleesNew)
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side melee hit of %s (too soon after the last one)"), *GetNameSafe(this), *GetNameSafe(TargetChar));
+		return;
+	}
 
+	// rewind the target to where the client saw it, but never further back than its ping allows
+	float RewindTime = 0.0f;
+	if (!MyPawn->IsLocallyControlled())
+	{
+		const float MaxRewindTime = (MyPawn->PlayerState ? MyPawn->PlayerState->ExactPing * 0.001f : 0.0f) + MeleeRewindTolerance;
+		RewindTime = FMath::Min(ClientRewind * 0.004f, MaxRewindTime);
+	}
 
+	const FBox HitBox = TargetChar->GetHitBoxAtTime(Now - RewindTime);
+	const FVector TargetCenter = TargetChar->GetActorLocation() + HitBox.GetCenter() - TargetChar->GetComponentsBoundingBox().GetCenter();
+
+	FVector ImpactPoint;
+	if (!IsInMeleeBox(TargetChar, TargetCenter, MeleeHitTolerance, ImpactPoint))
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side melee hit of %s (outside melee box tolerance)"), *GetNameSafe(this), *GetNameSafe(TargetChar));
+		SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("Rejected client side melee hit, outside melee box tolerance"));
+		return;
+	}
+
+	LastMeleeHitTime = Now;
+	bMeleeSwingOpen = false;
 
 	FPointDamageEvent PointDmg;
 	PointDmg.DamageTypeClass = MeleeDamageType;
 	PointDmg.ShotDirection = GetShootDir();
 
-	static FName WeaponFireTag = FName(TEXT("WeaponTrace"));
-	FCollisionQueryParams TraceParams(WeaponFireTag, true, Instigator);
-	TraceParams.bTraceAsyncScene = true;
-	TraceParams.bReturnPhysicalMaterial = true;
-
-	const FVector StartTrace = GetActorLocation();
-	const FVector EndTrace = TargetChar->GetActorLocation();
-
-	GetWorld()->LineTraceSingle(PointDmg.HitInfo, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
+	// the hit is already known, no trace needed to fill it in
+	PointDmg.HitInfo = FHitResult(TargetChar, TargetChar->GetCapsuleComponent(), ImpactPoint, -PointDmg.ShotDirection);
+	PointDmg.HitInfo.bBlockingHit = true;
+	PointDmg.HitInfo.TraceStart = GetActorLocation();
+	PointDmg.HitInfo.TraceEnd = ImpactPoint;
 
 	PointDmg.Damage = TargetChar->CalculateDamageToUse(MeleeDamage, PointDmg, MyPawn->Controller, this, 0.0f, MeleeShieldDamage);
 
 	TargetChar->TakeDamage(PointDmg.Damage, PointDmg, MyPawn->Controller, this);
-
 }
 
 void AShooterWeapon::SimulateWeaponMelee()
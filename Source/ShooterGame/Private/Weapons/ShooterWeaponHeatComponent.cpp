@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Weapons/ShooterWeaponHeatComponent.h"
+
+const float UShooterWeaponHeatComponent::MaxHeat = 100.0f;
+
+UShooterWeaponHeatComponent::UShooterWeaponHeatComponent(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	bReplicates = true;
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	HeatAtLastShot = 0.0f;
+	LastShotTime = 0.0f;
+	CoolingPerSecond = 10.0f;
+	bOverheated = false;
+}
+
+void UShooterWeaponHeatComponent::SetCooldownRate(float InCooldownRate)
+{
+	// the old timer based cooldown removed 10 heat every CooldownRate seconds
+	CoolingPerSecond = InCooldownRate > 0.0f ? 10.0f / InCooldownRate : 0.0f;
+}
+
+float UShooterWeaponHeatComponent::GetHeatAtTime(float Time) const
+{
+	return FMath::Max(0.0f, HeatAtLastShot - CoolingPerSecond * FMath::Max(0.0f, Time - LastShotTime));
+}
+
+float UShooterWeaponHeatComponent::GetHeat() const
+{
+	return GetHeatAtTime(GetWorld()->GetTimeSeconds());
+}
+
+bool UShooterWeaponHeatComponent::IsOverheated() const
+{
+	return bOverheated && GetHeat() > 0.0f;
+}
+
+void UShooterWeaponHeatComponent::SetHeat(float NewHeat, bool bNewOverheated)
+{
+	HeatAtLastShot = NewHeat;
+	LastShotTime = GetWorld()->GetTimeSeconds();
+	bOverheated = bNewOverheated;
+
+	// only clients show heat, the server evaluates it on demand
+	if (GetOwner() && GetOwner()->GetNetMode() != NM_DedicatedServer)
+	{
+		SetComponentTickEnabled(true);
+	}
+	UpdateOwnerWeapon();
+}
+
+void UShooterWeaponHeatComponent::AddHeat(float Amount)
+{
+	const float NewHeat = GetHeat() + Amount;
+	SetHeat(NewHeat, IsOverheated() || NewHeat >= MaxHeat);
+
+	if (GetOwner() && GetOwner()->Role == ROLE_Authority)
+	{
+		HeatState.Heat = (uint8)FMath::Clamp(FMath::RoundToInt(NewHeat), 0, 255);
+		HeatState.bOverheated = bOverheated;
+		HeatState.ShotCounter++;
+	}
+}
+
+void UShooterWeaponHeatComponent::OnRep_HeatState()
+{
+	const APawn* OwnerPawn = GetOwner() ? GetOwner()->GetInstigator() : NULL;
+	const bool bLocallyPredicted = OwnerPawn && OwnerPawn->IsLocallyControlled();
+
+	// the owner already predicted its own shots, only take the server's word when it is hotter
+	if (!bLocallyPredicted || HeatState.Heat > GetHeat() || (HeatState.bOverheated && !IsOverheated()))
+	{
+		SetHeat(HeatState.Heat, HeatState.bOverheated);
+	}
+}
+
+void UShooterWeaponHeatComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateOwnerWeapon();
+
+	if (GetHeat() <= 0.0f)
+	{
+		bOverheated = false;
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UShooterWeaponHeatComponent::UpdateOwnerWeapon()
+{
+	AShooterWeapon* Weapon = Cast<AShooterWeapon>(GetOwner());
+	if (Weapon)
+	{
+		Weapon->CurrentHeat = GetHeat();
+		Weapon->bIsOverheated = IsOverheated();
+	}
+}
+
+void UShooterWeaponHeatComponent::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UShooterWeaponHeatComponent, HeatState);
+}
@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ShooterGame.h"
+#include "ShooterGame/Classes/Weapons/ShooterWeaponTuning.h"
+
+int32 UShooterWeaponTuning::Version = 0;
+
+/** longest CSV text sent to a client in one RPC, a row longer than that is sent on its own */
+static const int32 MaxClientChunkLength = 2048;
+
+/** copy of a row, allocated the way UDataTable frees its rows */
+static uint8* CopyRow(UScriptStruct* RowStruct, const uint8* Source)
+{
+	uint8* Row = (uint8*)FMemory::Malloc(RowStruct->PropertiesSize);
+	RowStruct->InitializeScriptStruct(Row);
+	RowStruct->CopyScriptStruct(Row, Source);
+	return Row;
+}
+
+static void FreeRow(UScriptStruct* RowStruct, uint8* Row)
+{
+	RowStruct->DestroyScriptStruct(Row);
+	FMemory::Free(Row);
+}
+
+/** CSV header line naming the row's properties, the first column holds the row name */
+static FString ExportCSVHeader(UScriptStruct* RowStruct)
+{
+	FString Header = TEXT("---");
+	for (TFieldIterator<UProperty> It(RowStruct); It; ++It)
+	{
+		Header += TEXT(",") + It->GetName();
+	}
+	return Header + TEXT("\n");
+}
+
+/** one CSV line with the row's properties in ExportCSVHeader order */
+static FString ExportCSVRow(UScriptStruct* RowStruct, FName RowName, const uint8* Row)
+{
+	FString Line = RowName.ToString();
+	for (TFieldIterator<UProperty> It(RowStruct); It; ++It)
+	{
+		FString Value;
+		It->ExportTextItem(Value, It->ContainerPtrToValuePtr<uint8>(Row), NULL, NULL, PPF_None);
+		Line += FString::Printf(TEXT(",\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+	}
+	return Line + TEXT("\n");
+}
+
+static void ReloadWeaponTuning(UWorld* World)
+{
+	UShooterWeaponTuning* Tuning = UShooterWeaponTuning::Get(World);
+	if (Tuning && World->GetNetMode() != NM_Client)
+	{
+		UE_LOG(LogShooter, Log, TEXT("ReloadWeaponTuning: %s"), *Tuning->ReloadFromSource(World));
+	}
+}
+
+static FAutoConsoleCommandWithWorld CmdReloadWeaponTuning(
+	TEXT("Shooter.ReloadWeaponTuning"),
+	TEXT("Re-import the weapon tuning table from its source CSV and send it to connected clients."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ReloadWeaponTuning)
+	);
+
+UShooterWeaponTuning::UShooterWeaponTuning(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	CookedTable = NULL;
+	Table = NULL;
+	PendingTable = NULL;
+	bClientRowsFromCooked = true;
+}
+
+UShooterWeaponTuning* UShooterWeaponTuning::Get(UWorld* World)
+{
+	UShooterGameInstance* const GI = World ? Cast<UShooterGameInstance>(World->GetGameInstance()) : NULL;
+	return GI ? GI->WeaponTuning : NULL;
+}
+
+int32 UShooterWeaponTuning::GetVersion()
+{
+	return Version;
+}
+
+void UShooterWeaponTuning::LoadTable()
+{
+	CookedTable = NULL;
+	if (!TablePath.IsEmpty() && FPackageName::DoesPackageExist(FPackageName::ObjectPathToPackageName(TablePath)))
+	{
+		CookedTable = LoadObject<UDataTable>(NULL, *TablePath);
+	}
+
+	if (CookedTable && CookedTable->RowStruct != FShooterWeaponTuningRow::StaticStruct())
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Weapon tuning table %s doesn't use FShooterWeaponTuningRow, ignored"), *TablePath);
+		CookedTable = NULL;
+	}
+
+	RevertToCooked();
+	UE_LOG(LogShooter, Log, TEXT("Weapon tuning: %d rows from %s"), GetNumRows(), CookedTable ? *TablePath : TEXT("weapon blueprints"));
+}
+
+const FShooterWeaponTuningRow* UShooterWeaponTuning::FindRow(FName RowName) const
+{
+	const FShooterWeaponTuningRow* Row = Table ? Table->FindRow<FShooterWeaponTuningRow>(RowName, TEXT("WeaponTuning"), false) : NULL;
+	if (Row == NULL && !MissingRows.Contains(RowName))
+	{
+		MissingRows.Add(RowName);
+		UE_LOG(LogShooter, Warning, TEXT("Weapon tuning row %s not found, weapons using it fall back to their blueprint config"), *RowName.ToString());
+	}
+	return Row;
+}
+
+FString UShooterWeaponTuning::ReloadFromSource(UWorld* World)
+{
+	const FString FilePath = FPaths::GameDir() / SourceCSVPath;
+
+	FString NewCSV;
+	if (SourceCSVPath.IsEmpty() || !FFileHelper::LoadFileToString(NewCSV, *FilePath))
+	{
+		return FString::Printf(TEXT("can't read %s, keeping %d rows"), *FilePath, GetNumRows());
+	}
+
+	TArray<FString> Problems;
+	if (!ApplyCSV(NewCSV, Problems))
+	{
+		return FString::Printf(TEXT("%s: %s, keeping %d rows"), *FilePath, Problems.Num() ? *Problems[0] : TEXT("no rows"), GetNumRows());
+	}
+
+	int32 NumClients = 0;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		AShooterPlayerController* PC = Cast<AShooterPlayerController>(*It);
+		if (PC && !PC->IsLocalController())
+		{
+			SendToClient(PC);
+			NumClients++;
+		}
+	}
+
+	return FString::Printf(TEXT("%d rows from %s (%d problems), sent to %d clients in %d RPCs each"), GetNumRows(), *FilePath, Problems.Num(), NumClients, ClientRows.Num() + 2);
+}
+
+bool UShooterWeaponTuning::ApplyCSV(const FString& NewCSV, TArray<FString>& OutProblems)
+{
+	// parse into a new table, weapons may still hold rows of the current one
+	UDataTable* NewTable = CreateTable();
+	OutProblems = NewTable->CreateTableFromCSVString(NewCSV);
+	if (NewTable->RowMap.Num() == 0)
+	{
+		return false;
+	}
+
+	Table = NewTable;
+	OnTableChanged();
+	UpdateClientRows();
+	return true;
+}
+
+void UShooterWeaponTuning::RevertToCooked()
+{
+	Table = CookedTable;
+	PendingTable = NULL;
+	OnTableChanged();
+	UpdateClientRows();
+}
+
+void UShooterWeaponTuning::SendToClient(AShooterPlayerController* PC) const
+{
+	PC->ClientBeginWeaponTuning(bClientRowsFromCooked);
+	for (int32 Idx = 0; Idx < ClientRows.Num(); Idx++)
+	{
+		PC->ClientAddWeaponTuningRows(ClientRows[Idx]);
+	}
+	PC->ClientEndWeaponTuning();
+}
+
+void UShooterWeaponTuning::BeginServerRows(bool bFromCooked)
+{
+	PendingTable = CreateTable();
+	if (bFromCooked && CookedTable)
+	{
+		for (auto It = CookedTable->RowMap.CreateConstIterator(); It; ++It)
+		{
+			PendingTable->RowMap.Add(It.Key(), CopyRow(PendingTable->RowStruct, It.Value()));
+		}
+	}
+}
+
+bool UShooterWeaponTuning::AddServerRows(const FString& RowsCSV, TArray<FString>& OutProblems)
+{
+	if (PendingTable == NULL)
+	{
+		return false;
+	}
+
+	UDataTable* Rows = CreateTable();
+	OutProblems = Rows->CreateTableFromCSVString(RowsCSV);
+	for (auto It = Rows->RowMap.CreateConstIterator(); It; ++It)
+	{
+		uint8*& Row = PendingTable->RowMap.FindOrAdd(It.Key());
+		if (Row)
+		{
+			FreeRow(PendingTable->RowStruct, Row);
+		}
+		Row = It.Value();
+	}
+
+	// rows are owned by the pending table now
+	const bool bAnyRows = Rows->RowMap.Num() > 0;
+	Rows->RowMap.Empty();
+	return bAnyRows;
+}
+
+void UShooterWeaponTuning::EndServerRows()
+{
+	if (PendingTable)
+	{
+		Table = PendingTable;
+		PendingTable = NULL;
+		OnTableChanged();
+	}
+}
+
+int32 UShooterWeaponTuning::GetNumRows() const
+{
+	return Table ? Table->RowMap.Num() : 0;
+}
+
+UDataTable* UShooterWeaponTuning::CreateTable()
+{
+	UDataTable* NewTable = ConstructObject<UDataTable>(UDataTable::StaticClass(), this);
+	NewTable->RowStruct = FShooterWeaponTuningRow::StaticStruct();
+	return NewTable;
+}
+
+void UShooterWeaponTuning::OnTableChanged()
+{
+	MissingRows.Empty();
+	Version++;
+}
+
+void UShooterWeaponTuning::UpdateClientRows()
+{
+	ClientRows.Empty();
+	bClientRowsFromCooked = true;
+	if (Table == NULL || Table == CookedTable)
+	{
+		return;
+	}
+
+	// clients can only keep their cooked rows if none of them were removed
+	if (CookedTable)
+	{
+		for (auto It = CookedTable->RowMap.CreateConstIterator(); It && bClientRowsFromCooked; ++It)
+		{
+			bClientRowsFromCooked = Table->RowMap.Contains(It.Key());
+		}
+	}
+
+	UScriptStruct* const RowStruct = Table->RowStruct;
+	const FString Header = ExportCSVHeader(RowStruct);
+	FString Chunk;
+	for (auto It = Table->RowMap.CreateConstIterator(); It; ++It)
+	{
+		const uint8* CookedRow = (bClientRowsFromCooked && CookedTable) ? CookedTable->RowMap.FindRef(It.Key()) : NULL;
+		if (CookedRow && RowStruct->CompareScriptStruct(It.Value(), CookedRow, PPF_None))
+		{
+			continue;
+		}
+
+		const FString Line = ExportCSVRow(RowStruct, It.Key(), It.Value());
+		if (!Chunk.IsEmpty() && Header.Len() + Chunk.Len() + Line.Len() > MaxClientChunkLength)
+		{
+			ClientRows.Add(Header + Chunk);
+			Chunk.Empty();
+		}
+		Chunk += Line;
+	}
+
+	if (!Chunk.IsEmpty())
+	{
+		ClientRows.Add(Header + Chunk);
+	}
+}
@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "ShooterGame/Classes/Weapons/ShooterWeapon_Charge.h"
 
+DECLARE_CYCLE_STAT(TEXT("Charge HandleFiring"), STAT_ShooterChargeHandleFiring, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Charge FireWeapon"), STAT_ShooterChargeFire, STATGROUP_ShooterGame);
 
 AShooterWeapon_Charge::AShooterWeapon_Charge(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -29,8 +31,10 @@ void AShooterWeapon_Charge::StopFire()
 
 void AShooterWeapon_Charge::HandleFiring()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterChargeHandleFiring);
+
 	//GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("HandleFiring!"));
-	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire() && CurrentHeat < 100)
+	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire() && !IsOverheated())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
 		{
@@ -39,6 +43,7 @@ void AShooterWeapon_Charge::HandleFiring()
 
 		if (MyPawn && MyPawn->IsLocallyControlled())
 		{
+			INC_DWORD_STAT(STAT_ShooterShotsFired);
 			FireWeapon();
 
 			UseAmmo();
@@ -87,10 +92,10 @@ void AShooterWeapon_Charge::HandleFiring()
 		}
 
 		// setup refire timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f && bIsAutomatic);
+		bRefiring = (CurrentState == EWeaponState::Firing && GetWeaponConfig().TimeBetweenShots > 0.0f && bIsAutomatic);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleFiring, WeaponConfig.TimeBetweenShots, false);
+			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleFiring, GetWeaponConfig().TimeBetweenShots, false);
 		}
 		else
 		{
@@ -106,16 +111,16 @@ void AShooterWeapon_Charge::HandleFiring()
 void AShooterWeapon_Charge::OnBurstStarted()
 {
 //	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("OnBurstStarted!"));
-	if (ChargeConfig.bIsCharge)
+	if (GetChargeConfig().bIsCharge)
 	{
 		if (bShouldFire)
 		{
 			// start firing, can be delayed to satisfy TimeBetweenShots
 			const float GameTime = GetWorld()->GetTimeSeconds();
-			if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
-				LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
+			if (LastFireTime > 0 && GetWeaponConfig().TimeBetweenShots > 0.0f &&
+				LastFireTime + GetWeaponConfig().TimeBetweenShots > GameTime)
 			{
-				GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+				GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleFiring, LastFireTime + GetWeaponConfig().TimeBetweenShots - GameTime, false);
 			}
 			else
 			{
@@ -130,10 +135,10 @@ void AShooterWeapon_Charge::OnBurstStarted()
 			// start charging can be delayed to satisfy chargerate
 			const float GameTime = GetWorld()->GetTimeSeconds();
 
-			if (LastChargeTime > 0 && ChargeConfig.ChargeRate > 0.0f &&
-				LastChargeTime + ChargeConfig.ChargeRate > GameTime)
+			if (LastChargeTime > 0 && GetChargeConfig().ChargeRate > 0.0f &&
+				LastChargeTime + GetChargeConfig().ChargeRate > GameTime)
 			{
-				GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleCharging, LastChargeTime + ChargeConfig.ChargeRate - GameTime, false);
+				GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleCharging, LastChargeTime + GetChargeConfig().ChargeRate - GameTime, false);
 			}
 			else
 			{
@@ -145,27 +150,15 @@ void AShooterWeapon_Charge::OnBurstStarted()
 	{
 		// start firing, can be delayed to satisfy TimeBetweenShots
 		const float GameTime = GetWorld()->GetTimeSeconds();
-		if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
-			LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
+		if (LastFireTime > 0 && GetWeaponConfig().TimeBetweenShots > 0.0f &&
+			LastFireTime + GetWeaponConfig().TimeBetweenShots > GameTime)
 		{
-			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleFiring, LastFireTime + GetWeaponConfig().TimeBetweenShots - GameTime, false);
 		}
 		else
 		{
 			HandleFiring();
 		}
-
-		if (CurrentHeat == 90 && Role < ROLE_Authority)
-		{
-			CurrentHeat = 100;
-		}
-
-		if (CurrentHeat >= 100)
-		{
-			// overheated from that last shot so we cant fire for some time
-			//GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, TEXT("CurrentHeat >= 100"));
-			Overheat();
-		}
 	}
 	else
 	{
@@ -222,10 +215,10 @@ void AShooterWeapon_Charge::HandleCharging()
 			ServerHandleCharging();
 		}
 
-		bRefiring = (CurrentState == EWeaponState::Firing && ChargeConfig.ChargeRate > 0.0f);
+		bRefiring = (CurrentState == EWeaponState::Firing && GetChargeConfig().ChargeRate > 0.0f);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleCharging, ChargeConfig.ChargeRate, false);
+			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::HandleCharging, GetChargeConfig().ChargeRate, false);
 		}
 		else
 		{
@@ -251,16 +244,8 @@ bool AShooterWeapon_Charge::ServerHandleCharging_Validate()
 
 void AShooterWeapon_Charge::OnBurstFinished()
 {
-	if (bIsOverheat)
-	{
-		if (CurrentHeat >= 100)
-		{
-			Overheat();
-		}
-	}
-
 	//GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("ONBURSTFINISHED!"));
-	if (ChargeConfig.bIsCharge)
+	if (GetChargeConfig().bIsCharge)
 	{
 		if (bShouldFire == false)
 		{
@@ -306,15 +291,22 @@ bool AShooterWeapon_Charge::ServerChargeWeapon_Validate()
 void AShooterWeapon_Charge::ServerChargeWeapon_Implementation()
 {
 	//GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("ServerChargeWeapon"));
-	CurrentChargeAmount = CurrentChargeAmount + ChargeConfig.ChargeIncrease;
+	CurrentChargeAmount = CurrentChargeAmount + GetChargeConfig().ChargeIncrease;
 }
 
 void AShooterWeapon_Charge::FireWeapon()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterChargeFire);
+
 	//GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("FireWeapon!"));
 	if (bIsOverheat)
 	{
-		IncreaseHeat();
+		AddShotHeat(HeatIncrease);
+	}
+	if (Role < ROLE_Authority && CurrentChargeAmount >= 100)
+	{
+		// predict the charge shot heat, the server adds it in ServerFireProjectile
+		AddShotHeat(GetChargeConfig().ChargeShotHeatIncrease);
 	}
 	FVector ShootDir = GetAdjustedAim();
 	FVector Origin = GetMuzzleLocation();
@@ -386,88 +378,54 @@ void AShooterWeapon_Charge::ServerFireProjectile_Implementation(FVector Origin,
 	if (CurrentChargeAmount < 100)
 	{
 		// normal shot
-		if (ChargeConfig.bIsShotgun)
+		if (GetChargeConfig().bIsShotgun)
 		{
 
 			FTransform SpawnTM(ShootDir.Rotation(), Origin);
 
+			// one seed for the whole blast
+			const int32 RandomSeed = FMath::Rand();
+			const float ConeHalfAngle = FMath::DegreesToRadians(GetCurrentSpread() * 0.5f);
+			const FVector AimDir = GetAdjustedAim();
 
-
-			for (int32 i = 0; i < ChargeConfig.Shells; i++)
+			for (int32 i = 0; i < GetChargeConfig().Shells; i++)
 			{
 				if (i == 0)
 				{
 					// first projectile will always fly straight and true!
-					AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, ChargeConfig.ProjectileClassNoCharge, SpawnTM));
-					if (Projectile)
-					{
-						Projectile->Instigator = Instigator;
-						Projectile->SetOwner(this);
-						Projectile->InitVelocity(ShootDir);
-
-						UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
-					}
+					AShooterProjectile::SpawnProjectile(this, GetChargeConfig().ProjectileClassNoCharge, SpawnTM, ShootDir);
 				}
 				else
 				{
-					// we need to do a new trace everytime to do spread
-					const int32 RandomSeed = FMath::Rand();
-					FRandomStream WeaponRandomStream(RandomSeed);
-					const float CurrentSpread = GetCurrentSpread();
-					const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
-
-					FVector AimDir = GetAdjustedAim();
-					const FVector StartTrace = GetCameraDamageStartLocation(AimDir);
-					FVector newShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-					//const FVector EndTrace = StartTrace + ShootDir * 10000.0f;
-
-					AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, ChargeConfig.ProjectileClassNoCharge, SpawnTM));
-					if (Projectile)
-					{
-						Projectile->Instigator = Instigator;
-						Projectile->SetOwner(this);
-						Projectile->InitVelocity(newShootDir);
-
-						UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
-					}
-
+					const FVector PelletDir = FShooterSpreadPattern::GetPelletDir(AimDir, RandomSeed, i, ConeHalfAngle);
+					AShooterProjectile::SpawnProjectile(this, GetChargeConfig().ProjectileClassNoCharge, SpawnTM, PelletDir);
 				}
 			}
 		}
 		else
 		{
 			FTransform SpawnTM(ShootDir.Rotation(), Origin);
-			AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, ChargeConfig.ProjectileClassNoCharge, SpawnTM));
-			if (Projectile)
-			{
-				Projectile->Instigator = Instigator;
-				Projectile->SetOwner(this);
-				Projectile->InitVelocity(ShootDir);
-
-				UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
-			}
+			AShooterProjectile::SpawnProjectile(this, GetChargeConfig().ProjectileClassNoCharge, SpawnTM, ShootDir);
 		}
 	}
 	else
 	{
 		// charge shot
 		FTransform SpawnTM(ShootDir.Rotation(), Origin);
-		AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, ChargeConfig.ProjectileClassCharge, SpawnTM));
-		if (Projectile)
-		{
-			Projectile->Instigator = Instigator;
-			Projectile->SetOwner(this);
-			Projectile->InitVelocity(ShootDir);
+		AShooterProjectile::SpawnProjectile(this, GetChargeConfig().ProjectileClassCharge, SpawnTM, ShootDir);
 
-			UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
-		}
-
-		IncreaseHeatFromChargeShot();
+		AddShotHeat(GetChargeConfig().ChargeShotHeatIncrease);
 	}
 
 	CurrentChargeAmount = 0;
 }
 
+const FChargeWeaponData& AShooterWeapon_Charge::GetChargeConfig() const
+{
+	const FShooterWeaponTuningRow* Tuning = GetTuning();
+	return Tuning ? Tuning->Charge : ChargeConfig;
+}
+
 float AShooterWeapon_Charge::GetCurrentSpread() const
 {
 	float FinalSpread;
@@ -505,13 +463,22 @@ float AShooterWeapon_Charge::GetCurrentSpread() const
 Data = ChargeConfig;
 }*/
 
-void AShooterWeapon_Charge::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
+float AShooterWeapon_Charge::GetReplicatedCharge() const
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	return CurrentChargeAmount;
+}
 
-	DOREPLIFETIME(AShooterWeapon_Charge, CurrentChargeAmount);
-	DOREPLIFETIME(AShooterWeapon_Charge, CurrentHeat);
-	DOREPLIFETIME(AShooterWeapon_Charge, bIsOverheated);
+void AShooterWeapon_Charge::SetReplicatedCharge(float NewCharge)
+{
+	CurrentChargeAmount = NewCharge;
+}
+
+void AShooterWeapon_Charge::ResetPooledState()
+{
+	Super::ResetPooledState();
+
+	CurrentChargeAmount = 0;
+	LastChargeTime = 0.0f;
 }
 
 void AShooterWeapon_Charge::UseAmmo()
@@ -555,100 +522,11 @@ void AShooterWeapon_Charge::UseAmmo()
 	}
 }
 
-void AShooterWeapon_Charge::Cooldown()
-{
-	GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("Cooldown"));
-	ServerCooldown();
-
-	if (CurrentHeat == 0)
-	{
-		bIsOverheated = false;
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Charge::Cooldown);
-	}
-}
-
-bool AShooterWeapon_Charge::ServerCooldown_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Charge::ServerCooldown_Implementation()
-{
-	//GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("ServerCooldown"));
-	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("heat amount, server: %f"), CurrentHeat));
-
-	if (CurrentHeat <= 0)
-	{
-		CurrentHeat = 0;
-		bIsOverheated = false;
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Charge::Cooldown);
-	}
-	else
-	{
-		CurrentHeat -= 10;
-	}
-}
-
-bool AShooterWeapon_Charge::IncreaseHeat_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Charge::IncreaseHeat_Implementation()
-{
-	//GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("Heat ++++++"));
-	if (GetWorldTimerManager().IsTimerActive(this, &AShooterWeapon_Charge::Cooldown))
-	{
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Charge::Cooldown);
-	}
-	CurrentHeat += HeatIncrease;
-	GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::Cooldown, CooldownRate, true);
-
-}
-
-bool AShooterWeapon_Charge::IncreaseHeatFromChargeShot_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Charge::IncreaseHeatFromChargeShot_Implementation()
-{
-	GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("HeatFromChargeShot ++++++"));
-	if (GetWorldTimerManager().IsTimerActive(this, &AShooterWeapon_Charge::Cooldown))
-	{
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Charge::Cooldown);
-	}
-	CurrentHeat += ChargeConfig.ChargeShotHeatIncrease;
-	GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Charge::Cooldown, CooldownRate, true);
-}
-
-void AShooterWeapon_Charge::Overheat()
-{
-	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Blue, TEXT("OVERHEATED!!"));
-	if (Role < ROLE_Authority)
-	{
-		ServerOverheat();
-	}
-
-	bIsOverheated = true;
-	// possibly: play overheat animations here
-}
-
-bool AShooterWeapon_Charge::ServerOverheat_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Charge::ServerOverheat_Implementation()
-{
-	Overheat();
-}
-
 bool AShooterWeapon_Charge::CanFire() const
 {
 	bool bCanFire = MyPawn && MyPawn->CanFire();
 	bool bStateOKToFire = ((CurrentState == EWeaponState::Idle) || (CurrentState == EWeaponState::Firing));
-	return ((bCanFire == true) && (bStateOKToFire == true) && (bPendingReload == false) && (bIsOverheated == false));
+	return ((bCanFire == true) && (bStateOKToFire == true) && (bPendingReload == false) && (IsOverheated() == false));
 }
 
 void AShooterWeapon_Charge::StopReload()
@@ -3,6 +3,12 @@
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Instant FireWeapon"), STAT_ShooterInstantFire, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Instant HandleFiring"), STAT_ShooterInstantHandleFiring, STATGROUP_ShooterGame);
+DECLARE_CYCLE_STAT(TEXT("Hit verification"), STAT_ShooterVerifyClientHit, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client hits verified"), STAT_ShooterClientHitsVerified, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client hits rejected"), STAT_ShooterClientHitsRejected, STATGROUP_ShooterGame);
+
 AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	CurrentFiringSpread = 0.0f;
@@ -15,31 +21,36 @@ AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectI
 
 void AShooterWeapon_Instant::FireWeapon()
 {
-	if (bIsOverheat)
-	{
-		//IncreaseHeat();
-	}
+	SCOPE_CYCLE_COUNTER(STAT_ShooterInstantFire);
 
 	if (bIsShotgun)
 	{
 		const FVector AimDir = GetAdjustedAim();
 		const FVector StartTrace = GetCameraDamageStartLocation(AimDir);
 
+		// the whole pattern comes from one seed, so the server and remote clients can regenerate it
+		const int32 RandomSeed = FMath::Rand();
+		const float CurrentSpread = GetCurrentSpread();
+		const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
+
+		TArray<FInstantPelletHit> PelletHits;
+		PelletHits.Reserve(Shells);
+
 		for (int32 i = 0; i < Shells; i++)
 		{
-			const int32 RandomSeed = FMath::Rand();
-			FRandomStream WeaponRandomStream(RandomSeed);
-			const float CurrentSpread = GetCurrentSpread();
-			const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
-
-			const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-			const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+			const FVector ShootDir = FShooterSpreadPattern::GetPelletDir(AimDir, RandomSeed, i, ConeHalfAngle);
+			const FVector EndTrace = StartTrace + ShootDir * GetInstantConfig().WeaponRange;
 
 			const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 
-			ProcessInstantHit(Impact, StartTrace, ShootDir, RandomSeed, CurrentSpread);
+			ProcessPelletHit(Impact, StartTrace, ShootDir, RandomSeed, i, CurrentSpread, PelletHits);
+		}
+
+		CurrentFiringSpread = FMath::Min(GetInstantConfig().FiringSpreadMax, CurrentFiringSpread + GetInstantConfig().FiringSpreadIncrement * Shells);
 
-			CurrentFiringSpread = FMath::Min(InstantConfig.FiringSpreadMax, CurrentFiringSpread + InstantConfig.FiringSpreadIncrement);
+		if (MyPawn && MyPawn->IsLocallyControlled() && GetNetMode() == NM_Client)
+		{
+			ServerNotifyBlast(AimDir, RandomSeed, CurrentSpread, PelletHits);
 		}
 	}
 	else
@@ -54,7 +65,7 @@ void AShooterWeapon_Instant::FireWeapon()
 		const FVector AimDir = GetAdjustedAim();
 		const FVector StartTrace = GetCameraDamageStartLocation(AimDir);
 		const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-		const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = StartTrace + ShootDir * GetInstantConfig().WeaponRange;
 
 		const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 
@@ -63,13 +74,8 @@ void AShooterWeapon_Instant::FireWeapon()
 
 
 
-		CurrentFiringSpread = FMath::Min(InstantConfig.FiringSpreadMax, CurrentFiringSpread + InstantConfig.FiringSpreadIncrement);
+		CurrentFiringSpread = FMath::Min(GetInstantConfig().FiringSpreadMax, CurrentFiringSpread + GetInstantConfig().FiringSpreadIncrement);
 	}
-	/*if (bIsOverheat && CurrentHeat >= 100)
-	{
-		bIsOverheated = true;
-		OnBurstFinished();
-	}*/
 }
 
 bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
@@ -80,6 +86,102 @@ bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult Impact, F
 // CHANGED STUFF IN THIS
 void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
+	const FVector Origin = GetMuzzleLocation();
+
+	if (VerifyClientHit(Impact, Origin, ReticleSpread))
+	{
+		INC_DWORD_STAT(STAT_ShooterClientHitsVerified);
+		ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ShooterClientHitsRejected);
+	}
+}
+
+bool AShooterWeapon_Instant::ServerNotifyBlast_Validate(FVector_NetQuantizeNormal AimDir, int32 RandomSeed, float ReticleSpread, const TArray<FInstantPelletHit>& Pellets)
+{
+	// a blast can never report more pellets than the weapon fires
+	return Pellets.Num() <= FMath::Max(Shells, 1);
+}
+
+void AShooterWeapon_Instant::ServerNotifyBlast_Implementation(FVector_NetQuantizeNormal AimDir, int32 RandomSeed, float ReticleSpread, const TArray<FInstantPelletHit>& Pellets)
+{
+	const FVector Origin = GetMuzzleLocation();
+	const float ConeHalfAngle = FMath::DegreesToRadians(ReticleSpread * 0.5f);
+
+	// the blast has to come from where the shooter is looking
+	if (Instigator && FVector::DotProduct(Instigator->GetViewRotation().Vector(), AimDir) < GetInstantConfig().AllowedViewDotHitDir)
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side blast (facing too far from the aim direction)"), *GetNameSafe(this));
+		INC_DWORD_STAT_BY(STAT_ShooterClientHitsRejected, Pellets.Num());
+		return;
+	}
+
+	// a tight reported spread would put every pellet on the aim ray. Only the zoom state may lag behind the client
+	const FInstantWeaponData& Config = GetInstantConfig();
+	const float UnzoomedSpread = Config.WeaponSpread + CurrentFiringSpread;
+	const float MinSpread = FMath::Min(GetCurrentSpread(), UnzoomedSpread * Config.TargetingSpreadMod) - Config.SpreadTolerance;
+	const float MaxSpread = Config.WeaponSpread + Config.FiringSpreadMax + Config.SpreadTolerance;
+	if (ReticleSpread < MinSpread || ReticleSpread > MaxSpread)
+	{
+		UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side blast (spread %.2f outside %.2f - %.2f)"), *GetNameSafe(this), ReticleSpread, MinSpread, MaxSpread);
+		INC_DWORD_STAT_BY(STAT_ShooterClientHitsRejected, Pellets.Num());
+		return;
+	}
+
+	// follow the client's spread growth, so the next blast is checked against it
+	CurrentFiringSpread = FMath::Min(Config.FiringSpreadMax, CurrentFiringSpread + Config.FiringSpreadIncrement * Shells);
+
+	// every pellet counts once, a repeated index would multiply one pellet's damage
+	TBitArray<> SeenPellets(false, FMath::Max(Shells, 1));
+
+	for (int32 i = 0; i < Pellets.Num(); i++)
+	{
+		const FInstantPelletHit& Pellet = Pellets[i];
+		if (Pellet.PelletIndex >= Shells || SeenPellets[Pellet.PelletIndex])
+		{
+			INC_DWORD_STAT(STAT_ShooterClientHitsRejected);
+			continue;
+		}
+		SeenPellets[Pellet.PelletIndex] = true;
+
+		// regenerate the pellet instead of trusting its direction, the impact has to be on its ray
+		const FVector ShootDir = FShooterSpreadPattern::GetPelletDir(AimDir, RandomSeed, Pellet.PelletIndex, ConeHalfAngle);
+		const FVector ToImpact = Pellet.ImpactPoint - Origin;
+		const float RayDistSq = (ToImpact - ShootDir * FVector::DotProduct(ToImpact, ShootDir)).SizeSquared();
+
+		const FHitResult Impact = Pellet.ToHitResult();
+		if (RayDistSq <= FMath::Square(Config.PelletRayTolerance) && VerifyClientHit(Impact, Origin, ReticleSpread))
+		{
+			INC_DWORD_STAT(STAT_ShooterClientHitsVerified);
+			if (ShouldDealDamage(Impact.GetActor()))
+			{
+				DealDamage(Impact, ShootDir);
+			}
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_ShooterClientHitsRejected);
+		}
+	}
+
+	// play FX on remote clients, they regenerate every pellet from the seed
+	HitNotify.Origin = Origin;
+	HitNotify.RandomSeed = RandomSeed;
+	HitNotify.ReticleSpread = ReticleSpread;
+
+	// play FX locally
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		SimulateInstantHit(Origin, RandomSeed, ReticleSpread);
+	}
+}
+
+bool AShooterWeapon_Instant::VerifyClientHit(const FHitResult& Impact, const FVector& Origin, float ReticleSpread) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterVerifyClientHit);
+
 	const float WeaponAngleDot = FMath::Abs(FMath::Sin(ReticleSpread * PI / 180.f));
 
 	bool IgnoreDotCheck = false;
@@ -99,45 +201,36 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Imp
 		}
 	}
 
-	/*if ((MyX - TarX) < 5 || (TarX - MyX) < 5 || (MyY - TarY) < 5 || (TarY - MyY) < 5)
-	{
-	GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("less than 5 units away from eachother, assume the client is correct about the dot product"));
-	IgnoreDotCheck = true;
-	}*/
-
 	// if we have an instigator, calculate dot between the view and the shot
 	if (Instigator && (Impact.GetActor() || Impact.bBlockingHit))
 	{
-		const FVector Origin = GetMuzzleLocation();
 		const FVector ViewDir = (Impact.Location - Origin).SafeNormal();
 
 		// is the angle between the hit and the view within allowed limits (limit + weapon max angle)
 		const float ViewDotHitDir = FVector::DotProduct(Instigator->GetViewRotation().Vector(), ViewDir);
-		if ((ViewDotHitDir > InstantConfig.AllowedViewDotHitDir - WeaponAngleDot) || IgnoreDotCheck == true)
+		if ((ViewDotHitDir > GetInstantConfig().AllowedViewDotHitDir - WeaponAngleDot) || IgnoreDotCheck == true)
 		{
 			if (CurrentState != EWeaponState::Idle)
 			{
 				if (Impact.GetActor() == NULL)
 				{
-					if (Impact.bBlockingHit)
-					{
-						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
-					}
+					return Impact.bBlockingHit;
 				}
 				// assume it told the truth about static things because the don't move and the hit 
 				// usually doesn't have significant gameplay implications
 				else if (Impact.GetActor()->IsRootComponentStatic() || Impact.GetActor()->IsRootComponentStationary())
 				{
-					ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+					return true;
 				}
 				else
 				{
-					// Get the component bounding box
-					const FBox HitBox = Impact.GetActor()->GetComponentsBoundingBox();
+					// Get the component bounding box, rewound to when the shooter saw the target
+					AShooterCharacter* HitPawn = Cast<AShooterCharacter>(Impact.GetActor());
+					const FBox HitBox = HitPawn ? HitPawn->GetHitBoxAtTime(GetClientFireTime()) : Impact.GetActor()->GetComponentsBoundingBox();
 
 					// calculate the box extent, and increase by a leeway
 					FVector BoxExtent = 0.5 * (HitBox.Max - HitBox.Min);
-					BoxExtent *= InstantConfig.ClientSideHitLeeway;
+					BoxExtent *= GetInstantConfig().ClientSideHitLeeway;
 
 					// avoid precision errors with really thin objects
 					BoxExtent.X = FMath::Max(20.0f, BoxExtent.X);
@@ -147,35 +240,35 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Imp
 					// Get the box center
 					const FVector BoxCenter = (HitBox.Min + HitBox.Max) * 0.5;
 
+					SHOOTER_DEBUG_VALUE(Damage, Verbose, FColor::Red, TEXT("ViewDotHitDir registered:"), ViewDotHitDir);
+
 					// if we are within client tolerance
 					if (FMath::Abs(Impact.Location.Z - BoxCenter.Z) < BoxExtent.Z &&
 						FMath::Abs(Impact.Location.X - BoxCenter.X) < BoxExtent.X &&
 						FMath::Abs(Impact.Location.Y - BoxCenter.Y) < BoxExtent.Y)
 					{
-						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
-					}
-					else
-					{
-						UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside bounding box tolerance)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
-						GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Green, TEXT("Rejected client side hit, outside bounding box tolerance"));
+						return true;
 					}
-					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("Charge amount, server: %f"), CurrentChargeAmount));
-					GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("ViewDotHitDir registered: %f"), ViewDotHitDir));
+
+					UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside bounding box tolerance)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
+					SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("Rejected client side hit, outside bounding box tolerance"));
 				}
 			}
 		}
-		else if (ViewDotHitDir <= InstantConfig.AllowedViewDotHitDir)
+		else if (ViewDotHitDir <= GetInstantConfig().AllowedViewDotHitDir)
 		{
 			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (facing too far from the hit direction)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
-			GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Green, TEXT("Rejected client side hit, facing too far from the hit direction"));
-			GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, FString::Printf(TEXT("ViewDotHitDir not registered: %f"), ViewDotHitDir));
+			SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("Rejected client side hit, facing too far from the hit direction"));
+			SHOOTER_DEBUG_VALUE(Damage, Verbose, FColor::Red, TEXT("ViewDotHitDir not registered:"), ViewDotHitDir);
 		}
 		else
 		{
 			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
-			GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Green, TEXT("Rejected client side hit, whatever this is"));
+			SHOOTER_DEBUG(Damage, Log, FColor::Green, TEXT("Rejected client side hit, whatever this is"));
 		}
 	}
+
+	return false;
 }
 
 bool AShooterWeapon_Instant::ServerNotifyMiss_Validate(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
@@ -195,11 +288,25 @@ void AShooterWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuantize
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
-		const FVector EndTrace = Origin + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = Origin + ShootDir * GetInstantConfig().WeaponRange;
 		SpawnTrailEffect(EndTrace);
 	}
 }
 
+float AShooterWeapon_Instant::GetClientFireTime() const
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// the client saw the world a full round trip ago by the time its hit reaches us
+	const APlayerState* ShooterPlayerState = MyPawn ? MyPawn->PlayerState : NULL;
+	if (ShooterPlayerState && !MyPawn->IsLocallyControlled())
+	{
+		return Now - ShooterPlayerState->ExactPing * 0.001f;
+	}
+
+	return Now;
+}
+
 void AShooterWeapon_Instant::ProcessInstantHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
 {
 	if (MyPawn && MyPawn->IsLocallyControlled() && GetNetMode() == NM_Client)
@@ -229,6 +336,22 @@ void AShooterWeapon_Instant::ProcessInstantHit(const FHitResult& Impact, const F
 	ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 }
 
+void AShooterWeapon_Instant::ProcessPelletHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, int32 PelletIndex, float ReticleSpread, TArray<FInstantPelletHit>& Pellets)
+{
+	if (MyPawn && MyPawn->IsLocallyControlled() && GetNetMode() == NM_Client)
+	{
+		// misses and world hits are regenerated from the seed, only actors controlled by the server need verifying
+		if (Impact.GetActor() && Impact.GetActor()->GetRemoteRole() == ROLE_Authority)
+		{
+			const FVector EndTrace = Origin + ShootDir * GetInstantConfig().WeaponRange;
+			Pellets.Add(FInstantPelletHit(Impact, EndTrace, PelletIndex));
+		}
+	}
+
+	// process a confirmed hit
+	ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+}
+
 void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
 {
 	// handle damage
@@ -248,7 +371,7 @@ void AShooterWeapon_Instant::ProcessInstantHit_Confirmed(const FHitResult& Impac
 	// play FX locally
 	if (GetNetMode() != NM_DedicatedServer)
 	{
-		const FVector EndTrace = Origin + ShootDir * InstantConfig.WeaponRange;
+		const FVector EndTrace = Origin + ShootDir * GetInstantConfig().WeaponRange;
 		const FVector EndPoint = Impact.GetActor() ? Impact.ImpactPoint : EndTrace;
 
 		SpawnTrailEffect(EndPoint);
@@ -276,14 +399,14 @@ bool AShooterWeapon_Instant::ShouldDealDamage(AActor* TestActor) const
 void AShooterWeapon_Instant::DealDamage(const FHitResult& Impact, const FVector& ShootDir)
 {
 	FPointDamageEvent PointDmg;
-	PointDmg.DamageTypeClass = InstantConfig.DamageType;
+	PointDmg.DamageTypeClass = GetInstantConfig().DamageType;
 	PointDmg.HitInfo = Impact;
 	PointDmg.ShotDirection = ShootDir;
-	PointDmg.Damage = InstantConfig.HitDamage;
+	PointDmg.Damage = GetInstantConfig().HitDamage;
 
 	if (PointDmg.HitInfo.BoneName == "b_head" || Impact.BoneName == "Head")
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("HEADSHOT"));
+		SHOOTER_DEBUG(Damage, Log, FColor::Red, TEXT("HEADSHOT"));
 		Cast<AShooterCharacter>(Impact.GetActor())->EndZoom();
 		PointDmg.Damage = Cast<AShooterCharacter>(Impact.GetActor())->CalculateDamageToUse(PointDmg.Damage, PointDmg, MyPawn->Controller, this, HeadshotDamage, ShieldDamage);
 	}
@@ -314,13 +437,12 @@ void AShooterWeapon_Instant::OnBurstFinished()
 {
 	Super::OnBurstFinished();
 
-	if (bIsOverheat)
-	{
-		if (CurrentHeat >= 100)
-		{
-			Overheat();
-		}
-	}
+	CurrentFiringSpread = 0.0f;
+}
+
+void AShooterWeapon_Instant::ResetPooledState()
+{
+	Super::ResetPooledState();
 
 	CurrentFiringSpread = 0.0f;
 }
@@ -329,12 +451,18 @@ void AShooterWeapon_Instant::OnBurstFinished()
 //////////////////////////////////////////////////////////////////////////
 // Weapon usage helpers
 
+const FInstantWeaponData& AShooterWeapon_Instant::GetInstantConfig() const
+{
+	const FShooterWeaponTuningRow* Tuning = GetTuning();
+	return Tuning ? Tuning->Instant : InstantConfig;
+}
+
 float AShooterWeapon_Instant::GetCurrentSpread() const
 {
-	float FinalSpread = InstantConfig.WeaponSpread + CurrentFiringSpread;
+	float FinalSpread = GetInstantConfig().WeaponSpread + CurrentFiringSpread;
 	if (MyPawn && MyPawn->IsTargeting())
 	{
-		FinalSpread *= InstantConfig.TargetingSpreadMod;
+		FinalSpread *= GetInstantConfig().TargetingSpreadMod;
 	}
 
 	return FinalSpread;
@@ -351,13 +479,26 @@ void AShooterWeapon_Instant::OnRep_HitNotify()
 
 void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32 RandomSeed, float ReticleSpread)
 {
-	FRandomStream WeaponRandomStream(RandomSeed);
 	const float ConeHalfAngle = FMath::DegreesToRadians(ReticleSpread * 0.5f);
-
-	const FVector StartTrace = ShotOrigin;
 	const FVector AimDir = GetAdjustedAim();
-	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
-	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
+
+	if (bIsShotgun)
+	{
+		for (int32 i = 0; i < Shells; i++)
+		{
+			SimulateShot(ShotOrigin, FShooterSpreadPattern::GetPelletDir(AimDir, RandomSeed, i, ConeHalfAngle));
+		}
+	}
+	else
+	{
+		FRandomStream WeaponRandomStream(RandomSeed);
+		SimulateShot(ShotOrigin, WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle));
+	}
+}
+
+void AShooterWeapon_Instant::SimulateShot(const FVector& StartTrace, const FVector& ShootDir)
+{
+	const FVector EndTrace = StartTrace + ShootDir * GetInstantConfig().WeaponRange;
 
 	FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
 	if (Impact.bBlockingHit)
@@ -373,7 +514,8 @@ void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32
 
 void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 {
-	if (ImpactTemplate && Impact.bBlockingHit)
+	AShooterEffectManager* EffectManager = AShooterEffectManager::Get(GetWorld());
+	if (EffectManager && ImpactTemplate && Impact.bBlockingHit && EffectManager->HasBudget())
 	{
 		FHitResult UseImpact = Impact;
 
@@ -386,12 +528,7 @@ void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 			UseImpact = Hit;
 		}
 
-		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplate, Impact.ImpactPoint, Impact.ImpactNormal.Rotation());
-		if (EffectActor)
-		{
-			EffectActor->SurfaceHit = UseImpact;
-			UGameplayStatics::FinishSpawningActor(EffectActor, FTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint));
-		}
+		EffectManager->PlayImpact(ImpactTemplate, Impact.ImpactPoint, Impact.ImpactNormal.Rotation(), UseImpact);
 	}
 }
 
@@ -414,91 +551,10 @@ void AShooterWeapon_Instant::GetLifetimeReplicatedProps( TArray< FLifetimeProper
 	Super::GetLifetimeReplicatedProps( OutLifetimeProps );
 
 	DOREPLIFETIME_CONDITION( AShooterWeapon_Instant, HitNotify, COND_SkipOwner );
-
-	DOREPLIFETIME(AShooterWeapon_Instant, CurrentHeat);
-	//DOREPLIFETIME(AShooterWeapon_Instant, bIsOverheated);
 }
 
 // ADDED ALL THIS
 
-void AShooterWeapon_Instant::Cooldown()
-{
-	//GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("Cooldown"));
-	ServerCooldown();
-
-	if (CurrentHeat == 0)
-	{
-		bIsOverheated = false;
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Instant::Cooldown);
-	}
-}
-
-bool AShooterWeapon_Instant::ServerCooldown_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Instant::ServerCooldown_Implementation()
-{
-	//GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("ServerCooldown"));
-	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("heat amount, server: %f"), CurrentHeat));
-
-	if (CurrentHeat < 1)
-	{
-		CurrentHeat = 0;
-		bIsOverheated = false;
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Instant::Cooldown);
-	}
-	else
-	{
-		CurrentHeat -= 10;
-	}
-}
-
-bool AShooterWeapon_Instant::IncreaseHeat_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Instant::IncreaseHeat_Implementation()
-{
-	//GEngine->AddOnScreenDebugMessage(-1, 1.0, FColor::Black, TEXT("Heat ++++++"));
-	if (GetWorldTimerManager().IsTimerActive(this, &AShooterWeapon_Instant::Cooldown))
-	{
-		GetWorldTimerManager().ClearTimer(this, &AShooterWeapon_Instant::Cooldown);
-	}
-	CurrentHeat += HeatIncrease;
-
-	if (CurrentHeat >= 100)
-	{
-		Overheat();
-	}
-	GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Instant::Cooldown, CooldownRate, true);
-
-}
-
-void AShooterWeapon_Instant::Overheat()
-{
-	//GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Blue, TEXT("OVERHEATED!!"));
-	if (Role < ROLE_Authority)
-	{
-		ServerOverheat();
-	}
-
-	bIsOverheated = true;
-	// possibly: play overheat animations here
-}
-
-bool AShooterWeapon_Instant::ServerOverheat_Validate()
-{
-	return true;
-}
-
-void AShooterWeapon_Instant::ServerOverheat_Implementation()
-{
-	Overheat();
-}
-
 void AShooterWeapon_Instant::OnBurstStarted()
 {
 	if (CanFire())
@@ -507,27 +563,15 @@ void AShooterWeapon_Instant::OnBurstStarted()
 		{
 			// start firing, can be delayed to satisfy TimeBetweenShots
 			const float GameTime = GetWorld()->GetTimeSeconds();
-			if (LastFireTime > 0 && WeaponConfig.TimeBetweenShots > 0.0f &&
-				LastFireTime + WeaponConfig.TimeBetweenShots > GameTime)
+			if (LastFireTime > 0 && GetWeaponConfig().TimeBetweenShots > 0.0f &&
+				LastFireTime + GetWeaponConfig().TimeBetweenShots > GameTime)
 			{
-				GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Instant::HandleFiring, LastFireTime + WeaponConfig.TimeBetweenShots - GameTime, false);
+				GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Instant::HandleFiring, LastFireTime + GetWeaponConfig().TimeBetweenShots - GameTime, false);
 			}
 			else
 			{
 				HandleFiring();
 			}
-
-			if (CurrentHeat == 90 && Role < ROLE_Authority)
-			{
-				CurrentHeat = 100;
-			}
-
-			if (CurrentHeat >= 100)
-			{
-				// overheated from that last shot so we cant fire for some time
-				//GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, TEXT("CurrentHeat >= 100"));
-				Overheat();
-			}
 		}
 		else
 		{
@@ -542,26 +586,15 @@ bool AShooterWeapon_Instant::CanFire() const
 	bool bCanFire = MyPawn && MyPawn->CanFire();
 	bool bStateOKToFire = ((CurrentState == EWeaponState::Idle) || (CurrentState == EWeaponState::Firing));
 
-	if (bIsOverheated)
-	{
-		//GEngine->AddOnScreenDebugMessage(-1, 50.0f, FColor::Yellow, TEXT("I AM OVERHEATED SO WHY CAN I FIRE"));
-	}
-	else
-	{
-		//GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("NOT OVERHEATED?"));
-	}
-
-	return ((bCanFire == true) && (bStateOKToFire == true) && (bPendingReload == false) && (bIsOverheated == false));
+	return ((bCanFire == true) && (bStateOKToFire == true) && (bPendingReload == false) && (IsOverheated() == false));
 }
 
 void AShooterWeapon_Instant::HandleFiring()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterInstantHandleFiring);
+
 	if((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
-		if (bIsOverheat)
-		{
-			IncreaseHeat();
-		}
 		if (GetNetMode() != NM_DedicatedServer)
 		{
 			SimulateWeaponFire();
@@ -569,6 +602,13 @@ void AShooterWeapon_Instant::HandleFiring()
 
 		if (MyPawn && MyPawn->IsLocallyControlled())
 		{
+			// remote shots are heated up in ServerHandleFiring
+			if (bIsOverheat)
+			{
+				AddShotHeat(HeatIncrease);
+			}
+
+			INC_DWORD_STAT(STAT_ShooterShotsFired);
 			FireWeapon();
 
 			UseAmmo();
@@ -647,10 +687,10 @@ void AShooterWeapon_Instant::HandleFiring()
 		}
 
 		// setup refire timer
-		bRefiring = (CurrentState == EWeaponState::Firing && WeaponConfig.TimeBetweenShots > 0.0f && bIsAutomatic);
+		bRefiring = (CurrentState == EWeaponState::Firing && GetWeaponConfig().TimeBetweenShots > 0.0f && bIsAutomatic);
 		if (bRefiring)
 		{
-			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Instant::HandleFiring, WeaponConfig.TimeBetweenShots, false);
+			GetWorldTimerManager().SetTimer(this, &AShooterWeapon_Instant::HandleFiring, GetWeaponConfig().TimeBetweenShots, false);
 		}
 		else
 		{
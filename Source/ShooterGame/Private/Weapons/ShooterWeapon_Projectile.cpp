@@ -2,6 +2,8 @@
 
 #include "ShooterGame.h"
 
+DECLARE_CYCLE_STAT(TEXT("Projectile FireWeapon"), STAT_ShooterProjectileFire, STATGROUP_ShooterGame);
+
 AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 }
@@ -11,6 +13,8 @@ AShooterWeapon_Projectile::AShooterWeapon_Projectile(const FObjectInitializer& O
 
 void AShooterWeapon_Projectile::FireWeapon()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterProjectileFire);
+
 	if (bControlsProjectileExplosion && ActiveProjectile != NULL)
 	{
 		return;
@@ -77,22 +81,22 @@ bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FV
 void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir)
 {
 	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginSpawningActorFromClass(this, ProjectileConfig.ProjectileClass, SpawnTM));
+	AShooterProjectile* Projectile = AShooterProjectile::SpawnProjectile(this, GetProjectileConfig().ProjectileClass, SpawnTM, ShootDir);
 	if (Projectile)
 	{
-		Projectile->Instigator = Instigator;
-		Projectile->SetOwner(this);
-		Projectile->InitVelocity(ShootDir);
-
-		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
-
 		ActiveProjectile = Projectile;
 	}
 }
 
 void AShooterWeapon_Projectile::ApplyWeaponConfig(FProjectileWeaponData& Data)
 {
-	Data = ProjectileConfig;
+	Data = GetProjectileConfig();
+}
+
+const FProjectileWeaponData& AShooterWeapon_Projectile::GetProjectileConfig() const
+{
+	const FShooterWeaponTuningRow* Tuning = GetTuning();
+	return Tuning ? Tuning->Projectile : ProjectileConfig;
 }
 
 void AShooterWeapon_Projectile::OnBurstFinished()
@@ -23,6 +23,24 @@ DECLARE_LOG_CATEGORY_EXTERN(LogShooterWeapon, Log, All);
 
 #define MAX_PLAYER_NAME_LENGTH 16
 
+/** collision queries issued by game code since the soak benchmark last sampled it */
+extern int32 GShooterSceneQueries;
+
+DECLARE_STATS_GROUP(TEXT("ShooterGame"), STATGROUP_ShooterGame, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene queries"), STAT_ShooterSceneQueries, STATGROUP_ShooterGame, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shots fired"), STAT_ShooterShotsFired, STATGROUP_ShooterGame, );
+
+/** count a collision query issued by game code */
+#define SHOOTER_COUNT_SCENE_QUERY() \
+	do \
+	{ \
+		GShooterSceneQueries++; \
+		INC_DWORD_STAT(STAT_ShooterSceneQueries); \
+	} while (0)
+
+#include "ShooterGameDebug.h"
+
 
 /** Set to 1 to pretend we're building for console even on a PC, for testing purposes */
 #define SHOOTER_SIMULATE_CONSOLE_UI	0
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/** debug messages are compiled out of Shipping and Test builds */
+#define SHOOTER_DEBUG_MESSAGES	(!(UE_BUILD_SHIPPING || UE_BUILD_TEST))
+
+namespace EShooterDebug
+{
+	enum Type
+	{
+		Damage,
+		Weapon,
+		Pickup,
+		Movement,
+		MAX,
+	};
+}
+
+namespace EShooterDebugVerbosity
+{
+	enum Type
+	{
+		Log = 1,
+		Verbose = 2,
+	};
+}
+
+#if SHOOTER_DEBUG_MESSAGES
+
+/** message waiting in the ring, text is a literal and is only formatted when the ring is drained */
+struct FShooterDebugMessage
+{
+	const TCHAR* Text;
+	float Value;
+	double Time;
+	FColor Color;
+	uint8 Category;
+	uint8 bHasValue : 1;
+};
+
+/**
+ * Fixed size ring of debug messages.
+ *
+ * Pushing only checks the category's verbosity and copies a few words, no strings are built.
+ * Messages are formatted when drained: by the HUD when Shooter.DebugOnScreen is set, or to the
+ * log with the Shooter.DumpDebugMessages command. The oldest messages are overwritten when full.
+ */
+class FShooterDebugChannel
+{
+public:
+	/** is category enabled at this verbosity? */
+	static bool IsEnabled(EShooterDebug::Type Category, EShooterDebugVerbosity::Type Verbosity);
+
+	/** add message to the ring, Text must be a literal */
+	static void Push(EShooterDebug::Type Category, const FColor& Color, const TCHAR* Text);
+	static void Push(EShooterDebug::Type Category, const FColor& Color, const TCHAR* Text, float Value);
+
+	/** print messages pushed since the last call on screen, if enabled */
+	static void FlushToScreen();
+
+	/** write all messages still in the ring to the log */
+	static void DumpToLog();
+
+private:
+	static void Add(EShooterDebug::Type Category, const FColor& Color, const TCHAR* Text, float Value, bool bHasValue);
+
+	/** format message for output */
+	static FString Format(const FShooterDebugMessage& Message);
+
+	/** must be a power of two, so slots stay in order when WriteCount wraps */
+	enum { RingSize = 256 };
+	static_assert((RingSize & (RingSize - 1)) == 0, "Debug ring size must be a power of two");
+
+	static FShooterDebugMessage Ring[RingSize];
+
+	/** total messages pushed, wrapping. Read as uint32, slot is WriteCount & (RingSize - 1) */
+	static FThreadSafeCounter WriteCount;
+
+	/** WriteCount when messages were last shown on screen */
+	static uint32 ScreenReadCount;
+};
+
+#define SHOOTER_DEBUG(Category, Verbosity, Color, Text) \
+	do \
+	{ \
+		if (FShooterDebugChannel::IsEnabled(EShooterDebug::Category, EShooterDebugVerbosity::Verbosity)) \
+		{ \
+			FShooterDebugChannel::Push(EShooterDebug::Category, Color, Text); \
+		} \
+	} while (0)
+
+#define SHOOTER_DEBUG_VALUE(Category, Verbosity, Color, Text, Value) \
+	do \
+	{ \
+		if (FShooterDebugChannel::IsEnabled(EShooterDebug::Category, EShooterDebugVerbosity::Verbosity)) \
+		{ \
+			FShooterDebugChannel::Push(EShooterDebug::Category, Color, Text, Value); \
+		} \
+	} while (0)
+
+#else
+
+#define SHOOTER_DEBUG(Category, Verbosity, Color, Text)
+#define SHOOTER_DEBUG_VALUE(Category, Verbosity, Color, Text, Value)
+
+#endif